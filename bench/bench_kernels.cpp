@@ -0,0 +1,736 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file bench_kernels.cpp
+//  \brief Micro-benchmarks of the reconstruction, Riemann solver, and cooling kernels.
+//
+//  The kernels are called exactly as in the flux calculation (hierarchical parallelism
+//  over pencils in i-dir with the reconstructed states in scratch memory) but on
+//  synthetic data of a single 2D block so that the results are independent of the mesh,
+//  the boundary communication, and the task overhead.
+//  The cooling kernels look up the temperature and TEF bins of the Townsend integrator
+//  for each of the N^2 cells in tables with 100, 1000, and 10000 entries (reported per
+//  cell in place of per interface).
+//
+//  Usage: athenaPK_bench [--length N] [--nvar V] [--reps R] [--filter STR] [--check]
+//    --length N   number of cells per pencil. The N^2 block contains N pencils. [256]
+//    --nvar V     number of variables to reconstruct (the Riemann solvers always use
+//                 the hydro/MHD variables of the corresponding fluid) [5]
+//    --reps R     number of timed repetitions of each kernel [20]
+//    --filter STR only run kernels (and checks) whose name contains STR
+//    --check      compare the cooling bins with the ones of linear searches and (with
+//                 AthenaPK_ENABLE_SIMD_RIEMANN=ON) the fluxes of the explicitly
+//                 vectorized Riemann solvers with the ones of the scalar versions, and
+//                 exit with an error if the bins differ or the fluxes differ by more
+//                 than round-off.
+//                 All three normal directions of the Riemann solvers are checked, which
+//                 requires an N^3 block for the fluxes, so a small N is recommended. Each
+//                 pencil has N + 1 interfaces, so an odd N also checks both the SIMD and
+//                 the scalar remainder path.
+//  All other arguments are passed on to Kokkos (e.g., --kokkos-num-threads).
+//
+//  In addition to the timings, a checksum (sum of the absolute values of all
+//  reconstructed states or fluxes) is reported for each kernel. The benchmark exits with
+//  an error if any checksum is zero or not finite, e.g., for a miscompiled kernel.
+
+// C++ headers
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Parthenon headers
+#include <globals.hpp>
+#include <parthenon/package.hpp>
+
+using namespace parthenon::package::prelude;
+
+// AthenaPK headers
+#include "eos/adiabatic_glmmhd.hpp"
+#include "eos/adiabatic_hydro.hpp"
+#include "hydro/srcterms/tabular_cooling.hpp"
+#include "hydro/rsolvers/rsolvers.hpp"
+#ifdef ATHENAPK_MIXED_PRECISION
+#include "hydro/mixed_precision.hpp"
+#endif
+#include "main.hpp"
+#include "recon/dc_simple.hpp"
+#include "recon/limo3_simple.hpp"
+#include "recon/plm_simple.hpp"
+#include "recon/ppm_simple.hpp"
+#include "recon/weno3_simple.hpp"
+#include "recon/wenoz_simple.hpp"
+#include "units.hpp"
+
+namespace {
+
+using parthenon::X1DIR;
+using parthenon::X2DIR;
+
+// Number of ghost cells required by the widest stencil (ppm and wenoz)
+constexpr int nghost = 3;
+// Number of primitive variables of the GLM MHD fluid
+constexpr int nhydro_glmmhd = 9;
+
+// Uniform grid spacing in place of the block coordinates (only used by weno3 and limo3)
+struct BenchCoords {
+  Real dx;
+
+  template <int DIR>
+  KOKKOS_FORCEINLINE_FUNCTION Real Dxc(const int k, const int j, const int i) const {
+    return dx;
+  }
+};
+
+// Primitive variables of a single block that can directly be passed to Reconstruct()
+// in place of the block pack.
+struct BenchPack {
+  parthenon::ParArray4D<Real> data;
+  int nvar;
+  BenchCoords coords;
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  Real &operator()(const int n, const int k, const int j, const int i) const {
+    return data(n, k, j, i);
+  }
+  // Following VariablePack convention, i.e., dim 4 is the variable index
+  KOKKOS_FORCEINLINE_FUNCTION
+  int GetDim(const int dim) const { return dim == 4 ? nvar : data.extent_int(4 - dim); }
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  const BenchCoords &GetCoords() const { return coords; }
+};
+
+struct BenchOptions {
+  int length = 256;
+  int nvar = NHYDRO;
+  int reps = 20;
+  std::string filter;
+  bool check = false;
+};
+
+struct Benchmark {
+  std::string name;
+  std::function<void()> kernel;
+  // number of interfaces processed by a single call of the kernel
+  double ninterfaces;
+  // (minimal) memory traffic of a single call of the kernel
+  double bytes;
+  // calls the kernel once and returns the sum of the absolute values of its results,
+  // which has to be finite and positive for the synthetic data
+  std::function<Real()> checksum;
+};
+
+// Smooth but nontrivial (so that all branches of limiters and Riemann solvers are
+// exercised) primitive state. Indices follow the primitive variables of the GLM MHD fluid
+// followed by passive scalars.
+// The pencils cycle through four regimes: smooth subsonic states, supersonic flows (with
+// alternating sign in consecutive supersonic pencils), vanishing normal magnetic field,
+// and pairs of identical cells with a purely normal magnetic field and an Alfven speed
+// above the sound speed (degenerate HLLD intermediate states). The normal direction of
+// the last two regimes also cycles so that they are covered for all three directions.
+void InitPrimitives(const BenchPack &q) {
+  const auto data = q.data;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "bench init", parthenon::DevExecSpace(), 0,
+      data.extent_int(0) - 1, 0, data.extent_int(1) - 1, 0, data.extent_int(2) - 1, 0,
+      data.extent_int(3) - 1,
+      KOKKOS_LAMBDA(const int n, const int k, const int j, const int i) {
+        const int regime = j % 4;
+        const int normal = IB1 + (j / 4) % 3;
+        // identical states on both sides of every other interface
+        const int ii = regime == 3 ? i - i % 2 : i;
+        const Real x = 0.37 * ii + 0.11 * j + 0.7 * n;
+        Real val;
+        if (n == IDN) {
+          val = 1.0 + 0.5 * Kokkos::sin(x) * Kokkos::sin(x);
+        } else if (n == IPR) {
+          val = 1.0 + 0.3 * Kokkos::cos(1.3 * x) * Kokkos::cos(1.3 * x);
+        } else if (n == IPS) {
+          val = regime >= 2 ? 0.0 : 1e-2 * Kokkos::sin(x);
+        } else if (n < IPR) {
+          val = 0.5 * Kokkos::sin(1.7 * x);
+          if (regime == 1) {
+            // well above the fast magnetosonic speed (< 2.1) of all states
+            val = ((j / 4) % 2 == 0 ? 1.0 : -1.0) * (4.0 + val);
+          }
+        } else if (n < IPS) {
+          val = 0.5 + 0.3 * Kokkos::sin(2.1 * x);
+          if (regime == 2 && n == normal) {
+            val = 0.0;
+          } else if (regime == 3) {
+            val = n == normal ? 2.0 : 0.0;
+          }
+        } else {
+          val = 0.5 + 0.5 * Kokkos::sin(x);
+        }
+        // Occasional jumps (every 16th cell) to trigger the limiters
+        const bool jump = (i % 16 == 0) && regime != 3 && (n == IDN || n == IPR);
+        data(n, k, j, i) = jump ? 4.0 * val : val;
+      });
+}
+
+// If `checksum` is set, the sum of the absolute values of the reconstructed states of
+// each pencil j is stored in `sums(j)`.
+template <Reconstruction recon, int XNDIR, typename QPack>
+void BenchReconstruct(const QPack &q, const int n, const bool checksum = false,
+                      const parthenon::ParArray1D<Real> &sums = {}) {
+  const int nx = n + 2 * nghost;
+  const int nvar = q.GetDim(4);
+  const int il = XNDIR == X1DIR ? nghost - 1 : nghost;
+  const int iu = XNDIR == X1DIR ? nghost + n : nghost + n - 1;
+  // X1DIR: all pencils in the interior. X2DIR: all pencils required for the faces of the
+  // interior (as in the streaming transverse flux calculation).
+  const int jl = XNDIR == X1DIR ? nghost : nghost - 1;
+  const int ju = XNDIR == X1DIR ? nghost + n - 1 : nghost + n;
+
+  const size_t scratch_size_in_bytes =
+      parthenon::ScratchPad2D<Real>::shmem_size(nvar, nx) * 2;
+
+  parthenon::par_for_outer(
+      DEFAULT_OUTER_LOOP_PATTERN, "bench reconstruct", parthenon::DevExecSpace(),
+      scratch_size_in_bytes, 0, 0, 0, jl, ju,
+      KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int k, const int j) {
+        parthenon::ScratchPad2D<Real> wl(member.team_scratch(0), nvar, nx);
+        parthenon::ScratchPad2D<Real> wr(member.team_scratch(0), nvar, nx);
+        Reconstruct<recon, XNDIR>(member, k, j, il, iu, q, wl, wr);
+        if (checksum) {
+          member.team_barrier();
+          // only interfaces for which both states are reconstructed
+          const int fs = XNDIR == X1DIR ? il + 1 : il;
+          Real pencil_sum = 0.0;
+          Kokkos::parallel_reduce(
+              Kokkos::TeamThreadRange(member, fs, iu + 1),
+              [&](const int i, Real &lsum) {
+                for (int v = 0; v < nvar; ++v) {
+                  lsum += Kokkos::fabs(wl(v, i)) + Kokkos::fabs(wr(v, i));
+                }
+              },
+              pencil_sum);
+          Kokkos::single(Kokkos::PerTeam(member), [&]() { sums(j) = pencil_sum; });
+        }
+      });
+}
+
+// The left and right states are loaded from the primitive variables of the cells left
+// and right of each interface (i.e., as for DC reconstruction) so that the timings also
+// include loading the states to scratch memory.
+// `ivx` selects the normal velocity (and magnetic field) component. The states are always
+// loaded along the pencils in i-dir but the fluxes are stored in direction `ivx`.
+template <Fluid fluid, typename RiemannT, typename EOS>
+void BenchRiemann(const BenchPack &q, const VariableFluxPack<Real> &cons_pack,
+                  const EOS &eos, const int n, const int ivx = IV1) {
+  const int nx = n + 2 * nghost;
+  const int nhydro = fluid == Fluid::euler ? NHYDRO : nhydro_glmmhd;
+  const int fs = nghost;
+  const int fe = nghost + n;
+  const Real c_h = fluid == Fluid::glmmhd ? 1.0 : 0.0;
+
+  const size_t scratch_size_in_bytes =
+      parthenon::ScratchPad2D<Real>::shmem_size(nhydro, nx) * 2;
+
+  auto riemann = RiemannT();
+
+  parthenon::par_for_outer(
+      DEFAULT_OUTER_LOOP_PATTERN, "bench riemann", parthenon::DevExecSpace(),
+      scratch_size_in_bytes, 0, 0, 0, nghost, nghost + n - 1,
+      KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int k, const int j) {
+        auto cons = cons_pack;
+        parthenon::ScratchPad2D<Real> wl(member.team_scratch(0), nhydro, nx);
+        parthenon::ScratchPad2D<Real> wr(member.team_scratch(0), nhydro, nx);
+        for (int v = 0; v < nhydro; ++v) {
+          parthenon::par_for_inner(member, fs, fe, [&](const int i) {
+            wl(v, i) = q(v, k, j, i - 1);
+            wr(v, i) = q(v, k, j, i);
+          });
+        }
+        member.team_barrier();
+
+        riemann.Solve(member, k, j, fs, fe, ivx, wl, wr, cons, eos, c_h);
+      });
+}
+
+template <Reconstruction recon, int XNDIR, typename QPack>
+Real ReconstructChecksum(const QPack &q, const int n) {
+  parthenon::ParArray1D<Real> sums("bench recon sums", n + 2 * nghost);
+  BenchReconstruct<recon, XNDIR>(q, n, true, sums);
+  Real sum = 0.0;
+  Kokkos::parallel_reduce(
+      "bench recon checksum",
+      Kokkos::RangePolicy<>(parthenon::DevExecSpace(), 0, sums.extent_int(0)),
+      KOKKOS_LAMBDA(const int j, Real &lsum) { lsum += sums(j); }, sum);
+  return sum;
+}
+
+template <Fluid fluid, typename RiemannT, typename EOS>
+Real RiemannChecksum(const BenchPack &q, const VariableFluxPack<Real> &cons_pack,
+                     const EOS &eos, const int n) {
+  const int nhydro = fluid == Fluid::euler ? NHYDRO : nhydro_glmmhd;
+  BenchRiemann<fluid, RiemannT>(q, cons_pack, eos, n);
+  const auto policy = Kokkos::MDRangePolicy<Kokkos::Rank<3>>(
+      parthenon::DevExecSpace(), {0, nghost, nghost},
+      {nhydro, nghost + n, nghost + n + 1});
+  Real sum = 0.0;
+  Kokkos::parallel_reduce(
+      "bench riemann checksum", policy,
+      KOKKOS_LAMBDA(const int v, const int j, const int i, Real &lsum) {
+        lsum += Kokkos::fabs(cons_pack.flux(X1DIR, v, 0, j, i));
+      },
+      sum);
+  return sum;
+}
+
+// `value_size` is the size of a single stored primitive variable
+template <Reconstruction recon, typename QPack>
+void AddReconstruct(std::vector<Benchmark> &benchmarks, const std::string &name,
+                    const QPack &q, const int n, const double value_size = sizeof(Real)) {
+  // all primitive variables of the interior are read at least once
+  const double bytes = static_cast<double>(q.GetDim(4)) * n * n * value_size;
+  benchmarks.push_back({"recon " + name + " x1",
+                        [=]() { BenchReconstruct<recon, X1DIR>(q, n); },
+                        static_cast<double>(n + 1) * n, bytes,
+                        [=]() { return ReconstructChecksum<recon, X1DIR>(q, n); }});
+  benchmarks.push_back({"recon " + name + " x2",
+                        [=]() { BenchReconstruct<recon, X2DIR>(q, n); },
+                        static_cast<double>(n + 1) * n, bytes,
+                        [=]() { return ReconstructChecksum<recon, X2DIR>(q, n); }});
+}
+
+template <Fluid fluid, RiemannSolver rsolver, typename EOS>
+void AddRiemann(std::vector<Benchmark> &benchmarks, const std::string &name,
+                const BenchPack &q, const VariableFluxPack<Real> &cons, const EOS &eos,
+                const int n) {
+  const int nhydro = fluid == Fluid::euler ? NHYDRO : nhydro_glmmhd;
+  const double ninterfaces = static_cast<double>(n + 1) * n;
+  // all primitive variables of the interior are read and all fluxes are written once
+  const double bytes =
+      static_cast<double>(nhydro) * (n * n + ninterfaces) * sizeof(Real);
+  using RiemannT = FluxRiemann<fluid, rsolver>;
+  benchmarks.push_back({"riemann " + name,
+                        [=]() { BenchRiemann<fluid, RiemannT>(q, cons, eos, n); },
+                        ninterfaces, bytes, [=]() {
+                          return RiemannChecksum<fluid, RiemannT>(q, cons, eos, n);
+                        }});
+}
+
+// Temperature only cooling table and strictly decreasing temporal evolution functions
+// (TEFs) of its bins for the bin lookups of the Townsend cooling integrator
+struct CoolingBinsData {
+  cooling::CoolingTableObj table;
+  parthenon::ParArray1D<Real> log_temps;
+  parthenon::ParArray1D<Real> Y_k;
+  int n_temp;
+};
+
+// Table with n_temp log temperatures in [4, 9] that are either evenly or (for
+// `uniform = false`) quadratically spaced
+CoolingBinsData MakeCoolingBinsData(const int n_temp, const bool uniform) {
+  std::vector<Real> log_temps(n_temp);
+  for (int i = 0; i < n_temp; i++) {
+    const Real x = static_cast<Real>(i) / (n_temp - 1);
+    log_temps[i] = 4.0 + 5.0 * (uniform ? x : x * x);
+  }
+  Real d_log_temp_index;
+  const auto temp_bin_index =
+      cooling::CoolingTableObj::MakeTempBinIndex(log_temps, d_log_temp_index);
+
+  parthenon::ParArray1D<Real> log_temps_d("log_temps", n_temp);
+  auto log_temps_h = Kokkos::create_mirror_view(log_temps_d);
+  for (int i = 0; i < n_temp; i++) {
+    log_temps_h(i) = log_temps[i];
+  }
+  Kokkos::deep_copy(log_temps_d, log_temps_h);
+
+  parthenon::ParArray1D<Real> Y_k("Y_k", n_temp - 1);
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "bench init Y_k", parthenon::DevExecSpace(), 0, n_temp - 2,
+      KOKKOS_LAMBDA(const int c) { Y_k(c) = n_temp - 2 - c; });
+
+  // The cooling rates, the density and metallicity axes, and the units are not used by
+  // the bin lookups
+  const parthenon::ParArray1D<Real> log_lambdas("log_lambdas", n_temp);
+  const parthenon::ParArray1D<Real> axis("axis", 1);
+  parthenon::ParameterInput pin;
+  const Units units(&pin);
+  const cooling::CoolingTableObj table(
+      log_lambdas, log_temps_d, axis, axis, temp_bin_index, log_temps.front(),
+      log_temps.back(), d_log_temp_index, 0.0, 1.0, 5.0 / 3.0, 0.75, units);
+  return {table, log_temps_d, Y_k, n_temp};
+}
+
+// Bins of the temperature and of the (adjusted) TEF of each of the n^2 cells as in the
+// Townsend integrator, either using the lookups of the cooling or linear searches (the
+// reference). The temperatures and TEFs are (quasi-random) uniformly distributed over the
+// whole table.
+template <bool linear>
+void BenchCoolingBins(const CoolingBinsData &c, const parthenon::ParArray2D<int> &bins,
+                      const int n) {
+  const auto table = c.table;
+  const auto log_temps = c.log_temps;
+  const auto Y_k = c.Y_k;
+  const int n_temp = c.n_temp;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "bench cooling bins", parthenon::DevExecSpace(), 0, n - 1, 0,
+      n - 1, KOKKOS_LAMBDA(const int j, const int i) {
+        const Real r = static_cast<Real>(j * n + i);
+        const Real x = r * 0.6180339887498949 - Kokkos::floor(r * 0.6180339887498949);
+        const Real y = r * 0.7548776662466927 - Kokkos::floor(r * 0.7548776662466927);
+
+        const Real log_temp = log_temps(0) + x * (log_temps(n_temp - 1) - log_temps(0));
+        int idx = 0;
+        if constexpr (linear) {
+          while ((idx < n_temp - 2) && (log_temps(idx + 1) <= log_temp)) {
+            idx += 1;
+          }
+        } else {
+          idx = table.FindTempBin(log_temp);
+        }
+
+        const Real tef_adj = Y_k(idx) + y * (Y_k(0) - Y_k(idx));
+        int tef_idx = idx;
+        if constexpr (linear) {
+          while ((tef_idx > 0) && (tef_adj > Y_k(tef_idx))) {
+            tef_idx -= 1;
+          }
+        } else {
+          tef_idx = cooling::FindTownsendTEFBin(Y_k, idx, tef_adj);
+        }
+        bins(j, i) = idx * n_temp + tef_idx;
+      });
+}
+
+template <bool linear>
+Real CoolingBinsChecksum(const CoolingBinsData &c, const parthenon::ParArray2D<int> &bins,
+                         const int n) {
+  BenchCoolingBins<linear>(c, bins, n);
+  Real sum = 0.0;
+  Kokkos::parallel_reduce(
+      "bench cooling bins checksum",
+      Kokkos::MDRangePolicy<Kokkos::Rank<2>>(parthenon::DevExecSpace(), {0, 0}, {n, n}),
+      KOKKOS_LAMBDA(const int j, const int i, Real &lsum) { lsum += bins(j, i) + 1; },
+      sum);
+  return sum;
+}
+
+// Number of cells for which the lookups of the cooling and the linear searches result in
+// different bins
+int CompareCoolingBins(const CoolingBinsData &c, const int n) {
+  parthenon::ParArray2D<int> ref("ref bins", n, n);
+  parthenon::ParArray2D<int> bins("bins", n, n);
+  BenchCoolingBins<true>(c, ref, n);
+  BenchCoolingBins<false>(c, bins, n);
+  int mismatches = 0;
+  Kokkos::parallel_reduce(
+      "bench compare cooling bins",
+      Kokkos::MDRangePolicy<Kokkos::Rank<2>>(parthenon::DevExecSpace(), {0, 0}, {n, n}),
+      KOKKOS_LAMBDA(const int j, const int i, int &lsum) {
+        lsum += bins(j, i) != ref(j, i) ? 1 : 0;
+      },
+      mismatches);
+  return mismatches;
+}
+
+// The "interfaces" of these benchmarks are the cells.
+template <bool linear = false>
+void AddCoolingBins(std::vector<Benchmark> &benchmarks, const std::string &name,
+                    const CoolingBinsData &c, const int n) {
+  parthenon::ParArray2D<int> bins("bins", n, n);
+  // only the bins are written, the tables are (mostly) cached
+  const double bytes = static_cast<double>(n) * n * sizeof(int);
+  benchmarks.push_back({"cooling bins " + name,
+                        [=]() { BenchCoolingBins<linear>(c, bins, n); },
+                        static_cast<double>(n) * n, bytes,
+                        [=]() { return CoolingBinsChecksum<linear>(c, bins, n); }});
+}
+
+#ifdef ATHENAPK_SIMD_RIEMANN
+// Maximum difference of the fluxes of the explicitly vectorized and the scalar version of
+// a Riemann solver relative to the maximum absolute flux for normal direction `ivx`.
+// `cons_pack` needs to contain fluxes in direction `ivx`.
+template <Fluid fluid, RiemannSolver rsolver, typename EOS>
+Real CompareRiemann(const BenchPack &q, const VariableFluxPack<Real> &cons_pack,
+                    const EOS &eos, const int n, const int ivx) {
+  const int nhydro = fluid == Fluid::euler ? NHYDRO : nhydro_glmmhd;
+  const int fs = nghost;
+  const int fe = nghost + n;
+  parthenon::ParArray3D<Real> ref("ref flux", nhydro, n, n + 1);
+
+  BenchRiemann<fluid, Riemann<fluid, rsolver>>(q, cons_pack, eos, n, ivx);
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "bench copy ref flux", parthenon::DevExecSpace(), 0,
+      nhydro - 1, nghost, nghost + n - 1, fs, fe,
+      KOKKOS_LAMBDA(const int v, const int j, const int i) {
+        ref(v, j - nghost, i - fs) = cons_pack.flux(ivx, v, 0, j, i);
+      });
+
+  BenchRiemann<fluid, SimdRiemann<fluid, rsolver>>(q, cons_pack, eos, n, ivx);
+  const auto policy = Kokkos::MDRangePolicy<Kokkos::Rank<3>>(
+      parthenon::DevExecSpace(), {0, nghost, fs}, {nhydro, nghost + n, fe + 1});
+  Real maxdiff = 0.0;
+  Kokkos::parallel_reduce(
+      "bench compare flux", policy,
+      KOKKOS_LAMBDA(const int v, const int j, const int i, Real &lmax) {
+        const Real diff =
+            cons_pack.flux(ivx, v, 0, j, i) - ref(v, j - nghost, i - fs);
+        lmax = Kokkos::fmax(lmax, Kokkos::fabs(diff));
+      },
+      Kokkos::Max<Real>(maxdiff));
+  Real maxref = 0.0;
+  Kokkos::parallel_reduce(
+      "bench max ref flux", policy,
+      KOKKOS_LAMBDA(const int v, const int j, const int i, Real &lmax) {
+        lmax = Kokkos::fmax(lmax, Kokkos::fabs(ref(v, j - nghost, i - fs)));
+      },
+      Kokkos::Max<Real>(maxref));
+  return maxref > 0.0 ? maxdiff / maxref : maxdiff;
+}
+#endif // ATHENAPK_SIMD_RIEMANN
+
+void PrintUsage(const char *exe) {
+  std::printf("Usage: %s [--length N] [--nvar V] [--reps R] [--filter STR] [--check]\n",
+              exe);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  Kokkos::ScopeGuard guard(argc, argv);
+
+  BenchOptions opts;
+  for (int a = 1; a < argc; ++a) {
+    const std::string arg(argv[a]);
+    if (arg == "-h" || arg == "--help") {
+      PrintUsage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+    if (arg == "--check") {
+      opts.check = true;
+      continue;
+    }
+    if (a + 1 >= argc) {
+      PrintUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+    const std::string val(argv[++a]);
+    if (arg == "--length") {
+      opts.length = std::stoi(val);
+    } else if (arg == "--nvar") {
+      opts.nvar = std::stoi(val);
+    } else if (arg == "--reps") {
+      opts.reps = std::stoi(val);
+    } else if (arg == "--filter") {
+      opts.filter = val;
+    } else {
+      PrintUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  PARTHENON_REQUIRE(opts.length > 0 && opts.nvar > 0 && opts.reps > 0,
+                    "Length, number of variables, and repetitions need to be positive.");
+
+  const int n = opts.length;
+  const int nx = n + 2 * nghost;
+
+  {
+    // Primitive variables. The Riemann solvers always require the MHD variables.
+    const int nprim = std::max(opts.nvar, nhydro_glmmhd);
+    BenchPack q{parthenon::ParArray4D<Real>("prim", nprim, 1, nx, nx), opts.nvar,
+                BenchCoords{1.0 / n}};
+    InitPrimitives(q);
+
+    // The fluxes are written to a (regular) block so that the Riemann solvers can be
+    // called with a VariableFluxPack.
+    parthenon::Globals::nghost = nghost;
+    auto pkg = std::make_shared<StateDescriptor>("Bench");
+    pkg->AddField("cons",
+                  Metadata({Metadata::Cell, Metadata::Independent, Metadata::WithFluxes},
+                           std::vector<int>({nhydro_glmmhd})));
+    auto pmb = std::make_shared<MeshBlock>(n, 2);
+    auto mbd = std::make_shared<MeshBlockData<Real>>();
+    mbd->Initialize(pkg, pmb);
+    const auto cons = mbd->PackVariablesAndFluxes(
+        std::vector<parthenon::MetadataFlag>({Metadata::Independent}));
+
+    const Real gamma = 5.0 / 3.0;
+    const Real inf = std::numeric_limits<Real>::infinity();
+    const AdiabaticHydroEOS eos_hydro(0.0, 0.0, 0.0, inf, inf, gamma);
+    const AdiabaticGLMMHDEOS eos_glmmhd(0.0, 0.0, 0.0, inf, inf, gamma);
+
+    std::vector<Benchmark> benchmarks;
+    AddReconstruct<Reconstruction::dc>(benchmarks, "dc", q, n);
+    AddReconstruct<Reconstruction::plm>(benchmarks, "plm", q, n);
+    AddReconstruct<Reconstruction::ppm>(benchmarks, "ppm", q, n);
+    AddReconstruct<Reconstruction::weno3>(benchmarks, "weno3", q, n);
+    AddReconstruct<Reconstruction::limo3>(benchmarks, "limo3", q, n);
+    AddReconstruct<Reconstruction::wenoz>(benchmarks, "wenoz", q, n);
+#ifdef ATHENAPK_MIXED_PRECISION
+    // Reconstruction from the single precision copy of the primitive variables as used
+    // in the flux calculation (compare to the timings of the kernels above)
+    const int nprim_sp = Hydro::NumPrimSPComponents(opts.nvar);
+    BenchPack q_sp_data{parthenon::ParArray4D<Real>("prim_sp", nprim_sp, 1, nx, nx),
+                        nprim_sp, BenchCoords{1.0 / n}};
+    const int nvar = opts.nvar;
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "bench init sp", parthenon::DevExecSpace(), 0, 0, 0,
+        nx - 1, 0, nx - 1, KOKKOS_LAMBDA(const int k, const int j, const int i) {
+          Hydro::StorePrimSP(q, q_sp_data, nvar, k, j, i);
+        });
+    const Hydro::PrimSPBlock<BenchPack> q_sp(q_sp_data, nvar);
+    AddReconstruct<Reconstruction::dc>(benchmarks, "dc sp", q_sp, n, sizeof(float));
+    AddReconstruct<Reconstruction::plm>(benchmarks, "plm sp", q_sp, n, sizeof(float));
+    AddReconstruct<Reconstruction::ppm>(benchmarks, "ppm sp", q_sp, n, sizeof(float));
+    AddReconstruct<Reconstruction::weno3>(benchmarks, "weno3 sp", q_sp, n, sizeof(float));
+    AddReconstruct<Reconstruction::limo3>(benchmarks, "limo3 sp", q_sp, n, sizeof(float));
+    AddReconstruct<Reconstruction::wenoz>(benchmarks, "wenoz sp", q_sp, n, sizeof(float));
+#endif // ATHENAPK_MIXED_PRECISION
+    AddRiemann<Fluid::euler, RiemannSolver::hlle>(benchmarks, "euler hlle", q, cons,
+                                                  eos_hydro, n);
+    AddRiemann<Fluid::euler, RiemannSolver::hllc>(benchmarks, "euler hllc", q, cons,
+                                                  eos_hydro, n);
+    AddRiemann<Fluid::glmmhd, RiemannSolver::hlle>(benchmarks, "glmmhd hlle", q, cons,
+                                                   eos_glmmhd, n);
+    AddRiemann<Fluid::glmmhd, RiemannSolver::hlld>(benchmarks, "glmmhd hlld", q, cons,
+                                                   eos_glmmhd, n);
+
+    // Bin lookups of the Townsend cooling for evenly and unevenly spaced tables of
+    // different sizes. The linear search (of the evenly spaced tables) is the reference.
+    std::vector<std::pair<std::string, CoolingBinsData>> cooling_tables;
+    for (const int n_temp : {100, 1000, 10000}) {
+      const auto size = std::to_string(n_temp);
+      const auto uniform = MakeCoolingBinsData(n_temp, true);
+      const auto quadratic = MakeCoolingBinsData(n_temp, false);
+      AddCoolingBins(benchmarks, "uniform " + size, uniform, n);
+      AddCoolingBins(benchmarks, "quadratic " + size, quadratic, n);
+      AddCoolingBins<true>(benchmarks, "linear " + size, uniform, n);
+      cooling_tables.emplace_back("uniform " + size, uniform);
+      cooling_tables.emplace_back("quadratic " + size, quadratic);
+    }
+
+    if (opts.check) {
+      const auto selected = [&](const std::string &name) {
+        return name.find(opts.filter) != std::string::npos;
+      };
+      bool passed = true;
+
+      std::printf("# %-20s %14s (vs linear search)\n", "cooling bins check",
+                  "mismatches");
+      for (const auto &[name, data] : cooling_tables) {
+        if (!selected("cooling bins " + name)) {
+          continue;
+        }
+        const int mismatches = CompareCoolingBins(data, n);
+        const bool ok = mismatches == 0;
+        passed = passed && ok;
+        std::printf("  %-20s %14d %s\n", name.c_str(), mismatches, ok ? "" : "FAILED");
+      }
+
+#ifdef ATHENAPK_SIMD_RIEMANN
+      // Tolerance allowing for the amplification of round-off by the different order of
+      // the operations, e.g., in the HLLD intermediate states. Selecting a wrong branch
+      // results in differences of many orders of magnitude larger.
+      constexpr Real tol = 1e-10;
+      using CompareFun = std::function<Real(const VariableFluxPack<Real> &, int)>;
+      const std::vector<std::pair<std::string, CompareFun>> checks = {
+          {"euler hlle",
+           [&](const VariableFluxPack<Real> &cons_check, const int ivx) {
+             return CompareRiemann<Fluid::euler, RiemannSolver::hlle>(q, cons_check,
+                                                                      eos_hydro, n, ivx);
+           }},
+          {"euler hllc",
+           [&](const VariableFluxPack<Real> &cons_check, const int ivx) {
+             return CompareRiemann<Fluid::euler, RiemannSolver::hllc>(q, cons_check,
+                                                                      eos_hydro, n, ivx);
+           }},
+          {"glmmhd hlle",
+           [&](const VariableFluxPack<Real> &cons_check, const int ivx) {
+             return CompareRiemann<Fluid::glmmhd, RiemannSolver::hlle>(
+                 q, cons_check, eos_glmmhd, n, ivx);
+           }},
+          {"glmmhd hlld",
+           [&](const VariableFluxPack<Real> &cons_check, const int ivx) {
+             return CompareRiemann<Fluid::glmmhd, RiemannSolver::hlld>(
+                 q, cons_check, eos_glmmhd, n, ivx);
+           }}};
+      if (std::any_of(checks.begin(), checks.end(), [&](const auto &check) {
+            return selected("riemann " + check.first);
+          })) {
+        // The fluxes in all three directions require a 3D block (only the k = 0 plane
+        // is used), which is why the check should be run with a small --length.
+        auto pmb_check = std::make_shared<MeshBlock>(n, 3);
+        auto mbd_check = std::make_shared<MeshBlockData<Real>>();
+        mbd_check->Initialize(pkg, pmb_check);
+        const auto cons_check = mbd_check->PackVariablesAndFluxes(
+            std::vector<parthenon::MetadataFlag>({Metadata::Independent}));
+
+        std::printf("# %-20s %14s (SIMD vs scalar, tolerance %.1e)\n", "riemann check",
+                    "max rel diff", tol);
+        for (const auto &[name, compare] : checks) {
+          if (!selected("riemann " + name)) {
+            continue;
+          }
+          for (const int ivx : {IV1, IV2, IV3}) {
+            const Real diff = compare(cons_check, ivx);
+            // also fails for NaN
+            const bool ok = diff < tol;
+            passed = passed && ok;
+            const std::string label = name + " x" + std::to_string(ivx);
+            std::printf("  %-20s %14.3e %s\n", label.c_str(), diff,
+                        ok ? "" : "FAILED");
+          }
+        }
+      }
+#endif // ATHENAPK_SIMD_RIEMANN
+
+      if (!passed) {
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::printf("# pencil length %d, %d pencils, %d reconstructed variables, %d reps\n",
+                n, n, opts.nvar, opts.reps);
+#ifdef ATHENAPK_SIMD_RIEMANN
+    std::printf("# using explicitly vectorized Riemann solvers\n");
+#endif
+    std::printf("# %-20s %14s %10s %14s\n", "kernel", "ns/interface", "GB/s",
+                "checksum");
+    bool all_valid = true;
+    for (const auto &bench : benchmarks) {
+      if (bench.name.find(opts.filter) == std::string::npos) {
+        continue;
+      }
+      // Guard against reporting timings of a broken (e.g., miscompiled) kernel
+      const Real checksum = bench.checksum();
+      const bool valid = std::isfinite(checksum) && checksum > 0.0;
+      all_valid = all_valid && valid;
+
+      // warm up
+      bench.kernel();
+      Kokkos::fence();
+
+      Kokkos::Timer timer;
+      for (int r = 0; r < opts.reps; ++r) {
+        bench.kernel();
+      }
+      Kokkos::fence();
+      const double seconds = timer.seconds() / opts.reps;
+
+      std::printf("  %-20s %14.3f %10.2f %14.6e %s\n", bench.name.c_str(),
+                  1e9 * seconds / bench.ninterfaces, 1e-9 * bench.bytes / seconds,
+                  checksum, valid ? "" : "INVALID");
+    }
+    if (!all_valid) {
+      std::printf("# Error: INVALID kernels produced non-finite or zero results.\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
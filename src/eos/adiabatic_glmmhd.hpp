@@ -58,10 +58,11 @@ class AdiabaticGLMMHDEOS : public EquationOfState {
   // \!fn Real EquationOfState::ConsToPrim(View4D cons, View4D prim, const int& k, const
   // int& j, const int& i) \brief Fills an array of primitives given an array of
   // conserveds, potentially updating the conserved with floors
+  // Returns a mask of the floors and ceilings applied (see FloorEvent).
   template <typename View4D>
-  KOKKOS_INLINE_FUNCTION void ConsToPrim(View4D cons, View4D prim, const int &nhydro,
-                                         const int &nscalars, const int &k, const int &j,
-                                         const int &i) const {
+  KOKKOS_INLINE_FUNCTION int ConsToPrim(View4D cons, View4D prim, const int &nhydro,
+                                        const int &nscalars, const int &k, const int &j,
+                                        const int &i) const {
     auto gam = GetGamma();
     auto gm1 = gam - 1.0;
     auto density_floor_ = GetDensityFloor();
@@ -96,8 +97,12 @@ class AdiabaticGLMMHDEOS : public EquationOfState {
     PARTHENON_REQUIRE(u_d > 0.0 || density_floor_ > 0.0,
                       "Got negative density. Consider enabling first-order flux "
                       "correction or setting a reasonble density floor.");
+    int events = 0;
     // apply density floor, without changing momentum or energy
-    u_d = (u_d > density_floor_) ? u_d : density_floor_;
+    if (!(u_d > density_floor_)) {
+      u_d = density_floor_;
+      events |= FloorEventBit(FloorEvent::density_floor);
+    }
     w_d = u_d;
 
     Real di = 1.0 / u_d;
@@ -129,6 +134,7 @@ class AdiabaticGLMMHDEOS : public EquationOfState {
       Real e_k_new = 0.5 * u_d * SQR(velocity_ceiling_);
       u_e -= e_k - e_k_new;
       e_k = e_k_new;
+      events |= FloorEventBit(FloorEvent::velocity_ceiling);
     }
 
     // Let's apply floors explicitly, i.e., by default floor will be disabled (<=0)
@@ -142,6 +148,7 @@ class AdiabaticGLMMHDEOS : public EquationOfState {
       // apply pressure floor, correct total energy
       u_e = (pressure_floor_ / gm1) + e_k + e_B;
       w_p = pressure_floor_;
+      events |= FloorEventBit(FloorEvent::pressure_floor);
     }
 
     // temperature (internal energy) based pressure floor
@@ -150,6 +157,7 @@ class AdiabaticGLMMHDEOS : public EquationOfState {
       // apply temperature floor, correct total energy
       u_e = (u_d * e_floor_) + e_k + e_B;
       w_p = eff_pressure_floor;
+      events |= FloorEventBit(FloorEvent::temperature_floor);
     }
 
     // temperature (internal energy) based pressure ceiling
@@ -158,12 +166,14 @@ class AdiabaticGLMMHDEOS : public EquationOfState {
       // apply temperature ceiling, correct total energy
       u_e = (u_d * e_ceiling_) + e_k + e_B;
       w_p = eff_pressure_ceiling;
+      events |= FloorEventBit(FloorEvent::temperature_ceiling);
     }
 
     // Convert passive scalars
     for (auto n = nhydro; n < nhydro + nscalars; ++n) {
       prim(n, k, j, i) = cons(n, k, j, i) * di;
     }
+    return events;
   }
 
  private:
@@ -16,6 +16,9 @@
 // Parthenon headers
 #include "../eos/adiabatic_hydro.hpp"
 #include "../main.hpp"
+#ifdef ATHENAPK_MIXED_PRECISION
+#include "../hydro/mixed_precision.hpp"
+#endif
 #include "config.hpp"
 #include "interface/variable.hpp"
 #include "kokkos_abstraction.hpp"
@@ -33,6 +36,9 @@ using parthenon::ParArray4D;
 void AdiabaticHydroEOS::ConservedToPrimitive(MeshData<Real> *md) const {
   auto const cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
   auto prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+#ifdef ATHENAPK_MIXED_PRECISION
+  auto prim_sp_pack = md->PackVariables(std::vector<std::string>{"prim_sp"});
+#endif
   auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
   auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
   auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
@@ -43,13 +49,47 @@ void AdiabaticHydroEOS::ConservedToPrimitive(MeshData<Real> *md) const {
 
   auto this_on_device = (*this);
 
-  parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "ConservedToPrimitive", parthenon::DevExecSpace(), 0,
-      cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
-        const auto &cons = cons_pack(b);
-        auto &prim = prim_pack(b);
+  // Returns the mask of the floor events (see ConsToPrim())
+  auto cons_to_prim = KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+    const auto &cons = cons_pack(b);
+    auto &prim = prim_pack(b);
+    const auto events = this_on_device.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+#ifdef ATHENAPK_MIXED_PRECISION
+    Hydro::StorePrimSP(prim, prim_sp_pack(b), nhydro + nscalars, k, j, i);
+#endif
+    return events;
+  };
 
-        return this_on_device.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
-      });
+  if (!pkg->Param<bool>("floor_event_counters")) {
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "ConservedToPrimitive", parthenon::DevExecSpace(), 0,
+        cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          cons_to_prim(b, k, j, i);
+        });
+    return;
+  }
+
+  // Events are only counted in the interior as the ghost zones are copies of interior
+  // cells (of other blocks) that are converted themselves.
+  auto ib_int = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  auto jb_int = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  auto kb_int = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  FloorEventCounts events;
+  Kokkos::parallel_reduce(
+      "ConservedToPrimitive",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+          parthenon::DevExecSpace(), {0, kb.s, jb.s, ib.s},
+          {cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1}, {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
+                    FloorEventCounts &levents) {
+        const auto mask = cons_to_prim(b, k, j, i);
+        if (mask != 0 && k >= kb_int.s && k <= kb_int.e && j >= jb_int.s &&
+            j <= jb_int.e && i >= ib_int.s && i <= ib_int.e) {
+          levents.Add(mask);
+        }
+      },
+      Kokkos::Sum<FloorEventCounts>(events));
+  AccumulateFloorEvents(pkg->Param<FloorEventCountsHost>("floor_event_counts"), events);
 }
@@ -48,10 +48,11 @@ class AdiabaticHydroEOS : public EquationOfState {
   // \!fn Real EquationOfState::ConsToPrim(View4D cons, View4D prim, const int& k, const
   // int& j, const int& i) \brief Fills an array of primitives given an array of
   // conserveds, potentially updating the conserved with floors
+  // Returns a mask of the floors and ceilings applied (see FloorEvent).
   template <typename View4D>
-  KOKKOS_INLINE_FUNCTION void ConsToPrim(View4D cons, View4D prim, const int &nhydro,
-                                         const int &nscalars, const int &k, const int &j,
-                                         const int &i) const {
+  KOKKOS_INLINE_FUNCTION int ConsToPrim(View4D cons, View4D prim, const int &nhydro,
+                                        const int &nscalars, const int &k, const int &j,
+                                        const int &i) const {
     Real gm1 = GetGamma() - 1.0;
     auto density_floor_ = GetDensityFloor();
     auto pressure_floor_ = GetPressureFloor();
@@ -77,8 +78,12 @@ class AdiabaticHydroEOS : public EquationOfState {
     PARTHENON_REQUIRE(u_d > 0.0 || density_floor_ > 0.0,
                       "Got negative density. Consider enabling first-order flux "
                       "correction or setting a reasonble density floor.");
+    int events = 0;
     // apply density floor, without changing momentum or energy
-    u_d = (u_d > density_floor_) ? u_d : density_floor_;
+    if (!(u_d > density_floor_)) {
+      u_d = density_floor_;
+      events |= FloorEventBit(FloorEvent::density_floor);
+    }
     w_d = u_d;
 
     Real di = 1.0 / u_d;
@@ -104,6 +109,7 @@ class AdiabaticHydroEOS : public EquationOfState {
       Real e_k_new = 0.5 * u_d * SQR(velocity_ceiling_);
       u_e -= e_k - e_k_new;
       e_k = e_k_new;
+      events |= FloorEventBit(FloorEvent::velocity_ceiling);
     }
 
     // Let's apply floors explicitly, i.e., by default floor will be disabled (<=0)
@@ -117,6 +123,7 @@ class AdiabaticHydroEOS : public EquationOfState {
       // apply pressure floor, correct total energy
       u_e = (pressure_floor_ / gm1) + e_k;
       w_p = pressure_floor_;
+      events |= FloorEventBit(FloorEvent::pressure_floor);
     }
 
     // temperature (internal energy) based pressure floor
@@ -125,6 +132,7 @@ class AdiabaticHydroEOS : public EquationOfState {
       // apply temperature floor, correct total energy
       u_e = (u_d * e_floor_) + e_k;
       w_p = eff_pressure_floor;
+      events |= FloorEventBit(FloorEvent::temperature_floor);
     }
 
     // temperature (internal energy) based pressure ceiling
@@ -133,12 +141,14 @@ class AdiabaticHydroEOS : public EquationOfState {
       // apply temperature ceiling, correct total energy
       u_e = (u_d * e_ceiling_) + e_k;
       w_p = eff_pressure_ceiling;
+      events |= FloorEventBit(FloorEvent::temperature_ceiling);
     }
 
     // Convert passive scalars
     for (auto n = nhydro; n < nhydro + nscalars; ++n) {
       prim(n, k, j, i) = cons(n, k, j, i) * di;
     }
+    return events;
   }
 
  private:
@@ -12,6 +12,7 @@
 // C headers
 
 // C++ headers
+#include <cstdint>
 #include <limits> // std::numeric_limits<float>
 
 // Parthenon headers
@@ -27,6 +28,79 @@ using parthenon::Real;
 
 // enum class EOS { isothermal, adiabatic, general, undefined };
 
+// Events counted in the "floor_event_counts" param of the Hydro package (if
+// `hydro/floor_event_counters` is enabled).
+// The floors and ceilings are applied in ConsToPrim(), which returns a mask with the bit
+// FloorEventBit(event) set for each event applied to the cell. The first order flux
+// correction events (cells whose fluxes were corrected and cells that still rely on the
+// pressure floor) are recorded in FirstOrderFluxCorrect().
+enum class FloorEvent {
+  density_floor,
+  velocity_ceiling,
+  pressure_floor,
+  temperature_floor,
+  temperature_ceiling,
+  fofc_corrected,
+  fofc_need_floor,
+  num
+};
+
+KOKKOS_INLINE_FUNCTION
+constexpr int FloorEventBit(const FloorEvent event) {
+  return 1 << static_cast<int>(event);
+}
+
+// Number of cells per FloorEvent. Used as value type of a single Kokkos::Sum reducer so
+// that all events are counted with one reduction fused into the existing kernel.
+struct FloorEventCounts {
+  std::int64_t counts[static_cast<int>(FloorEvent::num)];
+
+  KOKKOS_INLINE_FUNCTION
+  FloorEventCounts() {
+    for (int e = 0; e < static_cast<int>(FloorEvent::num); e++) {
+      counts[e] = 0;
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  FloorEventCounts &operator+=(const FloorEventCounts &rhs) {
+    for (int e = 0; e < static_cast<int>(FloorEvent::num); e++) {
+      counts[e] += rhs.counts[e];
+    }
+    return *this;
+  }
+
+  // Adds the events in `mask` (as returned by ConsToPrim())
+  KOKKOS_INLINE_FUNCTION
+  void Add(const int mask) {
+    for (int e = 0; e < static_cast<int>(FloorEvent::num); e++) {
+      counts[e] += (mask >> e) & 1;
+    }
+  }
+};
+
+namespace Kokkos {
+template <>
+struct reduction_identity<FloorEventCounts> {
+  KOKKOS_FORCEINLINE_FUNCTION static FloorEventCounts sum() { return FloorEventCounts(); }
+};
+} // namespace Kokkos
+
+// Host counters (one per FloorEvent) of all events on this rank since the beginning of
+// the simulation (stored in the "floor_event_counts" param of the Hydro package)
+using FloorEventCountsHost = Kokkos::View<std::int64_t *, Kokkos::HostSpace>;
+
+// Adds the (already reduced) `events` to the host counters. Atomic as partitions may be
+// processed concurrently.
+inline void AccumulateFloorEvents(const FloorEventCountsHost &counters,
+                                  const FloorEventCounts &events) {
+  for (int e = 0; e < static_cast<int>(FloorEvent::num); e++) {
+    if (events.counts[e] != 0) {
+      Kokkos::atomic_add(&counters(e), events.counts[e]);
+    }
+  }
+}
+
 //! \class EquationOfState
 //  \brief abstract base class for equation of state object
 
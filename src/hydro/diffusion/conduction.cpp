@@ -12,7 +12,10 @@
 //! \brief
 
 // Parthenon headers
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <parthenon/package.hpp>
 
 // AthenaPK headers
@@ -34,13 +37,129 @@ Real ThermalDiffusivity::Get(const Real pres, const Real rho) const {
     const Real kappa_spitzer = coeff_ * std::pow(T_cgs, 5. / 2.); // Full spitzer
 
     // Convert conductivity to diffusivity
-    return kappa_spitzer * mbar_ / kb_ / rho;
+    const Real diff = kappa_spitzer * mbar_ / kb_ / rho;
+    return max_diff_ > 0.0 ? std::min(diff, max_diff_) : diff;
 
   } else {
     return 0.0;
   }
 }
 
+// Conduction timestep constraint (without cfl and dimensional prefactor) of cell k,j,i
+// for the general case (i.e., anisotropic and/or with varying coefficient).
+// Returns the largest Real if the cell does not constrain the timestep and stores the
+// ratio of classic to saturated flux in `sat_ratio`.
+template <typename PrimBlock, typename Coords>
+KOKKOS_INLINE_FUNCTION Real
+ConductionTimestepCell(const PrimBlock &prim, const Coords &coords,
+                       const ThermalDiffusivity &thermal_diff, const Real flux_sat_prefac,
+                       const int ndim, const int k, const int j, const int i,
+                       Real &sat_ratio) {
+  constexpr auto no_limit = std::numeric_limits<Real>::max();
+  sat_ratio = 0.0;
+  const auto &rho = prim(IDN, k, j, i);
+  const auto &p = prim(IPR, k, j, i);
+
+  const auto dTdx = 0.5 *
+                    (prim(IPR, k, j, i + 1) / prim(IDN, k, j, i + 1) -
+                     prim(IPR, k, j, i - 1) / prim(IDN, k, j, i - 1)) /
+                    coords.template Dxc<1>(i);
+
+  const auto dTdy = ndim >= 2 ? 0.5 *
+                                    (prim(IPR, k, j + 1, i) / prim(IDN, k, j + 1, i) -
+                                     prim(IPR, k, j - 1, i) / prim(IDN, k, j - 1, i)) /
+                                    coords.template Dxc<2>(j)
+                              : 0.0;
+
+  const auto dTdz = ndim >= 3 ? 0.5 *
+                                    (prim(IPR, k + 1, j, i) / prim(IDN, k + 1, j, i) -
+                                     prim(IPR, k - 1, j, i) / prim(IDN, k - 1, j, i)) /
+                                    coords.template Dxc<3>(k)
+                              : 0.0;
+  const auto gradTmag = sqrt(SQR(dTdx) + SQR(dTdy) + SQR(dTdz));
+
+  // No temperature gradient -> no thermal conduction-> no timestep restriction
+  if (gradTmag == 0.0) {
+    return no_limit;
+  }
+  auto thermal_diff_coeff = thermal_diff.Get(p, rho);
+
+  auto const flux_sat = flux_sat_prefac * std::sqrt(p / rho) * p;
+  auto const flux_classic = thermal_diff_coeff * rho * gradTmag;
+  sat_ratio = flux_classic / flux_sat;
+
+  Real dt = no_limit;
+  if (thermal_diff.GetType() == Conduction::isotropic) {
+    dt = SQR(coords.template Dxc<1>(k, j, i)) / thermal_diff_coeff;
+    if (ndim >= 2) {
+      dt = fmin(dt, SQR(coords.template Dxc<2>(k, j, i)) / thermal_diff_coeff);
+    }
+    if (ndim >= 3) {
+      dt = fmin(dt, SQR(coords.template Dxc<3>(k, j, i)) / thermal_diff_coeff);
+    }
+    return dt;
+  }
+  const auto &Bx = prim(IB1, k, j, i);
+  const auto &By = prim(IB2, k, j, i);
+  const auto &Bz = prim(IB3, k, j, i);
+  const auto Bmag = sqrt(SQR(Bx) + SQR(By) + SQR(Bz));
+  // Need to have some local field for anisotropic conduction
+  if (Bmag == 0.0) {
+    return no_limit;
+  }
+
+  // In the saturated regime, i.e., when the ratio of classic to saturated fluxes
+  // is large, the equation becomes hyperbolic with the signal speed of the
+  // conduction front being comparable to the sound speed, see [Balsara, Tilley,
+  // and Howk MANRAS 2008]. Therefore, we don't need to contrain the "parabolic"
+  // timestep here (and the hyperbolic one is constrained automatically by the
+  // fluid EstimateTimestep call).
+  if (sat_ratio > 100.) {
+    return no_limit;
+  }
+
+  const auto costheta = fabs(Bx * dTdx + By * dTdy + Bz * dTdz) / (Bmag * gradTmag);
+
+  dt = SQR(coords.template Dxc<1>(k, j, i)) /
+       (thermal_diff_coeff * fabs(Bx) / Bmag * costheta + TINY_NUMBER);
+  if (ndim >= 2) {
+    dt = fmin(dt, SQR(coords.template Dxc<2>(k, j, i)) /
+                      (thermal_diff_coeff * fabs(By) / Bmag * costheta + TINY_NUMBER));
+  }
+  if (ndim >= 3) {
+    dt = fmin(dt, SQR(coords.template Dxc<3>(k, j, i)) /
+                      (thermal_diff_coeff * fabs(Bz) / Bmag * costheta + TINY_NUMBER));
+  }
+  return dt;
+}
+
+namespace {
+// Conduction timestep constraint of a cell (and the data of the cell for the
+// diagnostics), used as value type of a Kokkos::Min reducer so that the data of the
+// limiting cell is reduced in the same kernel. Ties are broken by the linear cell index
+// `loc`.
+struct ConductionDtCell {
+  Real dt;
+  std::int64_t loc;
+  Real rho, p, diff, sat_ratio;
+
+  KOKKOS_INLINE_FUNCTION
+  bool operator<(const ConductionDtCell &rhs) const {
+    return dt < rhs.dt || (dt == rhs.dt && loc < rhs.loc);
+  }
+};
+} // namespace
+
+namespace Kokkos {
+template <>
+struct reduction_identity<ConductionDtCell> {
+  KOKKOS_FORCEINLINE_FUNCTION static ConductionDtCell min() {
+    return {std::numeric_limits<Real>::max(), std::numeric_limits<std::int64_t>::max(),
+            0.0, 0.0, 0.0, 0.0};
+  }
+};
+} // namespace Kokkos
+
 Real EstimateConductionTimestep(MeshData<Real> *md) {
   // get to package via first block in Meshdata (which exists by construction)
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
@@ -91,98 +210,86 @@ Real EstimateConductionTimestep(MeshData<Real> *md) {
         },
         Kokkos::Min<Real>(min_dt_cond));
   } else {
+    // The data of the limiting cell is only recorded for the diagnostics
+    const bool dt_diagnostics =
+        hydro_pkg->AllParams().hasKey("conduction_dt_limiter_local");
+    ConductionDtCell min_cell;
+    const std::int64_t ni = prim_pack.GetDim(1);
+    const std::int64_t nj = prim_pack.GetDim(2);
+    const std::int64_t nk = prim_pack.GetDim(3);
     Kokkos::parallel_reduce(
         "EstimateConductionTimestep (general)",
         Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
             DevExecSpace(), {0, kb.s, jb.s, ib.s},
             {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
             {1, 1, 1, ib.e + 1 - ib.s}),
-        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &min_dt) {
-          const auto &coords = prim_pack.GetCoords(b);
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
+                      ConductionDtCell &lmin) {
           const auto &prim = prim_pack(b);
-          const auto &rho = prim(IDN, k, j, i);
-          const auto &p = prim(IPR, k, j, i);
-
-          const auto dTdx = 0.5 *
-                            (prim(IPR, k, j, i + 1) / prim(IDN, k, j, i + 1) -
-                             prim(IPR, k, j, i - 1) / prim(IDN, k, j, i - 1)) /
-                            coords.Dxc<1>(i);
-
-          const auto dTdy = ndim >= 2
-                                ? 0.5 *
-                                      (prim(IPR, k, j + 1, i) / prim(IDN, k, j + 1, i) -
-                                       prim(IPR, k, j - 1, i) / prim(IDN, k, j - 1, i)) /
-                                      coords.Dxc<2>(j)
-                                : 0.0;
-
-          const auto dTdz = ndim >= 3
-                                ? 0.5 *
-                                      (prim(IPR, k + 1, j, i) / prim(IDN, k + 1, j, i) -
-                                       prim(IPR, k - 1, j, i) / prim(IDN, k - 1, j, i)) /
-                                      coords.Dxc<3>(k)
-                                : 0.0;
-          const auto gradTmag = sqrt(SQR(dTdx) + SQR(dTdy) + SQR(dTdz));
-
-          // No temperature gradient -> no thermal conduction-> no timestep restriction
-          if (gradTmag == 0.0) {
-            return;
-          }
-          auto thermal_diff_coeff = thermal_diff.Get(p, rho);
-
-          if (thermal_diff.GetType() == Conduction::isotropic) {
-            min_dt = fmin(min_dt, SQR(coords.Dxc<1>(k, j, i)) / thermal_diff_coeff);
-            if (ndim >= 2) {
-              min_dt = fmin(min_dt, SQR(coords.Dxc<2>(k, j, i)) / thermal_diff_coeff);
+          Real sat_ratio;
+          ConductionDtCell cell{};
+          cell.dt = ConductionTimestepCell(prim, prim_pack.GetCoords(b), thermal_diff,
+                                           flux_sat_prefac, ndim, k, j, i, sat_ratio);
+          cell.loc = ((b * nk + k) * nj + j) * ni + i;
+          if (cell < lmin) {
+            if (dt_diagnostics) {
+              cell.rho = prim(IDN, k, j, i);
+              cell.p = prim(IPR, k, j, i);
+              cell.diff = thermal_diff.Get(cell.p, cell.rho);
+              cell.sat_ratio = sat_ratio;
             }
-            if (ndim >= 3) {
-              min_dt = fmin(min_dt, SQR(coords.Dxc<3>(k, j, i)) / thermal_diff_coeff);
-            }
-            return;
-          }
-          const auto &Bx = prim(IB1, k, j, i);
-          const auto &By = prim(IB2, k, j, i);
-          const auto &Bz = prim(IB3, k, j, i);
-          const auto Bmag = sqrt(SQR(Bx) + SQR(By) + SQR(Bz));
-          // Need to have some local field for anisotropic conduction
-          if (Bmag == 0.0) {
-            return;
-          }
-
-          // In the saturated regime, i.e., when the ratio of classic to saturated fluxes
-          // is large, the equation becomes hyperbolic with the signal speed of the
-          // conduction front being comparable to the sound speed, see [Balsara, Tilley,
-          // and Howk MANRAS 2008]. Therefore, we don't need to contrain the "parabolic"
-          // timestep here (and the hyperbolic one is constrained automatically by the
-          // fluid EstimateTimestep call).
-          auto const flux_sat = flux_sat_prefac * std::sqrt(p / rho) * p;
-          auto const flux_classic = thermal_diff_coeff * rho * gradTmag;
-          if (flux_classic / flux_sat > 100.) {
-            return;
-          }
-
-          const auto costheta =
-              fabs(Bx * dTdx + By * dTdy + Bz * dTdz) / (Bmag * gradTmag);
-
-          min_dt = fmin(min_dt, SQR(coords.Dxc<1>(k, j, i)) /
-                                    (thermal_diff_coeff * fabs(Bx) / Bmag * costheta +
-                                     TINY_NUMBER));
-          if (ndim >= 2) {
-            min_dt = fmin(min_dt, SQR(coords.Dxc<2>(k, j, i)) /
-                                      (thermal_diff_coeff * fabs(By) / Bmag * costheta +
-                                       TINY_NUMBER));
-          }
-          if (ndim >= 3) {
-            min_dt = fmin(min_dt, SQR(coords.Dxc<3>(k, j, i)) /
-                                      (thermal_diff_coeff * fabs(Bz) / Bmag * costheta +
-                                       TINY_NUMBER));
+            lmin = cell;
           }
         },
-        Kokkos::Min<Real>(min_dt_cond));
+        Kokkos::Min<ConductionDtCell>(min_cell));
+    min_dt_cond = min_cell.dt;
+
+    // Record the cell limiting the timestep on this rank (for diagnostics)
+    if (dt_diagnostics && min_dt_cond < std::numeric_limits<Real>::max()) {
+      const auto &cfl_diff = hydro_pkg->Param<Real>("cfl_diff");
+      auto limiter = hydro_pkg->Param<ConductionDtLimiter>("conduction_dt_limiter_local");
+      if (cfl_diff * fac * min_dt_cond < limiter.dt) {
+        auto idx = min_cell.loc;
+        const int i = idx % ni;
+        idx /= ni;
+        const int j = idx % nj;
+        idx /= nj;
+        const int k = idx % nk;
+        const int b = idx / nk;
+
+        auto pmb = md->GetBlockData(b)->GetBlockPointer();
+        limiter.dt = cfl_diff * fac * min_dt_cond;
+        limiter.x1 = pmb->coords.Xc<1>(i);
+        limiter.x2 = pmb->coords.Xc<2>(j);
+        limiter.x3 = pmb->coords.Xc<3>(k);
+        limiter.rho = min_cell.rho;
+        limiter.T = min_cell.p / min_cell.rho;
+        if (hydro_pkg->AllParams().hasKey("mbar_over_kb")) {
+          limiter.T *= hydro_pkg->Param<Real>("mbar_over_kb");
+        }
+        limiter.diff = min_cell.diff;
+        limiter.sat_ratio = min_cell.sat_ratio;
+        limiter.gid = pmb->gid;
+        hydro_pkg->UpdateParam("conduction_dt_limiter_local", limiter);
+      }
+    }
   }
   const auto &cfl_diff = hydro_pkg->Param<Real>("cfl_diff");
   return cfl_diff * fac * min_dt_cond;
 }
 
+// Only isotropic conduction with a fixed coefficient is supported by the fused STS stage
+// (see STSStepOtherFused), which calculates the fluxes of each face for both adjacent
+// cells.
+Real GetThermalDiffCoeffIsoFixed(StateDescriptor *hydro_pkg) {
+  const auto &thermal_diff = hydro_pkg->Param<ThermalDiffusivity>("thermal_diff");
+  PARTHENON_REQUIRE(thermal_diff.GetType() == Conduction::isotropic &&
+                        thermal_diff.GetCoeffType() == ConductionCoeff::fixed,
+                    "Thermal diffusivity is not isotropic with fixed coefficient.");
+  // Using 0.0 as parameters rho and p as they're not used anyway for a fixed coeff.
+  return thermal_diff.Get(0.0, 0.0);
+}
+
 //---------------------------------------------------------------------------------------
 //! Calculate isotropic thermal conduction with fixed coefficient
 
@@ -212,11 +319,8 @@ void ThermalFluxIsoFixed(MeshData<Real> *md) {
         const auto &coords = prim_pack.GetCoords(b);
         auto &cons = cons_pack(b);
         const auto &prim = prim_pack(b);
-        const auto T_i = prim(IPR, k, j, i) / prim(IDN, k, j, i);
-        const auto T_im1 = prim(IPR, k, j, i - 1) / prim(IDN, k, j, i - 1);
-        const auto dTdx = (T_i - T_im1) / coords.Dxc<1>(k, j, i);
-        const auto denf = 0.5 * (prim(IDN, k, j, i) + prim(IDN, k, j, i - 1));
-        cons.flux(X1DIR, IEN, k, j, i) -= thermal_diff_coeff * denf * dTdx;
+        cons.flux(X1DIR, IEN, k, j, i) +=
+            ThermalFluxIsoFixedFace<X1DIR>(prim, coords, thermal_diff_coeff, k, j, i);
       });
 
   if (ndim < 2) {
@@ -230,12 +334,8 @@ void ThermalFluxIsoFixed(MeshData<Real> *md) {
         const auto &coords = prim_pack.GetCoords(b);
         auto &cons = cons_pack(b);
         const auto &prim = prim_pack(b);
-
-        const auto T_j = prim(IPR, k, j, i) / prim(IDN, k, j, i);
-        const auto T_jm1 = prim(IPR, k, j - 1, i) / prim(IDN, k, j - 1, i);
-        const auto dTdy = (T_j - T_jm1) / coords.Dxc<2>(k, j, i);
-        const auto denf = 0.5 * (prim(IDN, k, j, i) + prim(IDN, k, j - 1, i));
-        cons.flux(X2DIR, IEN, k, j, i) -= thermal_diff_coeff * denf * dTdy;
+        cons.flux(X2DIR, IEN, k, j, i) +=
+            ThermalFluxIsoFixedFace<X2DIR>(prim, coords, thermal_diff_coeff, k, j, i);
       });
   /* Compute heat fluxes in 3-direction, 3D problem ONLY  ---------------------*/
   if (ndim < 3) {
@@ -249,12 +349,8 @@ void ThermalFluxIsoFixed(MeshData<Real> *md) {
         const auto &coords = prim_pack.GetCoords(b);
         auto &cons = cons_pack(b);
         const auto &prim = prim_pack(b);
-
-        const auto T_k = prim(IPR, k, j, i) / prim(IDN, k, j, i);
-        const auto T_km1 = prim(IPR, k - 1, j, i) / prim(IDN, k - 1, j, i);
-        const auto dTdz = (T_k - T_km1) / coords.Dxc<3>(k, j, i);
-        const auto denf = 0.5 * (prim(IDN, k, j, i) + prim(IDN, k - 1, j, i));
-        cons.flux(X3DIR, IEN, k, j, i) -= thermal_diff_coeff * denf * dTdz;
+        cons.flux(X3DIR, IEN, k, j, i) +=
+            ThermalFluxIsoFixedFace<X3DIR>(prim, coords, thermal_diff_coeff, k, j, i);
       });
 }
 
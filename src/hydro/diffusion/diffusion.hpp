@@ -9,6 +9,9 @@
 #ifndef HYDRO_DIFFUSION_DIFFUSION_HPP_
 #define HYDRO_DIFFUSION_DIFFUSION_HPP_
 
+// C++ headers
+#include <limits>
+
 // Parthenon headers
 #include <parthenon/package.hpp>
 
@@ -74,13 +77,15 @@ struct ThermalDiffusivity {
   ConductionCoeff conduction_coeff_type_;
   // "free" coefficient/prefactor. Value depends on conduction is set in the constructor.
   Real coeff_;
+  // Upper limit of the (Spitzer) diffusivity (no limit if <= 0)
+  Real max_diff_;
 
  public:
   KOKKOS_INLINE_FUNCTION
   ThermalDiffusivity(Conduction conduction, ConductionCoeff conduction_coeff_type,
-                     Real coeff, Real mbar, Real me, Real kb)
+                     Real coeff, Real mbar, Real me, Real kb, Real max_diff = 0.0)
       : conduction_(conduction), conduction_coeff_type_(conduction_coeff_type),
-        coeff_(coeff), mbar_(mbar), me_(me), kb_(kb) {}
+        coeff_(coeff), mbar_(mbar), me_(me), kb_(kb), max_diff_(max_diff) {}
 
   KOKKOS_INLINE_FUNCTION
   Real Get(const Real pres, const Real rho) const;
@@ -94,6 +99,37 @@ struct ThermalDiffusivity {
 
 Real EstimateConductionTimestep(MeshData<Real> *md);
 
+//! Cell limiting the conduction timestep (with varying coefficient), see
+//! diffusion/conduction_dt_diagnostics
+struct ConductionDtLimiter {
+  Real dt = std::numeric_limits<Real>::max();
+  Real x1 = 0.0, x2 = 0.0, x3 = 0.0;
+  Real rho = 0.0;
+  Real T = 0.0;          // in K if units are set, otherwise p/rho
+  Real diff = 0.0;       // thermal diffusivity
+  Real sat_ratio = 0.0;  // ratio of classic to saturated flux
+  Real gid = -1.0;       // global id of the block
+};
+
+//! Coefficient of isotropic thermal conduction with fixed coefficient
+Real GetThermalDiffCoeffIsoFixed(StateDescriptor *hydro_pkg);
+//! Isotropic thermal conduction flux with fixed coefficient `thermal_diff_coeff` through
+//! the lower XNDIR face of cell k,j,i
+template <int XNDIR, typename Prim, typename Coords>
+KOKKOS_FORCEINLINE_FUNCTION Real
+ThermalFluxIsoFixedFace(const Prim &prim, const Coords &coords,
+                        const Real thermal_diff_coeff, const int k, const int j,
+                        const int i) {
+  constexpr int dk = XNDIR == X3DIR ? 1 : 0;
+  constexpr int dj = XNDIR == X2DIR ? 1 : 0;
+  constexpr int di = XNDIR == X1DIR ? 1 : 0;
+  const auto T = prim(IPR, k, j, i) / prim(IDN, k, j, i);
+  const auto T_m1 = prim(IPR, k - dk, j - dj, i - di) / prim(IDN, k - dk, j - dj, i - di);
+  const auto dTdx = (T - T_m1) / coords.template Dxc<XNDIR>(k, j, i);
+  const auto denf = 0.5 * (prim(IDN, k, j, i) + prim(IDN, k - dk, j - dj, i - di));
+  return -thermal_diff_coeff * denf * dTdx;
+}
+
 //! Calculate isotropic thermal conduction with fixed coefficient
 void ThermalFluxIsoFixed(MeshData<Real> *md);
 //! Calculate thermal conduction (general case incl. anisotropic and saturated)
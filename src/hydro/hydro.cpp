@@ -5,9 +5,14 @@
 //========================================================================================
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
 #include <limits>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 // Parthenon headers
@@ -30,10 +35,16 @@
 #include "diffusion/diffusion.hpp"
 #include "glmmhd/glmmhd.hpp"
 #include "hydro.hpp"
+#include "hydro/flux_functions.hpp"
 #include "interface/params.hpp"
+#ifdef ATHENAPK_MIXED_PRECISION
+#include "mixed_precision.hpp"
+#endif
 #include "outputs/outputs.hpp"
 #include "prolongation/custom_ops.hpp"
 #include "rsolvers/rsolvers.hpp"
+#include "step_reductions.hpp"
+#include "task_timers.hpp"
 #include "srcterms/tabular_cooling.hpp"
 #include "utils/error_checking.hpp"
 
@@ -51,18 +62,40 @@ namespace Hydro {
 using cooling::TabularCooling;
 using parthenon::HistoryOutputVar;
 
+namespace {
+// Members of the cell limiting the conduction timestep with their labels (used for the
+// history output and, prefixed by "conduction_dt_limiter/", for the params of the
+// global reduction). The timestep needs to come first as it's the reduced quantity.
+using LimiterMember_t = Real ConductionDtLimiter::*;
+const std::vector<std::pair<LimiterMember_t, std::string>> conduction_dt_limiter_members =
+    {{&ConductionDtLimiter::dt, "dt_cond"},
+     {&ConductionDtLimiter::x1, "dt_cond_x1"},
+     {&ConductionDtLimiter::x2, "dt_cond_x2"},
+     {&ConductionDtLimiter::x3, "dt_cond_x3"},
+     {&ConductionDtLimiter::rho, "dt_cond_rho"},
+     {&ConductionDtLimiter::T, "dt_cond_T"},
+     {&ConductionDtLimiter::diff, "dt_cond_diff"},
+     {&ConductionDtLimiter::sat_ratio, "dt_cond_sat_ratio"},
+     {&ConductionDtLimiter::gid, "dt_cond_gid"}};
+} // namespace
+
 parthenon::Packages_t ProcessPackages(std::unique_ptr<ParameterInput> &pin) {
   parthenon::Packages_t packages;
   packages.Add(Hydro::Initialize(pin.get()));
   return packages;
 }
 
-// Using this per cycle function to populate various variables in
-// Params that require global reduction *and* need to be set/known when
-// the task list is constructed (versus when the task list is being executed).
-// TODO(next person touching this function): If more/separate feature are required
-// please separate concerns.
-void PreStepMeshUserWorkInLoop(Mesh *pmesh, ParameterInput *pin, SimTime &tm) {}
+// Called at the beginning of each cycle, i.e., in between cycles on all ranks.
+// Separate features register their work as separate functions in the "pre_step_funs"
+// param (in the order of registration during initialization) instead of adding it here.
+// Global reductions required for constructing the task list should be added to the
+// "step_reductions" instead, see `step_reductions.hpp`.
+void PreStepMeshUserWorkInLoop(Mesh *pmesh, ParameterInput *pin, SimTime &tm) {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  for (const auto &fun : hydro_pkg->Param<std::vector<PreStepFun_t>>("pre_step_funs")) {
+    fun(pmesh, tm);
+  }
+}
 
 template <Hst hst, int idx = -1>
 Real HydroHst(MeshData<Real> *md) {
@@ -139,6 +172,102 @@ void ConsToPrim(MeshData<Real> *md) {
   eos.ConservedToPrimitive(md);
 }
 
+// Convert conserved to primitive variables in the ghost zones only, i.e., after the
+// ghost zones of the conserved variables have been updated but the interior primitive
+// variables are already up to date.
+// The ghost zones are covered by (up to) three disjoint sets of slabs: the x3-slabs
+// spanning the entire x1-x2-plane, the x2-slabs within the interior x3-range, and the
+// x1-slabs within the interior x2-x3-range.
+template <class T>
+TaskStatus ConsToPrimGhosts(MeshData<Real> *md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto pkg = pmb->packages.Get("Hydro");
+  const auto &eos = pkg->Param<T>("eos");
+  const auto nhydro = pkg->Param<int>("nhydro");
+  const auto nscalars = pkg->Param<int>("nscalars");
+
+  auto const cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  auto prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+#ifdef ATHENAPK_MIXED_PRECISION
+  auto prim_sp_pack = md->PackVariables(std::vector<std::string>{"prim_sp"});
+#endif
+  const auto ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  const auto jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  const auto kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  const auto ib_e = pmb->cellbounds.GetBoundsI(IndexDomain::entire);
+  const auto jb_e = pmb->cellbounds.GetBoundsJ(IndexDomain::entire);
+  const auto kb_e = pmb->cellbounds.GetBoundsK(IndexDomain::entire);
+  const int ndim = pmb->pmy_mesh->ndim;
+
+  if (ndim >= 3) {
+    const int ng = kb.s - kb_e.s;
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "ConsToPrimGhosts x3", parthenon::DevExecSpace(), 0,
+        cons_pack.GetDim(5) - 1, 0, 2 * ng - 1, jb_e.s, jb_e.e, ib_e.s, ib_e.e,
+        KOKKOS_LAMBDA(const int b, const int kg, const int j, const int i) {
+          const int k = kg < ng ? kb_e.s + kg : kb.e + 1 + kg - ng;
+          const auto &cons = cons_pack(b);
+          auto &prim = prim_pack(b);
+          eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+#ifdef ATHENAPK_MIXED_PRECISION
+          StorePrimSP(prim, prim_sp_pack(b), nhydro + nscalars, k, j, i);
+#endif
+        });
+  }
+  if (ndim >= 2) {
+    const int ng = jb.s - jb_e.s;
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "ConsToPrimGhosts x2", parthenon::DevExecSpace(), 0,
+        cons_pack.GetDim(5) - 1, kb.s, kb.e, 0, 2 * ng - 1, ib_e.s, ib_e.e,
+        KOKKOS_LAMBDA(const int b, const int k, const int jg, const int i) {
+          const int j = jg < ng ? jb_e.s + jg : jb.e + 1 + jg - ng;
+          const auto &cons = cons_pack(b);
+          auto &prim = prim_pack(b);
+          eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+#ifdef ATHENAPK_MIXED_PRECISION
+          StorePrimSP(prim, prim_sp_pack(b), nhydro + nscalars, k, j, i);
+#endif
+        });
+  }
+  const int ng = ib.s - ib_e.s;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "ConsToPrimGhosts x1", parthenon::DevExecSpace(), 0,
+      cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, 0, 2 * ng - 1,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int ig) {
+        const int i = ig < ng ? ib_e.s + ig : ib.e + 1 + ig - ng;
+        const auto &cons = cons_pack(b);
+        auto &prim = prim_pack(b);
+        eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+#ifdef ATHENAPK_MIXED_PRECISION
+        StorePrimSP(prim, prim_sp_pack(b), nhydro + nscalars, k, j, i);
+#endif
+      });
+  return TaskStatus::complete;
+}
+
+#ifdef ATHENAPK_MIXED_PRECISION
+// Update the single precision copy of `prim` (in all cells) after `prim` has been
+// modified outside of the conversion from conserved to primitive variables.
+void StorePrimSP(MeshData<Real> *md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto pkg = pmb->packages.Get("Hydro");
+  const auto nprim = pkg->Param<int>("nhydro") + pkg->Param<int>("nscalars");
+
+  auto const prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  auto prim_sp_pack = md->PackVariables(std::vector<std::string>{"prim_sp"});
+  const auto ib = pmb->cellbounds.GetBoundsI(IndexDomain::entire);
+  const auto jb = pmb->cellbounds.GetBoundsJ(IndexDomain::entire);
+  const auto kb = pmb->cellbounds.GetBoundsK(IndexDomain::entire);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "StorePrimSP", parthenon::DevExecSpace(), 0,
+      prim_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        StorePrimSP(prim_pack(b), prim_sp_pack(b), nprim, k, j, i);
+      });
+}
+#endif
+
 // Add unsplit sources, i.e., source that are integrated in all stages of the
 // explicit integration scheme.
 // Note 1: Given that the sources are integrated in an unsplit manner, ensure
@@ -158,7 +287,7 @@ TaskStatus AddUnsplitSources(MeshData<Real> *md, const SimTime &tm, const Real b
     const TabularCooling &tabular_cooling =
         hydro_pkg->Param<TabularCooling>("tabular_cooling");
 
-    tabular_cooling.SrcTerm(md, beta_dt);
+    tabular_cooling.SrcTerm(md, beta_dt, tm);
   }
   if (ProblemSourceUnsplit != nullptr) {
     ProblemSourceUnsplit(md, tm, beta_dt);
@@ -179,6 +308,11 @@ TaskStatus AddSplitSourcesFirstOrder(MeshData<Real> *md, const SimTime &tm) {
 TaskStatus AddSplitSourcesStrang(MeshData<Real> *md, const SimTime &tm) {
   if (ProblemSourceStrangSplit != nullptr) {
     ProblemSourceStrangSplit(md, tm, tm.dt);
+#ifdef ATHENAPK_MIXED_PRECISION
+    // Strang split sources also update `prim` (see hydro_driver.cpp), which are used
+    // in the following flux calculation.
+    StorePrimSP(md);
+#endif
   }
   return TaskStatus::complete;
 }
@@ -189,6 +323,9 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   Real cfl = pin->GetOrAddReal("parthenon/time", "cfl", 0.3);
   pkg->AddParam<>("cfl", cfl);
 
+  // Work at the beginning of each cycle, see PreStepMeshUserWorkInLoop
+  pkg->AddParam<>("pre_step_funs", std::vector<PreStepFun_t>(), true);
+
   bool pack_in_one = pin->GetOrAddBoolean("parthenon/mesh", "pack_in_one", true);
   pkg->AddParam<>("pack_in_one", pack_in_one);
 
@@ -261,6 +398,28 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   }
   // Adding recon independently of flux function pointer as it's used in 3D flux func.
   pkg->AddParam<>("reconstruction", recon);
+  pkg->AddParam<>("recon_need_nghost", recon_need_nghost);
+
+  // Kernel used to calculate the hyperbolic fluxes.
+  // "pencil" uses one sweep per direction over cached pencils in i-dir.
+  // "fused" loads a k-j tile (incl. halo) of prims once into scratch and calculates the
+  // fluxes in all directions from that tile.
+  const auto flux_kernel_str = pin->GetOrAddString("hydro", "flux_kernel", "pencil");
+  auto flux_kernel = FluxKernel::undefined;
+  if (flux_kernel_str == "pencil") {
+    flux_kernel = FluxKernel::pencil;
+  } else if (flux_kernel_str == "fused") {
+    flux_kernel = FluxKernel::fused;
+    const auto flux_tile_nk = pin->GetOrAddInteger("hydro", "flux_tile_nk", 8);
+    const auto flux_tile_nj = pin->GetOrAddInteger("hydro", "flux_tile_nj", 8);
+    PARTHENON_REQUIRE(flux_tile_nk > 0 && flux_tile_nj > 0,
+                      "hydro/flux_tile_nk and hydro/flux_tile_nj need to be > 0.");
+    pkg->AddParam<>("flux_tile_nk", flux_tile_nk);
+    pkg->AddParam<>("flux_tile_nj", flux_tile_nj);
+  } else {
+    PARTHENON_FAIL("AthenaPK hydro: Unknown flux kernel. Options are: pencil, fused");
+  }
+  pkg->AddParam<>("flux_kernel", flux_kernel);
 
   // Use hyperbolic timestep constraint by default
   bool calc_dt_hyp = true;
@@ -299,47 +458,44 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   const auto max_dt = pin->GetOrAddReal("hydro", "max_dt", -1.0);
   pkg->AddParam<>("max_dt", max_dt);
 
-  // Map contaning all compiled in flux functions
-  std::map<std::tuple<Fluid, Reconstruction, RiemannSolver>, FluxFun_t *>
-      flux_functions{};
-  // TODO(?) The following line could potentially be set by configure-time options
-  // so that the resulting binary can only contain a subset of included flux functions
-  // to reduce size.
-  add_flux_fun<Fluid::euler, Reconstruction::dc, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::dc, RiemannSolver::none>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::plm, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::ppm, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::weno3, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::limo3, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::wenoz, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::dc, RiemannSolver::hllc>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::plm, RiemannSolver::hllc>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::ppm, RiemannSolver::hllc>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::weno3, RiemannSolver::hllc>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::limo3, RiemannSolver::hllc>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::wenoz, RiemannSolver::hllc>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::dc, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::dc, RiemannSolver::none>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::plm, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::ppm, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::weno3, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::limo3, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::wenoz, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::dc, RiemannSolver::hlld>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::plm, RiemannSolver::hlld>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::ppm, RiemannSolver::hlld>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::weno3, RiemannSolver::hlld>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::limo3, RiemannSolver::hlld>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::wenoz, RiemannSolver::hlld>(flux_functions);
-  // Add first order recon with LLF fluxes (implemented for testing as tight loop)
-  flux_functions[std::make_tuple(Fluid::euler, Reconstruction::dc, RiemannSolver::llf)] =
-      Hydro::CalculateFluxesTight<Fluid::euler>;
-  flux_functions[std::make_tuple(Fluid::glmmhd, Reconstruction::dc, RiemannSolver::llf)] =
-      Hydro::CalculateFluxesTight<Fluid::glmmhd>;
+  // Map contaning all compiled in flux functions, which are selected at configure time
+  // by the AthenaPK_FLUX_FUNCTIONS CMake option.
+  std::map<FluxFunKey_t, FluxFuns> flux_functions{};
+  AddCompiledFluxFunctions(flux_functions);
+  auto get_flux_funs = [&](const Fluid fluid, const Reconstruction recon,
+                           const RiemannSolver riemann, const std::string &recon_str) {
+    const auto it = flux_functions.find(std::make_tuple(fluid, recon, riemann));
+    if (it == flux_functions.end()) {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in AthenaPK hydro: Flux function \"" << fluid_str << ":"
+          << recon_str << ":" << riemann_str << "\" not compiled in." << std::endl
+          << "Compiled in are: " << compiled_flux_functions << std::endl
+          << "Reconfigure with the combination added to AthenaPK_FLUX_FUNCTIONS."
+          << std::endl;
+      PARTHENON_FAIL(msg);
+    }
+    return it->second;
+  };
 
   // flux used in all stages expect the first. First stage is set below based on integr.
-  FluxFun_t *flux_other_stage = nullptr;
-  flux_other_stage = flux_functions.at(std::make_tuple(fluid, recon, riemann));
+  const auto flux_funs = get_flux_funs(fluid, recon, riemann, recon_str);
+  FluxFun_t *flux_other_stage = flux_funs.all;
+
+  // Overlap the flux calculation with the ghost zone exchange.
+  // If enabled, the ghost zone exchange at the end of all but the last stage only sends
+  // the boundary buffers. The following stage then calculates the fluxes of all faces
+  // whose stencil does not touch ghost zones while the buffers are in flight and the
+  // remaining fluxes once the ghost zones have been received.
+  const auto overlap_flux_comm =
+      pin->GetOrAddBoolean("hydro", "overlap_flux_comm", false);
+  pkg->AddParam<>("overlap_flux_comm", overlap_flux_comm);
+  if (overlap_flux_comm) {
+    PARTHENON_REQUIRE(flux_funs.interior != nullptr && flux_funs.shell != nullptr,
+                      "hydro/overlap_flux_comm is not supported by the chosen "
+                      "reconstruction and Riemann solver combination.");
+    pkg->AddParam<FluxFun_t *>("flux_interior", flux_funs.interior);
+    pkg->AddParam<FluxFun_t *>("flux_shell", flux_funs.shell);
+  }
 
   parthenon::HstVar_list hst_vars = {};
   hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
@@ -381,8 +537,7 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   } else if (integrator_str == "vl2") {
     integrator = Integrator::vl2;
     // override first stage (predictor) to first order
-    flux_first_stage =
-        flux_functions.at(std::make_tuple(fluid, Reconstruction::dc, riemann));
+    flux_first_stage = get_flux_funs(fluid, Reconstruction::dc, riemann, "dc").all;
   }
   pkg->AddParam<>("integrator", integrator);
   pkg->AddParam<FluxFun_t *>("flux_first_stage", flux_first_stage);
@@ -399,6 +554,49 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
       pkg->AddParam<FirstOrderFluxCorrectFun_t *>("first_order_flux_correct_fun",
                                                   FirstOrderFluxCorrect<Fluid::glmmhd>);
     }
+    // One set of buffers per partition, resized by the driver
+    pkg->AddParam<>("first_order_flux_correct_buffers",
+                    std::vector<FirstOrderFluxCorrectBuffers>(), true);
+  }
+
+  // Counters of the floor, ceiling, and first order flux correction events (see
+  // FloorEvent) on this rank since the beginning of the simulation.
+  // If enabled, the events are counted by a reduction fused into the existing kernels and
+  // the reduced counts are added to these host counters.
+  auto floor_event_counters =
+      pin->GetOrAddBoolean("hydro", "floor_event_counters", false);
+  pkg->AddParam<>("floor_event_counters", floor_event_counters);
+  pkg->AddParam<>("floor_event_counts",
+                  FloorEventCountsHost("floor_event_counts",
+                                       static_cast<int>(FloorEvent::num)));
+  if (floor_event_counters) {
+    const std::vector<std::pair<FloorEvent, std::string>> event_hst = {
+        {FloorEvent::density_floor, "floor_dens"},
+        {FloorEvent::velocity_ceiling, "ceil_vel"},
+        {FloorEvent::pressure_floor, "floor_pres"},
+        {FloorEvent::temperature_floor, "floor_temp"},
+        {FloorEvent::temperature_ceiling, "ceil_temp"},
+        {FloorEvent::fofc_corrected, "fofc_corrected"},
+        {FloorEvent::fofc_need_floor, "fofc_need_floor"}};
+    auto hst_vars = pkg->Param<parthenon::HstVar_list>(parthenon::hist_param_key);
+    for (const auto &[event, label] : event_hst) {
+      hst_vars.emplace_back(HistoryOutputVar(
+          parthenon::UserHistoryOperation::sum,
+          [event = event](MeshData<Real> *md) {
+            // The counters cover all partitions of this rank, so they're only reported
+            // for the partition containing the first block of this rank.
+            auto pmb = md->GetBlockData(0)->GetBlockPointer();
+            if (pmb->gid != pmb->pmy_mesh->block_list.front()->gid) {
+              return 0.0;
+            }
+            const auto &counts =
+                pmb->packages.Get("Hydro")->Param<FloorEventCountsHost>(
+                    "floor_event_counts");
+            return static_cast<Real>(counts(static_cast<int>(event)));
+          },
+          label));
+    }
+    pkg->UpdateParam(parthenon::hist_param_key, hst_vars);
   }
 
   if (pin->DoesBlockExist("units")) {
@@ -497,10 +695,15 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
         auto units = pkg->Param<Units>("units");
         spitzer_coeff *= units.erg() / (units.s() * units.cm());
 
+        // Optional upper limit of the diffusivity (in code units) to prevent a few hot,
+        // low density cells from dictating the timestep (or number of STS stages).
+        const auto max_diff =
+            pin->GetOrAddReal("diffusion", "conduction_max_diff_code", 0.0);
+
         const auto mbar = pkg->Param<Real>("mbar");
         auto thermal_diff =
             ThermalDiffusivity(conduction, conduction_coeff, spitzer_coeff, mbar,
-                               units.electron_mass(), units.k_boltzmann());
+                               units.electron_mass(), units.k_boltzmann(), max_diff);
         pkg->AddParam<>("thermal_diff", thermal_diff);
 
         const auto mu = pkg->Param<Real>("mu");
@@ -595,13 +798,80 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
     auto diffint = DiffInt::none;
     if (diffint_str == "unsplit") {
       diffint = DiffInt::unsplit;
-    } else if (diffint_str == "rkl2") {
-      diffint = DiffInt::rkl2;
+    } else if (diffint_str == "rkl1" || diffint_str == "rkl2" || diffint_str == "rkg2") {
+      diffint = diffint_str == "rkl1"   ? DiffInt::rkl1
+                : diffint_str == "rkl2" ? DiffInt::rkl2
+                                        : DiffInt::rkg2;
       auto rkl2_dt_ratio = pin->GetOrAddReal("diffusion", "rkl2_max_dt_ratio", -1.0);
       pkg->AddParam<>("rkl2_max_dt_ratio", rkl2_dt_ratio);
+
+      // Conserved variables updated by the enabled diffusion processes. Only these are
+      // integrated (and stored in the additional registers) by the STS integrators.
+      std::vector<int> sts_vars;
+      if (viscosity != Viscosity::none) {
+        sts_vars.insert(sts_vars.end(), {IM1, IM2, IM3});
+      }
+      if (conduction != Conduction::none || viscosity != Viscosity::none ||
+          resistivity != Resistivity::none) {
+        sts_vars.push_back(IEN);
+      }
+      if (resistivity != Resistivity::none) {
+        sts_vars.insert(sts_vars.end(), {IB1, IB2, IB3});
+      }
+      PARTHENON_REQUIRE_THROWS(!sts_vars.empty(),
+                               "The STS integrators require at least one enabled "
+                               "diffusion process.");
+      const int num_sts_vars = static_cast<int>(sts_vars.size());
+      parthenon::ParArray1D<int> sts_vars_d("sts_vars", num_sts_vars);
+      auto sts_vars_h = Kokkos::create_mirror_view(sts_vars_d);
+      for (int l = 0; l < num_sts_vars; l++) {
+        sts_vars_h(l) = sts_vars[l];
+      }
+      Kokkos::deep_copy(sts_vars_d, sts_vars_h);
+      pkg->AddParam<>("sts_vars", sts_vars_d);
+
+      // Register Y_{j-2} of the STS recursion for the subset of variables above. The
+      // other registers are stored in (the otherwise unused parts of) "u1", see
+      // AddSTSTasks.
+      pkg->AddField("sts_Yjm2", Metadata({Metadata::Cell, Metadata::Derived,
+                                          Metadata::OneCopy},
+                                         std::vector<int>({num_sts_vars})));
+
+      // Record the cell limiting the conduction timestep (and thus the number of stages)
+      if (pin->GetOrAddBoolean("diffusion", "conduction_dt_diagnostics", false)) {
+        PARTHENON_REQUIRE_THROWS(
+            conduction != Conduction::none &&
+                !(conduction == Conduction::isotropic &&
+                  pkg->Param<ThermalDiffusivity>("thermal_diff").GetCoeffType() ==
+                      ConductionCoeff::fixed),
+            "diffusion/conduction_dt_diagnostics requires anisotropic conduction or a "
+            "varying coefficient (otherwise the smallest cells limit the timestep).");
+        // Limiter on this rank (updated in EstimateConductionTimestep) and global one
+        // (reduced in the step reductions below)
+        pkg->AddParam<>("conduction_dt_limiter_local", ConductionDtLimiter(), true);
+        pkg->AddParam<>("conduction_dt_limiter", ConductionDtLimiter(), true);
+        for (const auto &[member, label] : conduction_dt_limiter_members) {
+          pkg->AddParam<Real>("conduction_dt_limiter/" + label, 0.0, true);
+        }
+
+        // Global limiter is identical on all ranks so any (non-sum) reduction works
+        auto hst_vars = pkg->Param<parthenon::HstVar_list>(parthenon::hist_param_key);
+        for (const auto &[member, label] : conduction_dt_limiter_members) {
+          hst_vars.emplace_back(HistoryOutputVar(
+              parthenon::UserHistoryOperation::max,
+              [member = member](MeshData<Real> *md) {
+                auto hydro_pkg =
+                    md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+                return hydro_pkg->Param<ConductionDtLimiter>("conduction_dt_limiter").*
+                       member;
+              },
+              label));
+        }
+        pkg->UpdateParam(parthenon::hist_param_key, hst_vars);
+      }
     } else if (diffint_str != "none") {
       PARTHENON_FAIL("AthenaPK unknown integration method for diffusion processes. "
-                     "Options are: none, unsplit, rkl2");
+                     "Options are: none, unsplit, rkl1, rkl2, rkg2");
     }
     if (diffint != DiffInt::none) {
       // As in Athena++ a cfl safety factor is also applied to the theoretical limit.
@@ -617,11 +887,15 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
       AdiabaticHydroEOS eos(pfloor, dfloor, efloor, vceil, eceil, gamma);
       pkg->AddParam<>("eos", eos);
       pkg->FillDerivedMesh = ConsToPrim<AdiabaticHydroEOS>;
+      pkg->AddParam<ConsToPrimGhostsFun_t *>("cons_to_prim_ghosts_fun",
+                                             ConsToPrimGhosts<AdiabaticHydroEOS>);
       pkg->EstimateTimestepMesh = EstimateTimestep<Fluid::euler>;
     } else if (fluid == Fluid::glmmhd) {
       AdiabaticGLMMHDEOS eos(pfloor, dfloor, efloor, vceil, eceil, gamma);
       pkg->AddParam<>("eos", eos);
       pkg->FillDerivedMesh = ConsToPrim<AdiabaticGLMMHDEOS>;
+      pkg->AddParam<ConsToPrimGhostsFun_t *>("cons_to_prim_ghosts_fun",
+                                             ConsToPrimGhosts<AdiabaticGLMMHDEOS>);
       pkg->EstimateTimestepMesh = EstimateTimestep<Fluid::glmmhd>;
     }
   } else {
@@ -647,6 +921,18 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   if (cooling == Cooling::tabular) {
     TabularCooling tabular_cooling(pin, pkg);
     pkg->AddParam<>("tabular_cooling", tabular_cooling);
+    if (pkg->AllParams().hasKey("cooling_subcycles")) {
+      // Reset the running counts of the cooling subcycles so that the history output
+      // contains the counts of the last cycle, see `TabularCooling`
+      pkg->MutableParam<std::vector<PreStepFun_t>>("pre_step_funs")
+          ->push_back([](Mesh *pmesh, const SimTime &) {
+            auto hydro_pkg = pmesh->packages.Get("Hydro");
+            Kokkos::deep_copy(DevExecSpace(),
+                              hydro_pkg->Param<ParArray1D<Real>>("cooling_subcycles"),
+                              0.0);
+            hydro_pkg->UpdateParam("cooling_cell_updates", 0.0);
+          });
+    }
   }
 
   auto scratch_level = pin->GetOrAddInteger("hydro", "scratch_level", 0);
@@ -697,6 +983,15 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
                prim_labels);
   pkg->AddField("prim", m);
 
+#ifdef ATHENAPK_MIXED_PRECISION
+  // Single precision copy of `prim` used as input to the flux calculation, see
+  // mixed_precision.hpp. It is only updated together with `prim` of the "base"
+  // register, so a single copy is shared by all registers.
+  m = Metadata({Metadata::Cell, Metadata::Derived, Metadata::OneCopy},
+               std::vector<int>({NumPrimSPComponents(nhydro + nscalars)}));
+  pkg->AddField("prim_sp", m);
+#endif
+
   const auto refine_str = pin->GetOrAddString("refinement", "type", "unset");
   if (refine_str == "pressure_gradient") {
     pkg->CheckRefinementBlock = refinement::gradient::PressureGradient;
@@ -730,10 +1025,81 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
     pkg->CheckRefinementBlock = Hydro::ProblemCheckRefinementBlock;
   }
 
+  // Global reductions at the beginning of each cycle. Problem generators may register
+  // additional quantities (in `ProblemInitPackageData`), see `step_reductions.hpp`.
+  StepReductions step_reductions;
+  if (calc_c_h || pkg->Param<DiffInt>("diffint") != DiffInt::none) {
+    // Minimum dx and timestep constraints used to calculate the divergence cleaning speed
+    step_reductions.AddQuantity("mindx", ReductionOp::min);
+    step_reductions.AddQuantity("dt_hyp", ReductionOp::min);
+    step_reductions.AddQuantity("dt_diff", ReductionOp::min);
+    step_reductions.AddLocalReduction(
+        [](MeshData<Real> *md, const SimTime &) { return CalculateGlobalMinDx(md); });
+    step_reductions.AddFinalize(
+        [](StateDescriptor *hydro_pkg, const SimTime &) {
+          return UpdateDivCleaningSpeed(hydro_pkg);
+        });
+  }
+  if (pkg->AllParams().hasKey("conduction_dt_limiter")) {
+    // Cell limiting the conduction timestep (recorded in the last
+    // EstimateConductionTimestep call), i.e., the one limiting the number of STS stages
+    std::vector<std::string> param_names;
+    for (const auto &[member, label] : conduction_dt_limiter_members) {
+      param_names.push_back("conduction_dt_limiter/" + label);
+    }
+    step_reductions.AddMinLocQuantities(param_names);
+    // Same data for all partitions so it's fine to copy it once per partition
+    step_reductions.AddLocalReduction([](MeshData<Real> *md, const SimTime &) {
+      auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+      const auto &limiter =
+          hydro_pkg->Param<ConductionDtLimiter>("conduction_dt_limiter_local");
+      for (const auto &[member, label] : conduction_dt_limiter_members) {
+        hydro_pkg->UpdateParam("conduction_dt_limiter/" + label, limiter.*member);
+      }
+      return TaskStatus::complete;
+    });
+    step_reductions.AddFinalize([](StateDescriptor *hydro_pkg, const SimTime &) {
+      ConductionDtLimiter limiter;
+      for (const auto &[member, label] : conduction_dt_limiter_members) {
+        limiter.*member = hydro_pkg->Param<Real>("conduction_dt_limiter/" + label);
+      }
+      hydro_pkg->UpdateParam("conduction_dt_limiter", limiter);
+      if (parthenon::Globals::my_rank == 0) {
+        std::cout << "Conduction timestep " << limiter.dt << " limited by cell at ("
+                  << limiter.x1 << ", " << limiter.x2 << ", " << limiter.x3
+                  << ") in block " << static_cast<int>(limiter.gid)
+                  << " with rho = " << limiter.rho << ", T = " << limiter.T
+                  << ", diffusivity = " << limiter.diff
+                  << ", classic/saturated flux = " << limiter.sat_ratio << std::endl;
+      }
+      return TaskStatus::complete;
+    });
+  }
+  pkg->AddParam<>("step_reductions", step_reductions, true);
+  // Global reductions after the final stage for first order split source terms
+  // depending on global quantities (e.g., turbulence driving), see `step_reductions.hpp`.
+  pkg->AddParam<>("split_source_reductions", StepReductions(), true);
+
+  // Wallclock timers around the task functions, see `task_timers.hpp`
+  pkg->AddParam<>("task_timers", TaskTimers(pin), true);
+  if (pkg->Param<TaskTimers>("task_timers").IsEnabled()) {
+    // Output of the timers (if due)
+    pkg->MutableParam<std::vector<PreStepFun_t>>("pre_step_funs")
+        ->push_back([](Mesh *pmesh, const SimTime &tm) {
+          auto hydro_pkg = pmesh->packages.Get("Hydro");
+          hydro_pkg->MutableParam<TaskTimers>("task_timers")->Output(pmesh, tm, false);
+        });
+  }
+
   if (ProblemInitPackageData != nullptr) {
     ProblemInitPackageData(pin, pkg.get());
   }
 
+  // All quantities (including the ones of the problem generator) have been registered so
+  // that the MPI datatypes of the global reductions can be created (once).
+  pkg->MutableParam<StepReductions>("step_reductions")->SetupMPI();
+  pkg->MutableParam<StepReductions>("split_source_reductions")->SetupMPI();
+
   return pkg;
 }
 
@@ -859,9 +1225,9 @@ Real EstimateTimestep(MeshData<Real> *md) {
     // For unsplit ingegration use strict limit
     if (hydro_pkg->Param<DiffInt>("diffint") == DiffInt::unsplit) {
       min_dt = std::min(min_dt, dt_diff);
-      // and for RKL2 integration use limit taking into account the maxium ratio
-      // or not constrain limit further (which is why RKL2 is there in first place)
-    } else if (hydro_pkg->Param<DiffInt>("diffint") == DiffInt::rkl2) {
+      // and for STS integration use limit taking into account the maxium ratio
+      // or not constrain limit further (which is why STS is there in first place)
+    } else if (IsSTS(hydro_pkg->Param<DiffInt>("diffint"))) {
       const auto max_dt_ratio = hydro_pkg->Param<Real>("rkl2_max_dt_ratio");
       if (max_dt_ratio > 0.0 && dt_hyp / dt_diff > max_dt_ratio) {
         min_dt = std::min(min_dt, max_dt_ratio * dt_diff);
@@ -933,22 +1299,47 @@ TaskStatus CalculateFluxesTight(std::shared_ptr<MeshData<Real>> &md) {
   return TaskStatus::complete;
 }
 
-// Calculate fluxes using scratch pad memory, i.e., over cached pencils in i-dir.
+// Cached k-j-i tile of (primitive) variables in scratch pad memory.
+// The tile is accessed with block indices (and the offset of the first cached cell is
+// taken care of internally) so that it can directly be passed to Reconstruct().
+struct ScratchTile {
+  parthenon::ScratchPad4D<Real> data;
+  int k0, j0; // block index of the first cached cell in k- and j-dir
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  Real &operator()(const int n, const int k, const int j, const int i) const {
+    return data(n, k - k0, j - j0, i);
+  }
+  // Following VariablePack convention, i.e., dim 4 is the variable index
+  KOKKOS_FORCEINLINE_FUNCTION
+  int GetDim(const int dim) const { return data.extent_int(4 - dim); }
+};
+
+// Calculate fluxes in all directions from a single k-j tile of cached prims.
+// Contrary to the pencil version below (one kernel per direction each sweeping over the
+// entire prim pack), the prims (incl. halo required for the reconstruction) are only
+// loaded once from memory per tile, which reduces the memory traffic for bandwidth bound
+// systems (particularly on CPUs with reasonably large caches).
+// Loop limits (and thus calculated fluxes) are identical to the pencil version.
 template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
-TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
+TaskStatus CalculateFluxesFused(std::shared_ptr<MeshData<Real>> &md) {
   auto pmb = md->GetBlockData(0)->GetBlockPointer();
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
-  int il, iu, jl, ju, kl, ku;
+  IndexRange jb_e = pmb->cellbounds.GetBoundsJ(IndexDomain::entire);
+  IndexRange kb_e = pmb->cellbounds.GetBoundsK(IndexDomain::entire);
+  const int ndim = pmb->pmy_mesh->ndim;
+  int jl, ju, kl, ku;
   jl = jb.s, ju = jb.e, kl = kb.s, ku = kb.e;
-  // TODO(pgrete): are these looop limits are likely too large for 2nd order
-  if (pmb->block_size.nx(X2DIR) > 1) {
-    if (pmb->block_size.nx(X3DIR) == 1) // 2D
-      jl = jb.s - 1, ju = jb.e + 1, kl = kb.s, ku = kb.e;
-    else // 3D
-      jl = jb.s - 1, ju = jb.e + 1, kl = kb.s - 1, ku = kb.e + 1;
+  if (ndim >= 2) {
+    jl = jb.s - 1, ju = jb.e + 1;
   }
+  if (ndim >= 3) {
+    kl = kb.s - 1, ku = kb.e + 1;
+  }
+  // transverse loop limits for the x2 and x3 fluxes (identical to the pencil version)
+  const int il = ib.s - 1, iu = ib.e + 1;
 
   std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
   auto cons_in = md->PackVariablesAndFluxes(flags_ind);
@@ -956,6 +1347,220 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
   const auto nhydro = pkg->Param<int>("nhydro");
   const auto nscalars = pkg->Param<int>("nscalars");
 
+  const auto &eos =
+      pkg->Param<typename std::conditional<fluid == Fluid::euler, AdiabaticHydroEOS,
+                                           AdiabaticGLMMHDEOS>::type>("eos");
+
+  const int num_scratch_vars = nhydro + nscalars;
+
+  // Hyperbolic divergence cleaning speed for GLM MHD
+  Real c_h = 0.0;
+  if (fluid == Fluid::glmmhd) {
+    c_h = pkg->Param<Real>("c_h");
+  }
+
+#ifdef ATHENAPK_MIXED_PRECISION
+  // Reconstruction is based on the single precision copy of `prim`
+  auto const &prim_in = md->PackVariables(std::vector<std::string>{"prim_sp"});
+#else
+  auto const &prim_in = md->PackVariables(std::vector<std::string>{"prim"});
+#endif
+
+  const int scratch_level =
+      pkg->Param<int>("scratch_level"); // 0 is actual scratch (tiny); 1 is HBM
+  const int nx1 = pmb->cellbounds.ncellsi(IndexDomain::entire);
+
+  // Tile extent (without halo). Tiling only applies to active dimensions.
+  const int tile_nk = ndim >= 3 ? pkg->Param<int>("flux_tile_nk") : 1;
+  const int tile_nj = ndim >= 2 ? pkg->Param<int>("flux_tile_nj") : 1;
+  // Reconstruction of the lower face of the first cell in a tile requires the full
+  // stencil of the cell below, i.e., one more cell on the lower end.
+  const int recon_nghost = pkg->Param<int>("recon_need_nghost");
+  const int halo_lo = recon_nghost;
+  const int halo_hi = recon_nghost - 1;
+  const int tile_nk_halo = ndim >= 3 ? tile_nk + halo_lo + halo_hi : 1;
+  const int tile_nj_halo = ndim >= 2 ? tile_nj + halo_lo + halo_hi : 1;
+
+  const int num_tiles_k = (ku - kl + tile_nk) / tile_nk;
+  const int num_tiles_j = (ju - jl + tile_nj) / tile_nj;
+
+  size_t scratch_size_in_bytes =
+      parthenon::ScratchPad4D<Real>::shmem_size(num_scratch_vars, tile_nk_halo,
+                                                tile_nj_halo, nx1) +
+      parthenon::ScratchPad2D<Real>::shmem_size(num_scratch_vars, nx1) * 3;
+
+  auto riemann = FluxRiemann<fluid, rsolver>();
+
+  parthenon::par_for_outer(
+      DEFAULT_OUTER_LOOP_PATTERN, "fused flux", DevExecSpace(), scratch_size_in_bytes,
+      scratch_level, 0, cons_in.GetDim(5) - 1, 0, num_tiles_k - 1, 0, num_tiles_j - 1,
+      KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int tk,
+                    const int tj) {
+#ifdef ATHENAPK_MIXED_PRECISION
+        PrimSPBlock prim(prim_in(b), num_scratch_vars);
+#else
+        const auto &prim = prim_in(b);
+#endif
+        auto &cons = cons_in(b);
+
+        // cells (without halo) this tile calculates fluxes for
+        const int ks = kl + tk * tile_nk;
+        const int ke = std::min(ks + tile_nk - 1, ku);
+        const int js = jl + tj * tile_nj;
+        const int je = std::min(js + tile_nj - 1, ju);
+        // cached cells (with halo, but limited to the cells present in a block)
+        const int kts = ndim >= 3 ? std::max(ks - halo_lo, kb_e.s) : ks;
+        const int kte = ndim >= 3 ? std::min(ke + halo_hi, kb_e.e) : ke;
+        const int jts = ndim >= 2 ? std::max(js - halo_lo, jb_e.s) : js;
+        const int jte = ndim >= 2 ? std::min(je + halo_hi, jb_e.e) : je;
+
+        ScratchTile q{parthenon::ScratchPad4D<Real>(member.team_scratch(scratch_level),
+                                                    num_scratch_vars, tile_nk_halo,
+                                                    tile_nj_halo, nx1),
+                      kts, jts};
+        parthenon::ScratchPad2D<Real> wl(member.team_scratch(scratch_level),
+                                         num_scratch_vars, nx1);
+        parthenon::ScratchPad2D<Real> wr(member.team_scratch(scratch_level),
+                                         num_scratch_vars, nx1);
+        parthenon::ScratchPad2D<Real> wlb(member.team_scratch(scratch_level),
+                                          num_scratch_vars, nx1);
+
+        // Load tile. This is the only place the prims are read from memory.
+        for (auto n = 0; n < num_scratch_vars; ++n) {
+          for (auto k = kts; k <= kte; ++k) {
+            for (auto j = jts; j <= jte; ++j) {
+              parthenon::par_for_inner(member, 0, nx1 - 1, [&](const int i) {
+                q(n, k, j, i) = prim(n, k, j, i);
+              });
+            }
+          }
+        }
+        member.team_barrier();
+
+        //------------------------------------------------------------------------------
+        // i-direction
+        for (auto k = ks; k <= ke; ++k) {
+          for (auto j = js; j <= je; ++j) {
+            // get reconstructed state on faces
+            Reconstruct<recon, X1DIR>(member, k, j, ib.s - 1, ib.e + 1, q, wl, wr);
+            // Sync all threads in the team so that scratch memory is consistent
+            member.team_barrier();
+
+            riemann.Solve(member, k, j, ib.s, ib.e + 1, IV1, wl, wr, cons, eos, c_h);
+            member.team_barrier();
+
+            // Passive scalar fluxes
+            for (auto n = nhydro; n < nhydro + nscalars; ++n) {
+              parthenon::par_for_inner(member, ib.s, ib.e + 1, [&](const int i) {
+                if (cons.flux(IV1, IDN, k, j, i) >= 0.0) {
+                  cons.flux(IV1, n, k, j, i) = cons.flux(IV1, IDN, k, j, i) * wl(n, i);
+                } else {
+                  cons.flux(IV1, n, k, j, i) = cons.flux(IV1, IDN, k, j, i) * wr(n, i);
+                }
+              });
+            }
+            member.team_barrier();
+          }
+        }
+
+        //------------------------------------------------------------------------------
+        // j-direction. Each tile calculates the fluxes on the lower faces of its cells.
+        if (ndim >= 2) {
+          const int jfs = std::max(js, jb.s);
+          const int jfe = std::min(je, jb.e + 1);
+          for (auto k = ks; k <= ke; ++k) {
+            for (auto j = jfs - 1; j <= jfe; ++j) {
+              // reconstruct L/R states at j
+              Reconstruct<recon, X2DIR>(member, k, j, il, iu, q, wlb, wr);
+              // Sync all threads in the team so that scratch memory is consistent
+              member.team_barrier();
+
+              if (j > jfs - 1) {
+                riemann.Solve(member, k, j, il, iu, IV2, wl, wr, cons, eos, c_h);
+                member.team_barrier();
+
+                // Passive scalar fluxes
+                for (auto n = nhydro; n < nhydro + nscalars; ++n) {
+                  parthenon::par_for_inner(member, il, iu, [&](const int i) {
+                    if (cons.flux(IV2, IDN, k, j, i) >= 0.0) {
+                      cons.flux(IV2, n, k, j, i) =
+                          cons.flux(IV2, IDN, k, j, i) * wl(n, i);
+                    } else {
+                      cons.flux(IV2, n, k, j, i) =
+                          cons.flux(IV2, IDN, k, j, i) * wr(n, i);
+                    }
+                  });
+                }
+                member.team_barrier();
+              }
+
+              // swap the arrays for the next step
+              auto *tmp = wl.data();
+              wl.assign_data(wlb.data());
+              wlb.assign_data(tmp);
+            }
+          }
+        }
+
+        //------------------------------------------------------------------------------
+        // k-direction. Each tile calculates the fluxes on the lower faces of its cells.
+        if (ndim >= 3) {
+          const int kfs = std::max(ks, kb.s);
+          const int kfe = std::min(ke, kb.e + 1);
+          for (auto j = js; j <= je; ++j) {
+            for (auto k = kfs - 1; k <= kfe; ++k) {
+              // reconstruct L/R states at k
+              Reconstruct<recon, X3DIR>(member, k, j, il, iu, q, wlb, wr);
+              // Sync all threads in the team so that scratch memory is consistent
+              member.team_barrier();
+
+              if (k > kfs - 1) {
+                riemann.Solve(member, k, j, il, iu, IV3, wl, wr, cons, eos, c_h);
+                member.team_barrier();
+
+                // Passive scalar fluxes
+                for (auto n = nhydro; n < nhydro + nscalars; ++n) {
+                  parthenon::par_for_inner(member, il, iu, [&](const int i) {
+                    if (cons.flux(IV3, IDN, k, j, i) >= 0.0) {
+                      cons.flux(IV3, n, k, j, i) =
+                          cons.flux(IV3, IDN, k, j, i) * wl(n, i);
+                    } else {
+                      cons.flux(IV3, n, k, j, i) =
+                          cons.flux(IV3, IDN, k, j, i) * wr(n, i);
+                    }
+                  });
+                }
+                member.team_barrier();
+              }
+              // swap the arrays for the next step
+              auto *tmp = wl.data();
+              wl.assign_data(wlb.data());
+              wlb.assign_data(tmp);
+            }
+          }
+        }
+      });
+
+  const auto &diffint = pkg->Param<DiffInt>("diffint");
+  if (diffint == DiffInt::unsplit) {
+    CalcDiffFluxes(pkg.get(), md.get());
+  }
+
+  return TaskStatus::complete;
+}
+
+// Calculate x1-fluxes on the faces fs..fe of all pencils with k in [kl, ku] and j in
+// [jl, ju] using scratch pad memory, i.e., over cached pencils in i-dir.
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
+void CalculateX1Fluxes(MeshData<Real> *md, const int kl, const int ku, const int jl,
+                       const int ju, const int fs, const int fe) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
+  auto cons_in = md->PackVariablesAndFluxes(flags_ind);
+  auto pkg = pmb->packages.Get("Hydro");
+  const auto nhydro = pkg->Param<int>("nhydro");
+  const auto nscalars = pkg->Param<int>("nscalars");
+
   const auto &eos =
       pkg->Param<typename std::conditional<fluid == Fluid::euler, AdiabaticHydroEOS,
                                            AdiabaticGLMMHDEOS>::type>("eos");
@@ -968,7 +1573,12 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
     c_h = pkg->Param<Real>("c_h");
   }
 
+#ifdef ATHENAPK_MIXED_PRECISION
+  // Reconstruction is based on the single precision copy of `prim`
+  auto const &prim_in = md->PackVariables(std::vector<std::string>{"prim_sp"});
+#else
   auto const &prim_in = md->PackVariables(std::vector<std::string>{"prim"});
+#endif
 
   const int scratch_level =
       pkg->Param<int>("scratch_level"); // 0 is actual scratch (tiny); 1 is HBM
@@ -977,29 +1587,33 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
   size_t scratch_size_in_bytes =
       parthenon::ScratchPad2D<Real>::shmem_size(num_scratch_vars, nx1) * 2;
 
-  auto riemann = Riemann<fluid, rsolver>();
+  auto riemann = FluxRiemann<fluid, rsolver>();
 
   parthenon::par_for_outer(
       DEFAULT_OUTER_LOOP_PATTERN, "x1 flux", DevExecSpace(), scratch_size_in_bytes,
       scratch_level, 0, cons_in.GetDim(5) - 1, kl, ku, jl, ju,
       KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int k, const int j) {
+#ifdef ATHENAPK_MIXED_PRECISION
+        PrimSPBlock prim(prim_in(b), num_scratch_vars);
+#else
         const auto &prim = prim_in(b);
+#endif
         auto &cons = cons_in(b);
         parthenon::ScratchPad2D<Real> wl(member.team_scratch(scratch_level),
                                          num_scratch_vars, nx1);
         parthenon::ScratchPad2D<Real> wr(member.team_scratch(scratch_level),
                                          num_scratch_vars, nx1);
         // get reconstructed state on faces
-        Reconstruct<recon, X1DIR>(member, k, j, ib.s - 1, ib.e + 1, prim, wl, wr);
+        Reconstruct<recon, X1DIR>(member, k, j, fs - 1, fe, prim, wl, wr);
         // Sync all threads in the team so that scratch memory is consistent
         member.team_barrier();
 
-        riemann.Solve(member, k, j, ib.s, ib.e + 1, IV1, wl, wr, cons, eos, c_h);
+        riemann.Solve(member, k, j, fs, fe, IV1, wl, wr, cons, eos, c_h);
         member.team_barrier();
 
         // Passive scalar fluxes
         for (auto n = nhydro; n < nhydro + nscalars; ++n) {
-          parthenon::par_for_inner(member, ib.s, ib.e + 1, [&](const int i) {
+          parthenon::par_for_inner(member, fs, fe, [&](const int i) {
             if (cons.flux(IV1, IDN, k, j, i) >= 0.0) {
               cons.flux(IV1, n, k, j, i) = cons.flux(IV1, IDN, k, j, i) * wl(n, i);
             } else {
@@ -1008,107 +1622,231 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
           });
         }
       });
+}
+
+// Calculate x2- (or x3-) fluxes on the faces fs..fe in j (or k) of all pencils with k
+// (or j) in [ol, ou] and i in [il, iu].
+// The reconstructed states are streamed through the faces so that each pencil is only
+// reconstructed once.
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver, int XNDIR>
+void CalculateTransverseFluxes(MeshData<Real> *md, const int ol, const int ou,
+                               const int il, const int iu, const int fs, const int fe) {
+  static_assert(XNDIR == X2DIR || XNDIR == X3DIR, "Only x2 and x3 fluxes supported.");
+  constexpr int IVN = XNDIR == X2DIR ? IV2 : IV3;
+
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
+  auto cons_in = md->PackVariablesAndFluxes(flags_ind);
+  auto pkg = pmb->packages.Get("Hydro");
+  const auto nhydro = pkg->Param<int>("nhydro");
+  const auto nscalars = pkg->Param<int>("nscalars");
+
+  const auto &eos =
+      pkg->Param<typename std::conditional<fluid == Fluid::euler, AdiabaticHydroEOS,
+                                           AdiabaticGLMMHDEOS>::type>("eos");
+
+  auto num_scratch_vars = nhydro + nscalars;
+
+  // Hyperbolic divergence cleaning speed for GLM MHD
+  Real c_h = 0.0;
+  if (fluid == Fluid::glmmhd) {
+    c_h = pkg->Param<Real>("c_h");
+  }
+
+#ifdef ATHENAPK_MIXED_PRECISION
+  // Reconstruction is based on the single precision copy of `prim`
+  auto const &prim_in = md->PackVariables(std::vector<std::string>{"prim_sp"});
+#else
+  auto const &prim_in = md->PackVariables(std::vector<std::string>{"prim"});
+#endif
+
+  const int scratch_level =
+      pkg->Param<int>("scratch_level"); // 0 is actual scratch (tiny); 1 is HBM
+  const int nx1 = pmb->cellbounds.ncellsi(IndexDomain::entire);
+
+  size_t scratch_size_in_bytes =
+      parthenon::ScratchPad2D<Real>::shmem_size(num_scratch_vars, nx1) * 3;
+
+  auto riemann = FluxRiemann<fluid, rsolver>();
+
+  parthenon::par_for_outer(
+      DEFAULT_OUTER_LOOP_PATTERN, XNDIR == X2DIR ? "x2 flux" : "x3 flux", DevExecSpace(),
+      scratch_size_in_bytes, scratch_level, 0, cons_in.GetDim(5) - 1, ol, ou,
+      KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int o) {
+#ifdef ATHENAPK_MIXED_PRECISION
+        PrimSPBlock prim(prim_in(b), num_scratch_vars);
+#else
+        const auto &prim = prim_in(b);
+#endif
+        auto &cons = cons_in(b);
+        parthenon::ScratchPad2D<Real> wl(member.team_scratch(scratch_level),
+                                         num_scratch_vars, nx1);
+        parthenon::ScratchPad2D<Real> wr(member.team_scratch(scratch_level),
+                                         num_scratch_vars, nx1);
+        parthenon::ScratchPad2D<Real> wlb(member.team_scratch(scratch_level),
+                                          num_scratch_vars, nx1);
+        for (int f = fs - 1; f <= fe; ++f) {
+          const int k = XNDIR == X2DIR ? o : f;
+          const int j = XNDIR == X2DIR ? f : o;
+          // reconstruct L/R states at f
+          Reconstruct<recon, XNDIR>(member, k, j, il, iu, prim, wlb, wr);
+          // Sync all threads in the team so that scratch memory is consistent
+          member.team_barrier();
+
+          if (f > fs - 1) {
+            riemann.Solve(member, k, j, il, iu, IVN, wl, wr, cons, eos, c_h);
+            member.team_barrier();
+
+            // Passive scalar fluxes
+            for (auto n = nhydro; n < nhydro + nscalars; ++n) {
+              parthenon::par_for_inner(member, il, iu, [&](const int i) {
+                if (cons.flux(IVN, IDN, k, j, i) >= 0.0) {
+                  cons.flux(IVN, n, k, j, i) = cons.flux(IVN, IDN, k, j, i) * wl(n, i);
+                } else {
+                  cons.flux(IVN, n, k, j, i) = cons.flux(IVN, IDN, k, j, i) * wr(n, i);
+                }
+              });
+            }
+            member.team_barrier();
+          }
+
+          // swap the arrays for the next step
+          auto *tmp = wl.data();
+          wl.assign_data(wlb.data());
+          wlb.assign_data(tmp);
+        }
+      });
+}
+
+// Calculate fluxes using scratch pad memory, i.e., over cached pencils in i-dir.
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
+TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto pkg = pmb->packages.Get("Hydro");
+  if (pkg->Param<FluxKernel>("flux_kernel") == FluxKernel::fused) {
+    return CalculateFluxesFused<fluid, recon, rsolver>(md);
+  }
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  int jl, ju, kl, ku;
+  jl = jb.s, ju = jb.e, kl = kb.s, ku = kb.e;
+  // TODO(pgrete): are these looop limits are likely too large for 2nd order
+  if (pmb->block_size.nx(X2DIR) > 1) {
+    if (pmb->block_size.nx(X3DIR) == 1) // 2D
+      jl = jb.s - 1, ju = jb.e + 1, kl = kb.s, ku = kb.e;
+    else // 3D
+      jl = jb.s - 1, ju = jb.e + 1, kl = kb.s - 1, ku = kb.e + 1;
+  }
+
+  CalculateX1Fluxes<fluid, recon, rsolver>(md.get(), kl, ku, jl, ju, ib.s, ib.e + 1);
 
   //--------------------------------------------------------------------------------------
   // j-direction
   if (pmb->pmy_mesh->ndim >= 2) {
-    scratch_size_in_bytes =
-        parthenon::ScratchPad2D<Real>::shmem_size(num_scratch_vars, nx1) * 3;
     // set the loop limits
-    il = ib.s - 1, iu = ib.e + 1, kl = kb.s, ku = kb.e;
     if (pmb->block_size.nx(X3DIR) == 1) // 2D
       kl = kb.s, ku = kb.e;
     else // 3D
       kl = kb.s - 1, ku = kb.e + 1;
 
-    parthenon::par_for_outer(
-        DEFAULT_OUTER_LOOP_PATTERN, "x2 flux", DevExecSpace(), scratch_size_in_bytes,
-        scratch_level, 0, cons_in.GetDim(5) - 1, kl, ku,
-        KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int k) {
-          const auto &prim = prim_in(b);
-          auto &cons = cons_in(b);
-          parthenon::ScratchPad2D<Real> wl(member.team_scratch(scratch_level),
-                                           num_scratch_vars, nx1);
-          parthenon::ScratchPad2D<Real> wr(member.team_scratch(scratch_level),
-                                           num_scratch_vars, nx1);
-          parthenon::ScratchPad2D<Real> wlb(member.team_scratch(scratch_level),
-                                            num_scratch_vars, nx1);
-          for (int j = jb.s - 1; j <= jb.e + 1; ++j) {
-            // reconstruct L/R states at j
-            Reconstruct<recon, X2DIR>(member, k, j, il, iu, prim, wlb, wr);
-            // Sync all threads in the team so that scratch memory is consistent
-            member.team_barrier();
-
-            if (j > jb.s - 1) {
-              riemann.Solve(member, k, j, il, iu, IV2, wl, wr, cons, eos, c_h);
-              member.team_barrier();
-
-              // Passive scalar fluxes
-              for (auto n = nhydro; n < nhydro + nscalars; ++n) {
-                parthenon::par_for_inner(member, il, iu, [&](const int i) {
-                  if (cons.flux(IV2, IDN, k, j, i) >= 0.0) {
-                    cons.flux(IV2, n, k, j, i) = cons.flux(IV2, IDN, k, j, i) * wl(n, i);
-                  } else {
-                    cons.flux(IV2, n, k, j, i) = cons.flux(IV2, IDN, k, j, i) * wr(n, i);
-                  }
-                });
-              }
-              member.team_barrier();
-            }
-
-            // swap the arrays for the next step
-            auto *tmp = wl.data();
-            wl.assign_data(wlb.data());
-            wlb.assign_data(tmp);
-          }
-        });
+    CalculateTransverseFluxes<fluid, recon, rsolver, X2DIR>(
+        md.get(), kl, ku, ib.s - 1, ib.e + 1, jb.s, jb.e + 1);
   }
   //--------------------------------------------------------------------------------------
   // k-direction
   if (pmb->pmy_mesh->ndim >= 3) {
-    // set the loop limits
-    il = ib.s - 1, iu = ib.e + 1, jl = jb.s - 1, ju = jb.e + 1;
-
-    parthenon::par_for_outer(
-        DEFAULT_OUTER_LOOP_PATTERN, "x3 flux", DevExecSpace(), scratch_size_in_bytes,
-        scratch_level, 0, cons_in.GetDim(5) - 1, jl, ju,
-        KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int j) {
-          const auto &prim = prim_in(b);
-          auto &cons = cons_in(b);
-          parthenon::ScratchPad2D<Real> wl(member.team_scratch(scratch_level),
-                                           num_scratch_vars, nx1);
-          parthenon::ScratchPad2D<Real> wr(member.team_scratch(scratch_level),
-                                           num_scratch_vars, nx1);
-          parthenon::ScratchPad2D<Real> wlb(member.team_scratch(scratch_level),
-                                            num_scratch_vars, nx1);
-          for (int k = kb.s - 1; k <= kb.e + 1; ++k) {
-            // reconstruct L/R states at j
-            Reconstruct<recon, X3DIR>(member, k, j, il, iu, prim, wlb, wr);
-            // Sync all threads in the team so that scratch memory is consistent
-            member.team_barrier();
+    CalculateTransverseFluxes<fluid, recon, rsolver, X3DIR>(
+        md.get(), jb.s - 1, jb.e + 1, ib.s - 1, ib.e + 1, kb.s, kb.e + 1);
+  }
 
-            if (k > kb.s - 1) {
-              riemann.Solve(member, k, j, il, iu, IV3, wl, wr, cons, eos, c_h);
-              member.team_barrier();
+  const auto &diffint = pkg->Param<DiffInt>("diffint");
+  if (diffint == DiffInt::unsplit) {
+    CalcDiffFluxes(pkg.get(), md.get());
+  }
 
-              // Passive scalar fluxes
-              for (auto n = nhydro; n < nhydro + nscalars; ++n) {
-                parthenon::par_for_inner(member, il, iu, [&](const int i) {
-                  if (cons.flux(IV3, IDN, k, j, i) >= 0.0) {
-                    cons.flux(IV3, n, k, j, i) = cons.flux(IV3, IDN, k, j, i) * wl(n, i);
-                  } else {
-                    cons.flux(IV3, n, k, j, i) = cons.flux(IV3, IDN, k, j, i) * wr(n, i);
-                  }
-                });
-              }
-              member.team_barrier();
-            }
-            // swap the arrays for the next step
-            auto *tmp = wl.data();
-            wl.assign_data(wlb.data());
-            wlb.assign_data(tmp);
-          }
-        });
+  return TaskStatus::complete;
+}
+
+// Faces of the cells in `cells` whose reconstruction stencil (of width 2 * nghost)
+// does not touch any ghost zone. May be empty, i.e., s > e, for small blocks.
+IndexRange InteriorFaces(const IndexRange &cells, const int nghost) {
+  return IndexRange{cells.s + nghost, cells.e + 1 - nghost};
+}
+
+// Lower and upper faces of the cells in `cells` whose reconstruction stencil touches
+// ghost zones, i.e., the complement of InteriorFaces() within cells.s..cells.e+1.
+std::array<IndexRange, 2> ShellFaces(const IndexRange &cells, const int nghost) {
+  return {IndexRange{cells.s, std::min(cells.s + nghost - 1, cells.e + 1)},
+          IndexRange{std::max(cells.e + 2 - nghost, cells.s + nghost), cells.e + 1}};
+}
+
+// Calculate the fluxes on all faces of interior cells whose stencil does not depend on
+// ghost zones, i.e., this can be done while the ghost zones are being exchanged.
+// In contrast to CalculateFluxes() no fluxes on faces in ghost zones are calculated as
+// they are not used in the update.
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
+TaskStatus CalculateFluxesInterior(std::shared_ptr<MeshData<Real>> &md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto pkg = pmb->packages.Get("Hydro");
+  const int nghost = pkg->Param<int>("recon_need_nghost");
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  const int ndim = pmb->pmy_mesh->ndim;
+
+  const auto fi = InteriorFaces(ib, nghost);
+  if (fi.s <= fi.e) {
+    CalculateX1Fluxes<fluid, recon, rsolver>(md.get(), kb.s, kb.e, jb.s, jb.e, fi.s,
+                                             fi.e);
+  }
+  const auto fj = InteriorFaces(jb, nghost);
+  if (ndim >= 2 && fj.s <= fj.e) {
+    CalculateTransverseFluxes<fluid, recon, rsolver, X2DIR>(md.get(), kb.s, kb.e, ib.s,
+                                                            ib.e, fj.s, fj.e);
+  }
+  const auto fk = InteriorFaces(kb, nghost);
+  if (ndim >= 3 && fk.s <= fk.e) {
+    CalculateTransverseFluxes<fluid, recon, rsolver, X3DIR>(md.get(), jb.s, jb.e, ib.s,
+                                                            ib.e, fk.s, fk.e);
+  }
+  return TaskStatus::complete;
+}
+
+// Calculate the remaining fluxes (i.e., the ones not covered by
+// CalculateFluxesInterior()) on faces of interior cells whose stencil touches ghost
+// zones. Requires up-to-date ghost zones (incl. primitive variables).
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
+TaskStatus CalculateFluxesShell(std::shared_ptr<MeshData<Real>> &md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto pkg = pmb->packages.Get("Hydro");
+  const int nghost = pkg->Param<int>("recon_need_nghost");
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  const int ndim = pmb->pmy_mesh->ndim;
+
+  for (const auto &f : ShellFaces(ib, nghost)) {
+    if (f.s <= f.e) {
+      CalculateX1Fluxes<fluid, recon, rsolver>(md.get(), kb.s, kb.e, jb.s, jb.e, f.s,
+                                               f.e);
+    }
+  }
+  if (ndim >= 2) {
+    for (const auto &f : ShellFaces(jb, nghost)) {
+      if (f.s <= f.e) {
+        CalculateTransverseFluxes<fluid, recon, rsolver, X2DIR>(md.get(), kb.s, kb.e,
+                                                                ib.s, ib.e, f.s, f.e);
+      }
+    }
+  }
+  if (ndim >= 3) {
+    for (const auto &f : ShellFaces(kb, nghost)) {
+      if (f.s <= f.e) {
+        CalculateTransverseFluxes<fluid, recon, rsolver, X3DIR>(md.get(), jb.s, jb.e,
+                                                                ib.s, ib.e, f.s, f.e);
+      }
+    }
   }
 
   const auto &diffint = pkg->Param<DiffInt>("diffint");
@@ -1134,8 +1872,8 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
 // (multiple calls) versus extra memory usage is.
 template <Fluid fluid>
 TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, MeshData<Real> *u1_data,
-                                 const Real gam0_, const Real gam1_,
-                                 const Real beta_dt_) {
+                                 const Real gam0_, const Real gam1_, const Real beta_dt_,
+                                 const int partition) {
   // Work around for CUDA <=11.6
   const Real gam0 = gam0_;
   const Real gam1 = gam1_;
@@ -1168,87 +1906,229 @@ TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, MeshData<Real> *u1_dat
 
   auto riemann = Riemann<fluid, RiemannSolver::llf>();
 
-  std::int64_t num_corrected, num_need_floor;
+  // Check a single cell and correct its fluxes if required.
+  // Returns 1 if the fluxes have been corrected, -1 if the cell will rely on the
+  // pressure floor, and 0 if no correction is required.
+  auto correct_cell = KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
+                                    const int attempt) {
+    const auto &coords = u0_cons_pack.GetCoords(b);
+    const auto &u0_prim = u0_prim_pack(b);
+    auto &u0_cons = u0_cons_pack(b);
+
+    // In principle, the u_cons.fluxes could be updated in parallel by a different
+    // thread resulting in a race conditon here.
+    // However, if the fluxes of a cell have been updated (anywhere) then the cell and its
+    // neighbors will be checked again anyway, and, at that point the already fixed
+    // u0_cons.fluxes will automaticlly be used here.
+    Real new_cons[NVAR];
+    for (auto v = 0; v < NVAR; v++) {
+      new_cons[v] =
+          gam0 * u0_cons(v, k, j, i) + gam1 * u1_cons_pack(b, v, k, j, i) +
+          beta_dt * parthenon::Update::FluxDivHelper(v, k, j, i, ndim, coords, u0_cons);
+    }
+
+    // no need to include gamma - 1 as we only care for negative values
+    auto new_p = new_cons[IEN] -
+                 0.5 * (SQR(new_cons[IM1]) + SQR(new_cons[IM2]) + SQR(new_cons[IM3])) /
+                     new_cons[IDN];
+    if constexpr (fluid == Fluid::glmmhd) {
+      new_p -= 0.5 * (SQR(new_cons[IB1]) + SQR(new_cons[IB2]) + SQR(new_cons[IB3]));
+    }
+    // no correction required
+    if (new_cons[IDN] > 0.0 && new_p > 0.0) {
+      return 0;
+    }
+    // if already tried 3 times and only pressure is negative, then we'll rely
+    // on the pressure floor during ConsToPrim conversion
+    if (attempt > 2 && new_cons[IDN] > 0.0 && new_p < 0.0) {
+      return -1;
+    }
+    // In principle, there could be a racecondion as cells are processed in parallel
+    // and we updating the i+1 flux here.
+    // However, the results are idential because u0_prim is never updated in this
+    // kernel so we don't worry about it.
+    // TODO(pgrete) as we need to keep the function signature idential for now (due
+    // to Cuda compiler bug) we could potentially template these function and get
+    // rid of the `if constexpr`
+    riemann.Solve(eos, k, j, i, IV1, u0_prim, u0_cons, c_h);
+    riemann.Solve(eos, k, j, i + 1, IV1, u0_prim, u0_cons, c_h);
+
+    if (ndim >= 2) {
+      riemann.Solve(eos, k, j, i, IV2, u0_prim, u0_cons, c_h);
+      riemann.Solve(eos, k, j + 1, i, IV2, u0_prim, u0_cons, c_h);
+    }
+    if (ndim >= 3) {
+      riemann.Solve(eos, k, j, i, IV3, u0_prim, u0_cons, c_h);
+      riemann.Solve(eos, k + 1, j, i, IV3, u0_prim, u0_cons, c_h);
+    }
+    return 1;
+  };
+
+  // Cells are stored in the worklist by their linear index within the interior of the
+  // pack.
+  const int ni = ib.e + 1 - ib.s;
+  const int nj = jb.e + 1 - jb.s;
+  const int nk = kb.e + 1 - kb.s;
+  const int ncells = u0_cons_pack.GetDim(5) * nk * nj * ni;
+  // Typically, only a small number of cells (e.g., close to shocks) need to be corrected
+  // so the worklist capacity is limited. In case of an overflow, the next attempt falls
+  // back to checking all cells again.
+  const int capacity = std::min(ncells, std::max(1024, ncells / 16));
+  auto &buffers = pkg->MutableParam<std::vector<FirstOrderFluxCorrectBuffers>>(
+      "first_order_flux_correct_buffers")->at(partition);
+  if (buffers.worklist_even.extent_int(0) < capacity) {
+    buffers.worklist_even = ParArray1D<int>(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "fofc worklist even"), capacity);
+    buffers.worklist_odd = ParArray1D<int>(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "fofc worklist odd"), capacity);
+  }
+  if (buffers.worklist_size.extent_int(0) == 0) {
+    buffers.worklist_size = ParArray1D<int>("fofc worklist size", 1);
+  }
+  const auto worklist_even = buffers.worklist_even;
+  const auto worklist_odd = buffers.worklist_odd;
+  const auto worklist_size = buffers.worklist_size;
+
+  // Record a cell corrected in `attempt` in the worklist of the next attempt
+  auto record_cell = KOKKOS_LAMBDA(const int cell, const int attempt) {
+    const int n = Kokkos::atomic_fetch_add(&worklist_size(0), 1);
+    if (n < capacity) {
+      (attempt % 2 == 0 ? worklist_even : worklist_odd)(n) = cell;
+    }
+  };
+
+  // Cells checked multiple times in the same attempt (e.g., the shared neighbor of two
+  // corrected cells) or in multiple attempts are flagged so that they are only recorded
+  // once per attempt in the worklist and only counted once for the event counters.
+  // The flags are initialized by the first attempt, which checks all cells once.
+  constexpr int flag_corrected = 1;
+  constexpr int flag_need_floor = 2;
+  // recorded in the worklist of attempt a: flag_recorded << a
+  constexpr int flag_recorded = 4;
+  if (buffers.cell_flags.extent_int(0) < ncells) {
+    buffers.cell_flags = ParArray1D<int>(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "fofc cell flags"), ncells);
+  }
+  const auto cell_flags = buffers.cell_flags;
+
+  // Check a single cell and update the flags, the worklist, and the number of cells
+  // corrected in this attempt, cells corrected for the first time, and cells (for the
+  // first time) relying on the pressure floor.
+  auto check_cell = KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
+                                  const int attempt, std::int64_t &lnum_corrected,
+                                  std::int64_t &lnum_new_corrected,
+                                  std::int64_t &lnum_need_floor) {
+    const auto status = correct_cell(b, k, j, i, attempt);
+    const int cell = ((b * nk + k - kb.s) * nj + j - jb.s) * ni + i - ib.s;
+    const int flags = status == 1    ? flag_corrected | (flag_recorded << attempt)
+                      : status == -1 ? flag_need_floor
+                                     : 0;
+    int prev_flags = 0;
+    if (attempt == 0) {
+      cell_flags(cell) = flags;
+    } else if (flags != 0) {
+      prev_flags = Kokkos::atomic_fetch_or(&cell_flags(cell), flags);
+    }
+    if (status == 1) {
+      if (!(prev_flags & (flag_recorded << attempt))) {
+        record_cell(cell, attempt);
+        lnum_corrected += 1;
+      }
+      if (!(prev_flags & flag_corrected)) {
+        lnum_new_corrected += 1;
+      }
+    } else if (status == -1 && !(prev_flags & flag_need_floor)) {
+      lnum_need_floor += 1;
+    }
+  };
+
+  std::int64_t num_corrected, num_new_corrected, num_need_floor;
+  // Number of distinct cells over all attempts for the event counters
+  std::int64_t num_corrected_total = 0, num_need_floor_total = 0;
   // Potentially need multiple attempts as flux correction corrects 6 (in 3D) fluxes
   // of a single cell at the same time. So the neighboring cells need to be rechecked with
   // the corrected fluxes as the corrected fluxes in one cell may result in the need to
   // correct all the fluxes of an originally "good" neighboring cell.
-  size_t num_attempts = 0;
+  // Only the first attempt checks all cells. Subsequent attempts only check the cells
+  // corrected in the previous attempt and their face neighbors (i.e., all cells whose
+  // fluxes may have changed).
+  int num_attempts = 0;
+  bool full_sweep = true;
+  int num_prev = 0;
   do {
     num_corrected = 0;
+    num_new_corrected = 0;
+    num_need_floor = 0;
+    Kokkos::deep_copy(worklist_size, 0);
+
+    if (full_sweep) {
+      Kokkos::parallel_reduce(
+          "FirstOrderFluxCorrect",
+          Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+              DevExecSpace(), {0, kb.s, jb.s, ib.s},
+              {u0_cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+              {1, 1, 1, ib.e + 1 - ib.s}),
+          KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
+                        std::int64_t &lnum_corrected, std::int64_t &lnum_new_corrected,
+                        std::int64_t &lnum_need_floor) {
+            check_cell(b, k, j, i, num_attempts, lnum_corrected, lnum_new_corrected,
+                       lnum_need_floor);
+          },
+          Kokkos::Sum<std::int64_t>(num_corrected),
+          Kokkos::Sum<std::int64_t>(num_new_corrected),
+          Kokkos::Sum<std::int64_t>(num_need_floor));
+    } else {
+      // each previously corrected cell itself (n = 0) plus its 2 * ndim face neighbors
+      const int nnb = 2 * ndim + 1;
+      const auto worklist_prev = num_attempts % 2 == 1 ? worklist_even : worklist_odd;
+      Kokkos::parallel_reduce(
+          "FirstOrderFluxCorrect worklist",
+          Kokkos::RangePolicy<>(DevExecSpace(), 0, num_prev * nnb),
+          KOKKOS_LAMBDA(const int idx, std::int64_t &lnum_corrected,
+                        std::int64_t &lnum_new_corrected, std::int64_t &lnum_need_floor) {
+            const int n = idx % nnb;
+            int cell = worklist_prev(idx / nnb);
+            int i = cell % ni + ib.s;
+            cell /= ni;
+            int j = cell % nj + jb.s;
+            cell /= nj;
+            int k = cell % nk + kb.s;
+            const int b = cell / nk;
+            // odd n: lower neighbor, even n: upper neighbor in direction (n + 1) / 2
+            const int offset = n % 2 == 1 ? -1 : 1;
+            if (n == 1 || n == 2) {
+              i += offset;
+            } else if (n == 3 || n == 4) {
+              j += offset;
+            } else if (n == 5 || n == 6) {
+              k += offset;
+            }
+            // neighbors in other blocks are not affected by the corrected fluxes
+            if (i < ib.s || i > ib.e || j < jb.s || j > jb.e || k < kb.s || k > kb.e) {
+              return;
+            }
+            check_cell(b, k, j, i, num_attempts, lnum_corrected, lnum_new_corrected,
+                       lnum_need_floor);
+          },
+          Kokkos::Sum<std::int64_t>(num_corrected),
+          Kokkos::Sum<std::int64_t>(num_new_corrected),
+          Kokkos::Sum<std::int64_t>(num_need_floor));
+    }
+    num_corrected_total += num_new_corrected;
+    num_need_floor_total += num_need_floor;
 
-    Kokkos::parallel_reduce(
-        "FirstOrderFluxCorrect",
-        Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
-            DevExecSpace(), {0, kb.s, jb.s, ib.s},
-            {u0_cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
-            {1, 1, 1, ib.e + 1 - ib.s}),
-        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
-                      std::int64_t &lnum_corrected, std::int64_t &lnum_need_floor) {
-          const auto &coords = u0_cons_pack.GetCoords(b);
-          const auto &u0_prim = u0_prim_pack(b);
-          auto &u0_cons = u0_cons_pack(b);
-
-          // In principle, the u_cons.fluxes could be updated in parallel by a different
-          // thread resulting in a race conditon here.
-          // However, if the fluxes of a cell have been updated (anywhere) then the entire
-          // kernel will be called again anyway, and, at that point the already fixed
-          // u0_cons.fluxes will automaticlly be used here.
-          Real new_cons[NVAR];
-          for (auto v = 0; v < NVAR; v++) {
-            new_cons[v] =
-                gam0 * u0_cons(v, k, j, i) + gam1 * u1_cons_pack(b, v, k, j, i) +
-                beta_dt *
-                    parthenon::Update::FluxDivHelper(v, k, j, i, ndim, coords, u0_cons);
-          }
-
-          // no need to include gamma - 1 as we only care for negative values
-          auto new_p =
-              new_cons[IEN] -
-              0.5 * (SQR(new_cons[IM1]) + SQR(new_cons[IM2]) + SQR(new_cons[IM3])) /
-                  new_cons[IDN];
-          if constexpr (fluid == Fluid::glmmhd) {
-            new_p -= 0.5 * (SQR(new_cons[IB1]) + SQR(new_cons[IB2]) + SQR(new_cons[IB3]));
-          }
-          // no correction required
-          if (new_cons[IDN] > 0.0 && new_p > 0.0) {
-            return;
-          }
-          // if already tried 3 times and only pressure is negative, then we'll rely
-          // on the pressure floor during ConsToPrim conversion
-          if (num_attempts > 2 && new_cons[IDN] > 0.0 && new_p < 0.0) {
-            lnum_need_floor += 1;
-            return;
-          }
-          // In principle, there could be a racecondion as this loop goes over all k,j,i
-          // and we updating the i+1 flux here.
-          // However, the results are idential because u0_prim is never updated in this
-          // kernel so we don't worry about it.
-          // TODO(pgrete) as we need to keep the function signature idential for now (due
-          // to Cuda compiler bug) we could potentially template these function and get
-          // rid of the `if constexpr`
-          riemann.Solve(eos, k, j, i, IV1, u0_prim, u0_cons, c_h);
-          riemann.Solve(eos, k, j, i + 1, IV1, u0_prim, u0_cons, c_h);
-
-          if (ndim >= 2) {
-            riemann.Solve(eos, k, j, i, IV2, u0_prim, u0_cons, c_h);
-            riemann.Solve(eos, k, j + 1, i, IV2, u0_prim, u0_cons, c_h);
-          }
-          if (ndim >= 3) {
-            riemann.Solve(eos, k, j, i, IV3, u0_prim, u0_cons, c_h);
-            riemann.Solve(eos, k + 1, j, i, IV3, u0_prim, u0_cons, c_h);
-          }
-          lnum_corrected += 1;
-        },
-        Kokkos::Sum<std::int64_t>(num_corrected),
-        Kokkos::Sum<std::int64_t>(num_need_floor));
-    // TODO(pgrete) make this optional and global (potentially store values in Params)
-    // std::cout << "[" << parthenon::Globals::my_rank << "] Attempt: " << num_attempts
-    //           << " Corrected (center): " << num_corrected
-    //           << " Failed (will rely on floor): " << num_need_floor << std::endl;
+    full_sweep = num_corrected > capacity;
+    num_prev = static_cast<int>(num_corrected);
     num_attempts += 1;
   } while (num_corrected > 0 && num_attempts < 4);
 
+  if (pkg->Param<bool>("floor_event_counters")) {
+    FloorEventCounts events;
+    events.counts[static_cast<int>(FloorEvent::fofc_corrected)] = num_corrected_total;
+    events.counts[static_cast<int>(FloorEvent::fofc_need_floor)] = num_need_floor_total;
+    AccumulateFloorEvents(pkg->Param<FloorEventCountsHost>("floor_event_counts"), events);
+  }
+
   return TaskStatus::complete;
 }
 
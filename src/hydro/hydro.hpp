@@ -27,11 +27,19 @@ TaskStatus AddUnsplitSources(MeshData<Real> *md, const SimTime &tm, const Real b
 TaskStatus AddSplitSourcesFirstOrder(MeshData<Real> *md, const SimTime &tm);
 TaskStatus AddSplitSourcesStrang(MeshData<Real> *md, const SimTime &tm);
 
+// Calculate the minimum dx (accumulated in the "mindx" param) of a partition
+TaskStatus CalculateGlobalMinDx(MeshData<Real> *md);
+// Update the divergence cleaning speed from the globally reduced "mindx" and "dt_hyp"
+TaskStatus UpdateDivCleaningSpeed(StateDescriptor *hydro_pkg);
+
 using SourceFun_t =
     std::function<void(MeshData<Real> *md, const SimTime &tm, const Real dt)>;
 using EstimateTimestepFun_t = std::function<Real(MeshData<Real> *md)>;
 using InitPackageDataFun_t =
     std::function<void(ParameterInput *pin, StateDescriptor *pkg)>;
+// Work done at the beginning of each cycle (in between cycles on all ranks), registered
+// in the "pre_step_funs" param of the "Hydro" package, see PreStepMeshUserWorkInLoop
+using PreStepFun_t = std::function<void(Mesh *pmesh, const SimTime &tm)>;
 
 extern SourceFun_t ProblemSourceFirstOrder;
 extern SourceFun_t ProblemSourceUnsplit;
@@ -46,19 +54,54 @@ template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
 TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md);
 using FluxFun_t =
     decltype(CalculateFluxes<Fluid::euler, Reconstruction::dc, RiemannSolver::hlle>);
-
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
+TaskStatus CalculateFluxesInterior(std::shared_ptr<MeshData<Real>> &md);
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
+TaskStatus CalculateFluxesShell(std::shared_ptr<MeshData<Real>> &md);
+
+template <class T>
+TaskStatus ConsToPrimGhosts(MeshData<Real> *md);
+using ConsToPrimGhostsFun_t = decltype(ConsToPrimGhosts<AdiabaticHydroEOS>);
+
+// Device buffers of the first order flux correction that are reused across calls (and
+// only reallocated if a partition grows). Stored per partition (in the
+// "first_order_flux_correct_buffers" param) so that partitions can be corrected
+// concurrently.
+struct FirstOrderFluxCorrectBuffers {
+  parthenon::ParArray1D<int> cell_flags;
+  // worklists of the cells corrected in even and odd attempts (so that one attempt
+  // reads the worklist of the previous attempt while recording its own)
+  parthenon::ParArray1D<int> worklist_even;
+  parthenon::ParArray1D<int> worklist_odd;
+  parthenon::ParArray1D<int> worklist_size;
+};
+
+// `partition` is the index of the partition of u0_data and u1_data
 template <Fluid fluid>
 TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, MeshData<Real> *u1_data,
-                                 const Real gam0, const Real gam1, const Real beta_dt);
+                                 const Real gam0, const Real gam1, const Real beta_dt,
+                                 const int partition);
 using FirstOrderFluxCorrectFun_t = decltype(FirstOrderFluxCorrect<Fluid::glmmhd>);
 
 using FluxFunKey_t = std::tuple<Fluid, Reconstruction, RiemannSolver>;
 
-// Add flux function pointer to map containing all compiled in flux functions
+// Flux functions of a single fluid/reconstruction/Riemann solver combination.
+// `interior` and `shell` together calculate the fluxes on all faces of interior cells,
+// split by whether the stencil of a face touches ghost zones (`shell`) or not
+// (`interior`). They are nullptr if the combination does not support this split.
+struct FluxFuns {
+  FluxFun_t *all;
+  FluxFun_t *interior;
+  FluxFun_t *shell;
+};
+
+// Add flux function pointers to map containing all compiled in flux functions
 template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
-void add_flux_fun(std::map<FluxFunKey_t, FluxFun_t *> &flux_functions) {
-  flux_functions[std::make_tuple(fluid, recon, rsolver)] =
-      Hydro::CalculateFluxes<fluid, recon, rsolver>;
+void add_flux_fun(std::map<FluxFunKey_t, FluxFuns> &flux_functions) {
+  flux_functions[std::make_tuple(fluid, recon, rsolver)] = {
+      Hydro::CalculateFluxes<fluid, recon, rsolver>,
+      Hydro::CalculateFluxesInterior<fluid, recon, rsolver>,
+      Hydro::CalculateFluxesShell<fluid, recon, rsolver>};
 }
 
 // Get number of "fluid" variable used
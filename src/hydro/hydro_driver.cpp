@@ -4,6 +4,9 @@
 // Licensed under the BSD 3-Clause License (the "LICENSE").
 //========================================================================================
 
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
 #include <limits>
 #include <memory>
 #include <string>
@@ -12,22 +15,95 @@
 
 // Parthenon headers
 #include "amr_criteria/refinement_package.hpp"
+#include "bvals/boundary_conditions.hpp"
 #include "bvals/comms/bvals_in_one.hpp"
 #include "prolong_restrict/prolong_restrict.hpp"
 #include <parthenon/parthenon.hpp>
 // AthenaPK headers
 #include "../eos/adiabatic_hydro.hpp"
-#include "../pgen/cluster/agn_triggering.hpp"
-#include "../pgen/cluster/magnetic_tower.hpp"
 #include "diffusion/diffusion.hpp"
 #include "glmmhd/glmmhd.hpp"
 #include "hydro.hpp"
 #include "hydro_driver.hpp"
+#include "step_reductions.hpp"
+#include "task_timers.hpp"
 
 using namespace parthenon::driver::prelude;
 
 namespace Hydro {
 
+// Variables allocated in the additional registers of the integrators. All other
+// (non-OneCopy) variables are only used in the "base" register.
+// "u1" stores the state at the beginning of the cycle (for the hyperbolic integrator and
+// as Y0 and MY0 for super-time-stepping, see STSStepFirst) and only requires `prim` for
+// the first order flux correction.
+std::vector<std::string> GetRegisterFields(StateDescriptor *hydro_pkg,
+                                           const std::string &reg) {
+  std::vector<std::string> fields = {"cons"};
+  if (reg == "u1" && hydro_pkg->Param<bool>("first_order_flux_correct")) {
+    fields.emplace_back("prim");
+  }
+  return fields;
+}
+
+// Memory (in bytes) of all variables (incl. fluxes) of the "base" register of `pmb` that
+// would be allocated in a register containing the variables `fields` or, if `fields` is
+// empty, in a register containing all variables.
+std::size_t RegisterBytes(MeshBlock *pmb, const std::vector<std::string> &fields) {
+  std::size_t bytes = 0;
+  for (const auto &var : pmb->meshblock_data.Get()->GetVariableVector()) {
+    // OneCopy variables are shared between all registers
+    if ((fields.empty() && var->IsSet(Metadata::OneCopy)) ||
+        (!fields.empty() &&
+         std::find(fields.begin(), fields.end(), var->label()) == fields.end())) {
+      continue;
+    }
+    bytes += var->data.size() * sizeof(Real);
+    if (var->IsSet(Metadata::WithFluxes)) {
+      for (int d = X1DIR; d <= pmb->pmy_mesh->ndim; d++) {
+        bytes += var->flux[d].size() * sizeof(Real);
+      }
+    }
+  }
+  return bytes;
+}
+
+// Report the memory footprint per block of the integrator registers with all variables
+// and with only the variables actually required (as allocated).
+void ReportRegisterMemory(Mesh *pm) {
+  auto hydro_pkg = pm->packages.Get("Hydro");
+  auto &pmb = pm->block_list[0];
+
+  std::vector<std::string> registers = {"u1"};
+
+  const auto base_bytes = RegisterBytes(pmb.get(), {});
+  auto total_bytes = base_bytes;
+  std::cout << "Memory footprint per block of the integrator registers in bytes "
+            << "(all variables -> allocated variables):" << std::endl
+            << "  base: " << base_bytes << std::endl;
+  for (const auto &reg : registers) {
+    const auto fields = GetRegisterFields(hydro_pkg.get(), reg);
+    const auto reg_bytes = RegisterBytes(pmb.get(), fields);
+    total_bytes += reg_bytes;
+    std::cout << "  " << reg << ": " << base_bytes << " -> " << reg_bytes << " (";
+    for (const auto &field : fields) {
+      std::cout << field << (field == fields.back() ? ")" : ", ");
+    }
+    std::cout << std::endl;
+  }
+  auto total_bytes_all = base_bytes * (registers.size() + 1);
+  // The STS registers MY0 and Yjm2 (previously full copies of "base") are stored in
+  // "u1" and in a field only containing the conserved variables updated by diffusion.
+  if (IsSTS(hydro_pkg->Param<DiffInt>("diffint"))) {
+    const auto sts_bytes = RegisterBytes(pmb.get(), {"sts_Yjm2"});
+    total_bytes += sts_bytes;
+    total_bytes_all += 2 * base_bytes;
+    std::cout << "  MY0, Yjm2 (STS): " << 2 * base_bytes << " -> " << sts_bytes
+              << " (sts_Yjm2)" << std::endl;
+  }
+  std::cout << "  total: " << total_bytes_all << " -> " << total_bytes << std::endl;
+}
+
 HydroDriver::HydroDriver(ParameterInput *pin, ApplicationInput *app_in, Mesh *pm)
     : MultiStageDriver(pin, app_in, pm) {
   // fail if these are not specified in the input file
@@ -35,6 +111,24 @@ HydroDriver::HydroDriver(ParameterInput *pin, ApplicationInput *app_in, Mesh *pm
 
   // warn if these fields aren't specified in the input file
   pin->CheckDesired("parthenon/time", "cfl");
+
+  // Deferring the receiving of ghost zones to the next stage does not (yet) cover
+  // restriction and prolongation.
+  PARTHENON_REQUIRE_THROWS(
+      !(pm->packages.Get("Hydro")->Param<bool>("overlap_flux_comm") && pm->multilevel),
+      "hydro/overlap_flux_comm is currently only supported for uniform grids.");
+
+  if (parthenon::Globals::my_rank == 0) {
+    ReportRegisterMemory(pm);
+  }
+}
+
+void HydroDriver::PostExecute(parthenon::DriverStatus status) {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  hydro_pkg->MutableParam<TaskTimers>("task_timers")->Output(pmesh, tm, true);
+  hydro_pkg->MutableParam<StepReductions>("step_reductions")->FreeMPI();
+  hydro_pkg->MutableParam<StepReductions>("split_source_reductions")->FreeMPI();
+  MultiStageDriver::PostExecute(status);
 }
 
 // Calculate mininum dx, which is used in calculating the divergence cleaning speed c_h
@@ -77,6 +171,14 @@ TaskStatus CalculateGlobalMinDx(MeshData<Real> *md) {
   return TaskStatus::complete;
 }
 
+TaskStatus UpdateDivCleaningSpeed(StateDescriptor *hydro_pkg) {
+  const auto &mindx = hydro_pkg->Param<Real>("mindx");
+  const auto &cfl_hyp = hydro_pkg->Param<Real>("cfl");
+  const auto &dt_hyp = hydro_pkg->Param<Real>("dt_hyp");
+  hydro_pkg->UpdateParam("c_h", cfl_hyp * mindx / dt_hyp);
+  return TaskStatus::complete;
+}
+
 // Sets all fluxes to 0
 TaskStatus ResetFluxes(MeshData<Real> *md) {
   auto pmb = md->GetBlockData(0)->GetBlockPointer();
@@ -127,82 +229,286 @@ TaskStatus ResetFluxes(MeshData<Real> *md) {
   return TaskStatus::complete;
 }
 
-TaskStatus RKL2StepFirst(MeshData<Real> *md_Y0, MeshData<Real> *md_Yjm1,
-                         MeshData<Real> *md_Yjm2, MeshData<Real> *md_MY0, const int s_rkl,
-                         const Real tau) {
+// Super-time-stepping (STS) registers of the subset of conserved variables `sts_vars`
+// updated by diffusion:
+// - Y0 (the initial state) is stored in the conserved variables of "u1",
+// - MY0 (the flux divergence of the initial state) is stored in the (otherwise unused)
+//   x1-fluxes of the conserved variables of "u1" (in cell k,j,i),
+// - Yjm1 (the previous stage) is stored in the conserved variables of "base", and
+// - Yjm2 (the stage before the previous one) is stored in the field "sts_Yjm2".
+// All other conserved variables are not changed by the diffusion processes and are thus
+// not integrated.
+TaskStatus STSStepFirst(MeshData<Real> *md_Y0, MeshData<Real> *md_Yjm1,
+                        const Real mu_tilde_1, const Real tau) {
   auto pmb = md_Y0->GetBlockData(0)->GetBlockPointer();
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
-
-  // Compute coefficients. Meyer+2014 eq. (18)
-  Real mu_tilde_1 = 4. / 3. /
-                    (static_cast<Real>(s_rkl) * static_cast<Real>(s_rkl) +
-                     static_cast<Real>(s_rkl) - 2.);
+  const auto &sts_vars =
+      pmb->packages.Get("Hydro")->Param<parthenon::ParArray1D<int>>("sts_vars");
 
   // In principle, we'd only need to pack Metadata::WithFluxes here, but
   // choosing to mirror other use in the code so that the packs are already cached.
   std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
   auto Y0 = md_Y0->PackVariablesAndFluxes(flags_ind);
   auto Yjm1 = md_Yjm1->PackVariablesAndFluxes(flags_ind);
-  auto Yjm2 = md_Yjm2->PackVariablesAndFluxes(flags_ind);
-  auto MY0 = md_MY0->PackVariablesAndFluxes(flags_ind);
+  auto Yjm2 = md_Yjm1->PackVariables(std::vector<std::string>{"sts_Yjm2"});
 
   const int ndim = pmb->pmy_mesh->ndim;
-  // Using separate loops for each dim as the launch overhead should be hidden
-  // by enough work over the entire pack and it allows to not use any conditionals.
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "RKL first step", parthenon::DevExecSpace(), 0,
-      Y0.GetDim(5) - 1, 0, Y0.GetDim(4) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int b, const int v, const int k, const int j, const int i) {
-        Yjm1(b, v, k, j, i) =
-            Y0(b, v, k, j, i) + mu_tilde_1 * tau * MY0(b, v, k, j, i); // Y_1
-        Yjm2(b, v, k, j, i) = Y0(b, v, k, j, i);                       // Y_0
+      DEFAULT_LOOP_PATTERN, "STS first step", parthenon::DevExecSpace(), 0,
+      Y0.GetDim(5) - 1, 0, sts_vars.extent_int(0) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e,
+      KOKKOS_LAMBDA(const int b, const int l, const int k, const int j, const int i) {
+        const int v = sts_vars(l);
+        const auto &coords = Yjm1.GetCoords(b);
+        // Yjm1 still contains Y0 and the fluxes of Y0
+        const Real y0 = Yjm1(b, v, k, j, i);
+        const Real my0 =
+            parthenon::Update::FluxDivHelper(v, k, j, i, ndim, coords, Yjm1(b));
+        Y0(b, v, k, j, i) = y0;
+        Y0(b).flux(X1DIR, v, k, j, i) = my0;
+        Yjm1(b, v, k, j, i) = y0 + mu_tilde_1 * tau * my0; // Y_1
+        Yjm2(b, l, k, j, i) = y0;                          // Y_0
       });
 
   return TaskStatus::complete;
 }
 
-TaskStatus RKL2StepOther(MeshData<Real> *md_Y0, MeshData<Real> *md_Yjm1,
-                         MeshData<Real> *md_Yjm2, MeshData<Real> *md_MY0, const Real mu_j,
-                         const Real nu_j, const Real mu_tilde_j, const Real gamma_tilde_j,
-                         const Real tau) {
+TaskStatus STSStepOther(MeshData<Real> *md_Y0, MeshData<Real> *md_Yjm1, const Real mu_j,
+                        const Real nu_j, const Real mu_tilde_j, const Real gamma_tilde_j,
+                        const Real tau) {
   auto pmb = md_Y0->GetBlockData(0)->GetBlockPointer();
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  const auto &sts_vars =
+      pmb->packages.Get("Hydro")->Param<parthenon::ParArray1D<int>>("sts_vars");
 
   // In principle, we'd only need to pack Metadata::WithFluxes here, but
   // choosing to mirror other use in the code so that the packs are already cached.
   std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
   auto Y0 = md_Y0->PackVariablesAndFluxes(flags_ind);
   auto Yjm1 = md_Yjm1->PackVariablesAndFluxes(flags_ind);
-  auto Yjm2 = md_Yjm2->PackVariablesAndFluxes(flags_ind);
-  auto MY0 = md_MY0->PackVariablesAndFluxes(flags_ind);
+  auto Yjm2 = md_Yjm1->PackVariables(std::vector<std::string>{"sts_Yjm2"});
 
   const int ndim = pmb->pmy_mesh->ndim;
-  // Using separate loops for each dim as the launch overhead should be hidden
-  // by enough work over the entire pack and it allows to not use any conditionals.
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "RKL other step", parthenon::DevExecSpace(), 0,
-      Y0.GetDim(5) - 1, 0, Y0.GetDim(4) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int b, const int v, const int k, const int j, const int i) {
+      DEFAULT_LOOP_PATTERN, "STS other step", parthenon::DevExecSpace(), 0,
+      Y0.GetDim(5) - 1, 0, sts_vars.extent_int(0) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e,
+      KOKKOS_LAMBDA(const int b, const int l, const int k, const int j, const int i) {
+        const int v = sts_vars(l);
         // First calc this step
         const auto &coords = Yjm1.GetCoords(b);
         const Real MYjm1 =
             parthenon::Update::FluxDivHelper(v, k, j, i, ndim, coords, Yjm1(b));
-        const Real Yj = mu_j * Yjm1(b, v, k, j, i) + nu_j * Yjm2(b, v, k, j, i) +
+        const Real Yj = mu_j * Yjm1(b, v, k, j, i) + nu_j * Yjm2(b, l, k, j, i) +
                         (1.0 - mu_j - nu_j) * Y0(b, v, k, j, i) +
                         mu_tilde_j * tau * MYjm1 +
-                        gamma_tilde_j * tau * MY0(b, v, k, j, i);
+                        gamma_tilde_j * tau * Y0(b).flux(X1DIR, v, k, j, i);
         // Then shuffle vars for next step
-        Yjm2(b, v, k, j, i) = Yjm1(b, v, k, j, i);
+        Yjm2(b, l, k, j, i) = Yjm1(b, v, k, j, i);
         Yjm1(b, v, k, j, i) = Yj;
       });
 
   return TaskStatus::complete;
 }
 
+// Whether the (other) STS stages can be calculated by STSStepOtherFused, i.e., on
+// uniform grids (so that no flux correction is required) and with isotropic thermal
+// conduction with a fixed coefficient as the only diffusion process.
+bool UseFusedSTSStage(Mesh *pmesh, StateDescriptor *hydro_pkg) {
+  if (pmesh->multilevel || hydro_pkg->Param<Viscosity>("viscosity") != Viscosity::none ||
+      hydro_pkg->Param<Resistivity>("resistivity") != Resistivity::none ||
+      hydro_pkg->Param<Conduction>("conduction") != Conduction::isotropic) {
+    return false;
+  }
+  const auto &thermal_diff = hydro_pkg->Param<ThermalDiffusivity>("thermal_diff");
+  return thermal_diff.GetCoeffType() == ConductionCoeff::fixed;
+}
+
+// Same as STSStepOther but with the diffusive fluxes calculated in the same kernel
+// (for the faces of each cell) instead of separately resetting, calculating, storing and
+// reading them. See UseFusedSTSStage for when this is applicable.
+// Note that each interior face flux is calculated twice (once for each adjacent cell).
+// Given the few operations per face (two temperatures, a difference and a mean density
+// from the already loaded primitives) this is cheaper than the additional pass over
+// memory for storing and reading the fluxes. It would not be for the general conduction
+// flux (with gradients across faces, saturation and field direction) so that the fused
+// stage is limited to isotropic conduction with a fixed coefficient.
+TaskStatus STSStepOtherFused(MeshData<Real> *md_Y0, MeshData<Real> *md_Yjm1,
+                             const Real mu_j, const Real nu_j, const Real mu_tilde_j,
+                             const Real gamma_tilde_j, const Real tau) {
+  auto pmb = md_Y0->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+
+  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
+  auto Y0 = md_Y0->PackVariablesAndFluxes(flags_ind);
+  auto Yjm1 = md_Yjm1->PackVariablesAndFluxes(flags_ind);
+  auto Yjm2 = md_Yjm1->PackVariables(std::vector<std::string>{"sts_Yjm2"});
+  // `prim` of Yjm1 is in sync with the conserved variables (incl. ghost zones)
+  auto const &prim_pack = md_Yjm1->PackVariables(std::vector<std::string>{"prim"});
+
+  // Using fixed and uniform coefficient so it's safe to get it outside the kernel.
+  const auto thermal_diff_coeff = GetThermalDiffCoeffIsoFixed(hydro_pkg.get());
+
+  const int ndim = pmb->pmy_mesh->ndim;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "STS other step (fused)", parthenon::DevExecSpace(), 0,
+      Y0.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        const auto &coords = prim_pack.GetCoords(b);
+        const auto &prim = prim_pack(b);
+        // Flux divergence following parthenon::Update::FluxDivHelper
+        Real du = coords.FaceArea<X1DIR>(k, j, i + 1) *
+                      ThermalFluxIsoFixedFace<X1DIR>(prim, coords, thermal_diff_coeff, k,
+                                                     j, i + 1) -
+                  coords.FaceArea<X1DIR>(k, j, i) *
+                      ThermalFluxIsoFixedFace<X1DIR>(prim, coords, thermal_diff_coeff, k,
+                                                     j, i);
+        if (ndim >= 2) {
+          du += coords.FaceArea<X2DIR>(k, j + 1, i) *
+                    ThermalFluxIsoFixedFace<X2DIR>(prim, coords, thermal_diff_coeff, k,
+                                                   j + 1, i) -
+                coords.FaceArea<X2DIR>(k, j, i) *
+                    ThermalFluxIsoFixedFace<X2DIR>(prim, coords, thermal_diff_coeff, k, j,
+                                                   i);
+        }
+        if (ndim == 3) {
+          du += coords.FaceArea<X3DIR>(k + 1, j, i) *
+                    ThermalFluxIsoFixedFace<X3DIR>(prim, coords, thermal_diff_coeff,
+                                                   k + 1, j, i) -
+                coords.FaceArea<X3DIR>(k, j, i) *
+                    ThermalFluxIsoFixedFace<X3DIR>(prim, coords, thermal_diff_coeff, k, j,
+                                                   i);
+        }
+        const Real MYjm1 = -du / coords.CellVolume(k, j, i);
+
+        // Isotropic conduction only updates the total energy, see "sts_vars"
+        const Real Yj = mu_j * Yjm1(b, IEN, k, j, i) + nu_j * Yjm2(b, 0, k, j, i) +
+                        (1.0 - mu_j - nu_j) * Y0(b, IEN, k, j, i) +
+                        mu_tilde_j * tau * MYjm1 +
+                        gamma_tilde_j * tau * Y0(b).flux(X1DIR, IEN, k, j, i);
+        Yjm2(b, 0, k, j, i) = Yjm1(b, IEN, k, j, i);
+        Yjm1(b, IEN, k, j, i) = Yj;
+      });
+
+  return TaskStatus::complete;
+}
+
+// Coefficients of the super-time-stepping (STS) methods written in the common form
+//   Y_1 = Y_0 + mu_tilde_1 tau M(Y_0) and, for j >= 2,
+//   Y_j = mu_j Y_{j-1} + nu_j Y_{j-2} + (1 - mu_j - nu_j) Y_0
+//         + mu_tilde_j tau M(Y_{j-1}) + gamma_tilde_j tau M(Y_0),
+// with the stability polynomial of stage j being a_j + b_j Q_j(1 + w1 z), where Q_j are
+// Legendre polynomials (RKL1 and RKL2, Meyer+2014) or Gegenbauer polynomials C_j^(3/2)
+// (RKG2, O'Sullivan 2019). The coefficients then follow from the three-term recursion
+// j Q_j(x) = alpha_j x Q_{j-1}(x) - beta_j Q_{j-2}(x) of the polynomials.
+class STSCoeffs {
+ public:
+  // Number of stages so that a step of `tau` is stable given the explicit diffusive
+  // timestep `dt_diff`
+  STSCoeffs(const DiffInt diffint, const Real tau, const Real dt_diff)
+      : diffint_(diffint) {
+    const auto ratio = tau / dt_diff;
+    if (diffint == DiffInt::rkl1) {
+      // tau <= dt_diff (s^2 + s) / 2, Meyer+2014 eq. (12)
+      s_ = static_cast<int>(0.5 * (std::sqrt(1.0 + 8.0 * ratio) - 1.0)) + 1;
+    } else if (diffint == DiffInt::rkl2) {
+      // tau <= dt_diff (s^2 + s - 2) / 4, Meyer+2014 eq. (21)
+      s_ = static_cast<int>(0.5 * (std::sqrt(9.0 + 16.0 * ratio) - 1.0)) + 1;
+    } else if (diffint == DiffInt::rkg2) {
+      // tau <= dt_diff (s + 4) (s - 1) / 6
+      s_ = static_cast<int>(0.5 * (std::sqrt(25.0 + 24.0 * ratio) - 3.0)) + 1;
+    } else {
+      PARTHENON_THROW("Unknown super-time-stepping method.");
+    }
+    // ensure odd number of stages
+    if (s_ % 2 == 0) s_ += 1;
+
+    const auto s = static_cast<Real>(s_);
+    if (diffint == DiffInt::rkl1) {
+      w1_ = 2.0 / (s * s + s);
+    } else if (diffint == DiffInt::rkl2) {
+      w1_ = 4.0 / (s * s + s - 2.0);
+    } else {
+      w1_ = 6.0 / ((s + 4.0) * (s - 1.0));
+    }
+  }
+
+  int NumStages() const { return s_; }
+
+  Real MuTilde1() const { return b(1) * Q1(1) * w1_; }
+
+  // Coefficients of stage j >= 2
+  void Stage(const int jj, Real &mu_j, Real &nu_j, Real &mu_tilde_j,
+             Real &gamma_tilde_j) const {
+    const auto j = static_cast<Real>(jj);
+    const bool gegenbauer = diffint_ == DiffInt::rkg2;
+    const auto alpha_j = gegenbauer ? (2.0 * j + 1.0) : (2.0 * j - 1.0);
+    const auto beta_j = gegenbauer ? (j + 1.0) : (j - 1.0);
+    mu_j = alpha_j / j * b(jj) / b(jj - 1);
+    nu_j = -beta_j / j * b(jj) / b(jj - 2);
+    mu_tilde_j = mu_j * w1_;
+    gamma_tilde_j = -(1.0 - b(jj - 1) * Q1(jj - 1)) * mu_tilde_j; // -a_{j-1} mu_tilde_j
+  }
+
+ private:
+  // b_j (with b_0 = b_1 = b_2 for the second order methods)
+  Real b(const int jj) const {
+    const auto j = static_cast<Real>(std::max(jj, 2));
+    if (diffint_ == DiffInt::rkl1) {
+      return 1.0;
+    } else if (diffint_ == DiffInt::rkl2) {
+      return (j * j + j - 2.0) / (2.0 * j * (j + 1.0)); // Meyer+2014 eq. (16)
+    }
+    return 4.0 * (j - 1.0) * (j + 4.0) / (3.0 * j * (j + 1.0) * (j + 2.0) * (j + 3.0));
+  }
+  // Q_j(1)
+  Real Q1(const int jj) const {
+    const auto j = static_cast<Real>(jj);
+    return diffint_ == DiffInt::rkg2 ? 0.5 * (j + 1.0) * (j + 2.0) : 1.0;
+  }
+
+  DiffInt diffint_;
+  int s_;
+  Real w1_;
+};
+
+// Same tasks as parthenon::AddBoundaryExchangeTasks (i.e., update ghost cells (local and
+// non local), prolongate and apply boundary conditions) but with each task wrapped in
+// the task timers (with labels starting with `prefix`) so that, e.g., the time spent
+// waiting for the ghost zones is recorded in "ReceiveBoundBufs".
+TaskID AddTimedBoundaryExchangeTasks(TaskID dependency, parthenon::TaskList &tl,
+                                     std::shared_ptr<MeshData<Real>> &md,
+                                     const bool multilevel, TaskTimers *timers,
+                                     const std::string &prefix = "") {
+  const auto any = parthenon::BoundaryType::any;
+  const auto apply_bcs = parthenon::ApplyBoundaryConditionsOnCoarseOrFineMD;
+  tl.AddTask(dependency,
+             timers->Timed(prefix + "SendBoundBufs", parthenon::SendBoundBufs<any>), md);
+  auto recv = tl.AddTask(
+      dependency,
+      timers->Timed(prefix + "ReceiveBoundBufs", parthenon::ReceiveBoundBufs<any>), md);
+  auto set = tl.AddTask(
+      recv, timers->Timed(prefix + "SetBounds", parthenon::SetBounds<any>), md);
+  auto pro = set;
+  if (multilevel) {
+    auto cbound = tl.AddTask(
+        set, timers->Timed(prefix + "ApplyBoundaryConditionsCoarse", apply_bcs), md,
+        true);
+    pro = tl.AddTask(
+        cbound,
+        timers->Timed(prefix + "ProlongateBounds", parthenon::ProlongateBounds<any>), md);
+  }
+  return tl.AddTask(pro, timers->Timed(prefix + "ApplyBoundaryConditions", apply_bcs),
+                    md, false);
+}
+
 // Assumes that prim and cons are in sync initially.
 // Guarantees that prim and cons are in sync at the end.
 void AddSTSTasks(TaskCollection *ptask_coll, Mesh *pmesh, BlockList_t &blocks,
@@ -211,53 +517,22 @@ void AddSTSTasks(TaskCollection *ptask_coll, Mesh *pmesh, BlockList_t &blocks,
   auto hydro_pkg = blocks[0]->packages.Get("Hydro");
   auto mindt_diff = hydro_pkg->Param<Real>("dt_diff");
 
-  // get number of RKL steps
-  // eq (21) using half hyperbolic timestep due to Strang split
-  int s_rkl =
-      static_cast<int>(0.5 * (std::sqrt(9.0 + 16.0 * tau / mindt_diff) - 1.0)) + 1;
-  // ensure odd number of stages
-  if (s_rkl % 2 == 0) s_rkl += 1;
+  // get number of STS stages using half hyperbolic timestep due to Strang split
+  const STSCoeffs sts_coeffs(hydro_pkg->Param<DiffInt>("diffint"), tau, mindt_diff);
+  const int s_sts = sts_coeffs.NumStages();
 
   if (parthenon::Globals::my_rank == 0) {
     const auto ratio = 2.0 * tau / mindt_diff;
-    std::cout << "STS ratio: " << ratio << " Taking " << s_rkl << " steps." << std::endl;
+    std::cout << "STS ratio: " << ratio << " Taking " << s_sts << " steps." << std::endl;
     if (ratio > 400.1) {
       std::cout << "WARNING: ratio is > 400. Proceed at own risk." << std::endl;
     }
   }
 
-  TaskID none(0);
-
-  // Store initial u0 in u1 as "base" will continuously be updated but initial state Y0 is
-  // required for each stage.
-  TaskRegion &region_copy_out = ptask_coll->AddRegion(blocks.size());
-  for (int i = 0; i < blocks.size(); i++) {
-    auto &tl = region_copy_out[i];
-    auto &Y0 = blocks[i]->meshblock_data.Get("u1");
-    auto &base = blocks[i]->meshblock_data.Get();
-    tl.AddTask(
-        none,
-        [](MeshBlockData<Real> *dst, MeshBlockData<Real> *src) {
-          dst->Get("cons").data.DeepCopy(src->Get("cons").data);
-          dst->Get("prim").data.DeepCopy(src->Get("prim").data);
-          return TaskStatus::complete;
-        },
-        Y0.get(), base.get());
-  }
-
-  TaskRegion &region_init = ptask_coll->AddRegion(blocks.size());
-  for (int i = 0; i < blocks.size(); i++) {
-    auto &pmb = blocks[i];
-    auto &tl = region_init[i];
-    auto &base = pmb->meshblock_data.Get();
+  // Wallclock timers of the individual tasks, see `task_timers.hpp`
+  auto *timers = hydro_pkg->MutableParam<TaskTimers>("task_timers");
 
-    // Add extra registers. No-op for existing variables so it's safe to call every
-    // time.
-    // TODO(pgrete) this allocates all Variables, i.e., prim and cons vector, but only a
-    // subset is actually needed. Streamline to allocate only required vars.
-    pmb->meshblock_data.Add("MY0", base);
-    pmb->meshblock_data.Add("Yjm2", base);
-  }
+  TaskID none(0);
 
   const int num_partitions = pmesh->DefaultNumPartitions();
   TaskRegion &region_calc_fluxes_step_init = ptask_coll->AddRegion(num_partitions);
@@ -265,68 +540,70 @@ void AddSTSTasks(TaskCollection *ptask_coll, Mesh *pmesh, BlockList_t &blocks,
     auto &tl = region_calc_fluxes_step_init[i];
     auto &base = pmesh->mesh_data.GetOrAdd("base", i);
     const auto any = parthenon::BoundaryType::any;
-    auto start_bnd = tl.AddTask(none, parthenon::StartReceiveBoundBufs<any>, base);
-    auto start_flxcor_recv =
-        tl.AddTask(none, parthenon::StartReceiveFluxCorrections, base);
+    auto start_bnd = tl.AddTask(none,
+                                timers->Timed("STS/StartReceiveBoundBufs",
+                                              parthenon::StartReceiveBoundBufs<any>),
+                                base);
+    auto start_flxcor_recv = tl.AddTask(
+        none,
+        timers->Timed("STS/StartReceiveFluxCorrections",
+                      parthenon::StartReceiveFluxCorrections),
+        base);
 
     // Reset flux arrays (not guaranteed to be zero)
-    auto reset_fluxes = tl.AddTask(none, ResetFluxes, base.get());
+    auto reset_fluxes =
+        tl.AddTask(none, timers->Timed("STS/ResetFluxes", ResetFluxes), base.get());
 
     // Calculate the diffusive fluxes for Y0 (here still "base" as nothing has been
-    // updated yet) so that we can store the result as MY0 and reuse later
-    // (in every subsetp).
+    // updated yet) so that we can store the resulting MY0 and reuse it later
+    // (in every substep).
     auto hydro_diff_fluxes =
-        tl.AddTask(reset_fluxes, CalcDiffFluxes, hydro_pkg.get(), base.get());
-
-    auto send_flx =
-        tl.AddTask(hydro_diff_fluxes, parthenon::LoadAndSendFluxCorrections, base);
-    auto recv_flx =
-        tl.AddTask(start_flxcor_recv, parthenon::ReceiveFluxCorrections, base);
-    auto set_flx =
-        tl.AddTask(recv_flx | hydro_diff_fluxes, parthenon::SetFluxCorrections, base);
+        tl.AddTask(reset_fluxes, timers->Timed("STS/CalcDiffFluxes", CalcDiffFluxes),
+                   hydro_pkg.get(), base.get());
+
+    auto send_flx = tl.AddTask(hydro_diff_fluxes,
+                               timers->Timed("STS/LoadAndSendFluxCorrections",
+                                             parthenon::LoadAndSendFluxCorrections),
+                               base);
+    auto recv_flx = tl.AddTask(
+        start_flxcor_recv,
+        timers->Timed("STS/ReceiveFluxCorrections", parthenon::ReceiveFluxCorrections),
+        base);
+    auto set_flx = tl.AddTask(
+        recv_flx | hydro_diff_fluxes,
+        timers->Timed("STS/SetFluxCorrections", parthenon::SetFluxCorrections), base);
 
     auto &Y0 = pmesh->mesh_data.GetOrAdd("u1", i);
-    auto &MY0 = pmesh->mesh_data.GetOrAdd("MY0", i);
-    auto &Yjm2 = pmesh->mesh_data.GetOrAdd("Yjm2", i);
-
-    auto init_MY0 = tl.AddTask(set_flx, parthenon::Update::FluxDivergence<MeshData<Real>>,
-                               base.get(), MY0.get());
 
-    // Initialize Y0 and Y1 and the recursion relation starting with j = 2 needs data from
-    // the two preceeding stages.
-    auto rkl2_step_first = tl.AddTask(init_MY0, RKL2StepFirst, Y0.get(), base.get(),
-                                      Yjm2.get(), MY0.get(), s_rkl, tau);
+    // Store Y0 and MY0 (in "u1"), and initialize Y1 and the recursion relation starting
+    // with j = 2 needs data from the two preceeding stages.
+    auto sts_step_first =
+        tl.AddTask(set_flx, timers->Timed("STS/STSStepFirst", STSStepFirst), Y0.get(),
+                   base.get(), sts_coeffs.MuTilde1(), tau);
 
     // Update ghost cells of Y1 (as MY1 is calculated for each Y_j).
-    // Y1 stored in "base", see rkl2_step_first task.
+    // Y1 stored in "base", see sts_step_first task.
     // Update ghost cells (local and non local), prolongate and apply bound cond.
     // TODO(someone) experiment with split (local/nonlocal) comms with respect to
     // performance for various tests (static, amr, block sizes) and then decide on the
     // best impl. Go with default call (split local/nonlocal) for now.
     // TODO(pgrete) optimize (in parthenon) to only send subset of updated vars
-    auto bounds_exchange = parthenon::AddBoundaryExchangeTasks(
-        rkl2_step_first | start_bnd, tl, base, pmesh->multilevel);
+    auto bounds_exchange = AddTimedBoundaryExchangeTasks(
+        sts_step_first | start_bnd, tl, base, pmesh->multilevel, timers, "STS/");
 
-    tl.AddTask(bounds_exchange, parthenon::Update::FillDerived<MeshData<Real>>,
+    tl.AddTask(bounds_exchange,
+               timers->Timed("STS/FillDerived",
+                             parthenon::Update::FillDerived<MeshData<Real>>),
                base.get());
   }
 
-  // Compute coefficients. Meyer+2012 eq. (16)
-  Real b_j = 1. / 3.;
-  Real b_jm1 = 1. / 3.;
-  Real b_jm2 = 1. / 3.;
-  Real w1 = 4. / (static_cast<Real>(s_rkl) * static_cast<Real>(s_rkl) +
-                  static_cast<Real>(s_rkl) - 2.);
-  Real mu_j, nu_j, j, mu_tilde_j, gamma_tilde_j;
+  Real mu_j, nu_j, mu_tilde_j, gamma_tilde_j;
 
-  // RKL loop
-  for (int jj = 2; jj <= s_rkl; jj++) {
-    j = static_cast<Real>(jj);
-    b_j = (j * j + j - 2.0) / (2 * j * (j + 1.0));
-    mu_j = (2.0 * j - 1.0) / j * b_j / b_jm1;
-    nu_j = -(j - 1.0) / j * b_j / b_jm2;
-    mu_tilde_j = mu_j * w1;
-    gamma_tilde_j = -(1.0 - b_jm1) * mu_tilde_j; // -a_jm1*mu_tilde_j
+  const bool fused_stage = UseFusedSTSStage(pmesh, hydro_pkg.get());
+
+  // STS loop
+  for (int jj = 2; jj <= s_sts; jj++) {
+    sts_coeffs.Stage(jj, mu_j, nu_j, mu_tilde_j, gamma_tilde_j);
 
     TaskRegion &region_calc_fluxes_step_other = ptask_coll->AddRegion(num_partitions);
     for (int i = 0; i < num_partitions; i++) {
@@ -337,31 +614,50 @@ void AddSTSTasks(TaskCollection *ptask_coll, Mesh *pmesh, BlockList_t &blocks,
       // data/fluxes with neighbors. All other containers are passive (i.e., data is only
       // used but not exchanged).
       const auto any = parthenon::BoundaryType::any;
-      auto start_bnd = tl.AddTask(none, parthenon::StartReceiveBoundBufs<any>, base);
-      auto start_flxcor_recv =
-          tl.AddTask(none, parthenon::StartReceiveFluxCorrections, base);
-
-      // Reset flux arrays (not guaranteed to be zero)
-      auto reset_fluxes = tl.AddTask(none, ResetFluxes, base.get());
-
-      // Calculate the diffusive fluxes for Yjm1 (here u1)
-      auto hydro_diff_fluxes =
-          tl.AddTask(reset_fluxes, CalcDiffFluxes, hydro_pkg.get(), base.get());
-
-      auto send_flx =
-          tl.AddTask(hydro_diff_fluxes, parthenon::LoadAndSendFluxCorrections, base);
-      auto recv_flx =
-          tl.AddTask(start_flxcor_recv, parthenon::ReceiveFluxCorrections, base);
-      auto set_flx =
-          tl.AddTask(recv_flx | hydro_diff_fluxes, parthenon::SetFluxCorrections, base);
+      auto start_bnd = tl.AddTask(none,
+                                  timers->Timed("STS/StartReceiveBoundBufs",
+                                                parthenon::StartReceiveBoundBufs<any>),
+                                  base);
 
       auto &Y0 = pmesh->mesh_data.GetOrAdd("u1", i);
-      auto &MY0 = pmesh->mesh_data.GetOrAdd("MY0", i);
-      auto &Yjm2 = pmesh->mesh_data.GetOrAdd("Yjm2", i);
 
-      auto rkl2_step_other =
-          tl.AddTask(set_flx, RKL2StepOther, Y0.get(), base.get(), Yjm2.get(), MY0.get(),
-                     mu_j, nu_j, mu_tilde_j, gamma_tilde_j, tau);
+      auto sts_step_other = none;
+      if (fused_stage) {
+        sts_step_other =
+            tl.AddTask(none, timers->Timed("STS/STSStepOtherFused", STSStepOtherFused),
+                       Y0.get(), base.get(), mu_j, nu_j, mu_tilde_j, gamma_tilde_j, tau);
+      } else {
+        auto start_flxcor_recv = tl.AddTask(
+            none,
+            timers->Timed("STS/StartReceiveFluxCorrections",
+                          parthenon::StartReceiveFluxCorrections),
+            base);
+
+        // Reset flux arrays (not guaranteed to be zero)
+        auto reset_fluxes =
+            tl.AddTask(none, timers->Timed("STS/ResetFluxes", ResetFluxes), base.get());
+
+        // Calculate the diffusive fluxes for Yjm1 (here "base")
+        auto hydro_diff_fluxes =
+            tl.AddTask(reset_fluxes, timers->Timed("STS/CalcDiffFluxes", CalcDiffFluxes),
+                       hydro_pkg.get(), base.get());
+
+        auto send_flx = tl.AddTask(hydro_diff_fluxes,
+                                   timers->Timed("STS/LoadAndSendFluxCorrections",
+                                                 parthenon::LoadAndSendFluxCorrections),
+                                   base);
+        auto recv_flx = tl.AddTask(start_flxcor_recv,
+                                   timers->Timed("STS/ReceiveFluxCorrections",
+                                                 parthenon::ReceiveFluxCorrections),
+                                   base);
+        auto set_flx = tl.AddTask(
+            recv_flx | hydro_diff_fluxes,
+            timers->Timed("STS/SetFluxCorrections", parthenon::SetFluxCorrections), base);
+
+        sts_step_other =
+            tl.AddTask(set_flx, timers->Timed("STS/STSStepOther", STSStepOther), Y0.get(),
+                       base.get(), mu_j, nu_j, mu_tilde_j, gamma_tilde_j, tau);
+      }
 
       // update ghost cells of base (currently storing Yj)
       // Update ghost cells (local and non local), prolongate and apply bound cond.
@@ -369,22 +665,86 @@ void AddSTSTasks(TaskCollection *ptask_coll, Mesh *pmesh, BlockList_t &blocks,
       // performance for various tests (static, amr, block sizes) and then decide on the
       // best impl. Go with default call (split local/nonlocal) for now.
       // TODO(pgrete) optimize (in parthenon) to only send subset of updated vars
-      auto bounds_exchange = parthenon::AddBoundaryExchangeTasks(
-          rkl2_step_other | start_bnd, tl, base, pmesh->multilevel);
+      auto bounds_exchange = AddTimedBoundaryExchangeTasks(
+          sts_step_other | start_bnd, tl, base, pmesh->multilevel, timers, "STS/");
 
-      tl.AddTask(bounds_exchange, parthenon::Update::FillDerived<MeshData<Real>>,
+      tl.AddTask(bounds_exchange,
+                 timers->Timed("STS/FillDerived",
+                               parthenon::Update::FillDerived<MeshData<Real>>),
                  base.get());
     }
+  }
+}
 
-    b_jm2 = b_jm1;
-    b_jm1 = b_j;
+// Adds the tasks for the local reductions (and to start the global reduction) of the
+// `StepReductions` param `registry` of the "Hydro" package to the task collection (in a
+// single region). The global reduction is in flight until the tasks added by
+// AddStepReductionsFinishTasks() (in a later region), so that work that neither reads
+// nor writes the state modified by the finalize functions can be added to the regions
+// in between.
+void AddStepReductionsStartTasks(TaskCollection *ptask_coll, Mesh *pmesh,
+                                 StateDescriptor *hydro_pkg, const SimTime &tm,
+                                 const std::string &registry) {
+  TaskID none(0);
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  auto *timers = hydro_pkg->MutableParam<TaskTimers>("task_timers");
+
+  // need to make sure that there's only one region in order to MPI_reduce to work
+  TaskRegion &single_task_region = ptask_coll->AddRegion(1);
+  auto &tl = single_task_region[0];
+  auto prev_task =
+      tl.AddTask(none, timers->Timed(registry + "/Reset", StepReductionsReset),
+                 hydro_pkg, tm, registry);
+
+  // Adding one task for each partition. Not using a (new) single partition containing
+  // all blocks here as this (default) split is also used for the following tasks and
+  // thus does not create an overhead (such as creating a new MeshBlockPack that is just
+  // used here). Given that all partitions are in one task list they'll be executed
+  // sequentially. Given that a par_reduce to a host var is blocking it's also save to
+  // store the variable in the Params for now.
+  for (int i = 0; i < num_partitions; i++) {
+    auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
+    prev_task =
+        tl.AddTask(prev_task, timers->Timed(registry + "/Local", StepReductionsLocal),
+                   mu0.get(), tm, registry);
   }
+  // All quantities are reduced in a single non-blocking reduction
+  tl.AddTask(prev_task, timers->Timed(registry + "/StartMPI", StepReductionsStartMPI),
+             hydro_pkg, registry);
+}
+
+// Adds the tasks waiting for the global reduction started by
+// AddStepReductionsStartTasks() and using the reduced quantities (in a single region).
+void AddStepReductionsFinishTasks(TaskCollection *ptask_coll, Mesh *pmesh,
+                                  StateDescriptor *hydro_pkg, const SimTime &tm,
+                                  const std::string &registry) {
+  TaskID none(0);
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  auto *timers = hydro_pkg->MutableParam<TaskTimers>("task_timers");
+
+  TaskRegion &single_task_region = ptask_coll->AddRegion(1);
+  auto &tl = single_task_region[0];
+  auto prev_task =
+      tl.AddTask(none, timers->Timed(registry + "/FinishMPI", StepReductionsFinishMPI),
+                 hydro_pkg, registry);
+
+  for (int i = 0; i < num_partitions; i++) {
+    auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
+    prev_task = tl.AddTask(
+        prev_task,
+        timers->Timed(registry + "/FinalizePartition", StepReductionsFinalizePartition),
+        mu0.get(), tm, registry);
+  }
+  tl.AddTask(prev_task, timers->Timed(registry + "/Finalize", StepReductionsFinalize),
+             hydro_pkg, tm, registry);
 }
 
 // See the advection.hpp declaration for a description of how this function gets called.
 TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
   TaskCollection tc;
   auto hydro_pkg = blocks[0]->packages.Get("Hydro");
+  // Wallclock timers of the individual tasks, see `task_timers.hpp`
+  auto *timers = hydro_pkg->MutableParam<TaskTimers>("task_timers");
 
   TaskID none(0);
   // Number of task lists that can be executed indepenently and thus *may*
@@ -395,40 +755,16 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
 
   const int num_partitions = pmesh->DefaultNumPartitions();
 
-  // calculate agn triggering accretion rate
-  if ((stage == 1) &&
-      hydro_pkg->AllParams().hasKey("agn_triggering_reduce_accretion_rate") &&
-      hydro_pkg->Param<bool>("agn_triggering_reduce_accretion_rate")) {
-
-    // need to make sure that there's only one region in order to MPI_reduce to work
-    TaskRegion &single_task_region = tc.AddRegion(1);
-    auto &tl = single_task_region[0];
-    // First globally reset triggering quantities
-    auto prev_task =
-        tl.AddTask(none, cluster::AGNTriggeringResetTriggering, hydro_pkg.get());
-
-    // Adding one task for each partition. Given that they're all in one task list
-    // they'll be executed sequentially. Given that a par_reduce to a host var is
-    // blocking it's also save to store the variable in the Params for now.
-    for (int i = 0; i < num_partitions; i++) {
-      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      auto new_agn_triggering =
-          tl.AddTask(prev_task, cluster::AGNTriggeringReduceTriggering, mu0.get(), tm.dt);
-      prev_task = new_agn_triggering;
-    }
-#ifdef MPI_PARALLEL
-    auto reduce_agn_triggering =
-        tl.AddTask(prev_task, cluster::AGNTriggeringMPIReduceTriggering, hydro_pkg.get());
-    prev_task = reduce_agn_triggering;
-#endif
-
-    // Remove accreted gas
-    for (int i = 0; i < num_partitions; i++) {
-      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      auto new_remove_accreted_gas =
-          tl.AddTask(prev_task, cluster::AGNTriggeringFinalizeTriggering, mu0.get(), tm);
-      prev_task = new_remove_accreted_gas;
-    }
+  // Global reductions registered by the hydro package and problem generators, e.g., the
+  // AGN triggering accretion rate or the minimum dx for the divergence cleaning speed.
+  // The finalize functions may modify the state (e.g., the removal of the gas accreted
+  // by the AGN from `cons` and `prim` of u0), so they need to be finished before any
+  // other task reads or writes the state, i.e., before the operator split terms and the
+  // initialization of u1 below. Thus, there is no independent work to overlap the
+  // global reduction with in the first stage.
+  if (stage == 1 && !hydro_pkg->Param<StepReductions>("step_reductions").IsEmpty()) {
+    AddStepReductionsStartTasks(&tc, pmesh, hydro_pkg.get(), tm, "step_reductions");
+    AddStepReductionsFinishTasks(&tc, pmesh, hydro_pkg.get(), tm, "step_reductions");
   }
 
   for (int i = 0; i < blocks.size(); i++) {
@@ -436,108 +772,12 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     // Using "base" as u0, which already exists (and returned by using plain Get())
     auto &u0 = pmb->meshblock_data.Get();
 
-    // Create meshblock data for register u1.
+    // Create meshblock data for register u1 (only containing the required variables).
     // This is a noop if u1 already exists.
     // TODO(pgrete) update to derive from other quanity as u1 does not require fluxes
     if (stage == 1) {
-      pmb->meshblock_data.Add("u1", u0);
-    }
-  }
-
-  // Calculate hyperbolic divergence cleaning speed
-  // TODO(pgrete) Calculating mindx is only required after remeshing. Need to find a clean
-  // solution for this one-off global reduction.
-  // TODO(PG) move this to PreStepMeshUserWorkInLoop
-  if ((hydro_pkg->Param<bool>("calc_c_h") ||
-       hydro_pkg->Param<DiffInt>("diffint") != DiffInt::none) &&
-      (stage == 1)) {
-    // need to make sure that there's only one region in order to MPI_reduce to work
-    TaskRegion &single_task_region = tc.AddRegion(1);
-    auto &tl = single_task_region[0];
-    // Adding one task for each partition. Not using a (new) single partition containing
-    // all blocks here as this (default) split is also used for the following tasks and
-    // thus does not create an overhead (such as creating a new MeshBlockPack that is just
-    // used here). Given that all partitions are in one task list they'll be executed
-    // sequentially. Given that a par_reduce to a host var is blocking it's also save to
-    // store the variable in the Params for now.
-    auto prev_task = none;
-    for (int i = 0; i < num_partitions; i++) {
-      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      auto new_mindx = tl.AddTask(prev_task, CalculateGlobalMinDx, mu0.get());
-      prev_task = new_mindx;
-    }
-    auto reduce_c_h = prev_task;
-#ifdef MPI_PARALLEL
-    reduce_c_h = tl.AddTask(
-        prev_task,
-        [](StateDescriptor *hydro_pkg) {
-          Real mins[3];
-          mins[0] = hydro_pkg->Param<Real>("mindx");
-          mins[1] = hydro_pkg->Param<Real>("dt_hyp");
-          mins[2] = hydro_pkg->Param<Real>("dt_diff");
-          PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, mins, 3, MPI_PARTHENON_REAL,
-                                            MPI_MIN, MPI_COMM_WORLD));
-
-          hydro_pkg->UpdateParam("mindx", mins[0]);
-          hydro_pkg->UpdateParam("dt_hyp", mins[1]);
-          hydro_pkg->UpdateParam("dt_diff", mins[2]);
-          return TaskStatus::complete;
-        },
-        hydro_pkg.get());
-#endif
-    // Finally update c_h
-    auto update_c_h = tl.AddTask(
-        reduce_c_h,
-        [](StateDescriptor *hydro_pkg) {
-          const auto &mindx = hydro_pkg->Param<Real>("mindx");
-          const auto &cfl_hyp = hydro_pkg->Param<Real>("cfl");
-          const auto &dt_hyp = hydro_pkg->Param<Real>("dt_hyp");
-          hydro_pkg->UpdateParam("c_h", cfl_hyp * mindx / dt_hyp);
-          return TaskStatus::complete;
-        },
-        hydro_pkg.get());
-  }
-
-  // calculate magnetic tower scaling
-  if ((stage == 1) && hydro_pkg->AllParams().hasKey("magnetic_tower_power_scaling") &&
-      hydro_pkg->Param<bool>("magnetic_tower_power_scaling")) {
-    const auto &magnetic_tower =
-        hydro_pkg->Param<cluster::MagneticTower>("magnetic_tower");
-
-    // need to make sure that there's only one region in order to MPI_reduce to work
-    TaskRegion &single_task_region = tc.AddRegion(1);
-    auto &tl = single_task_region[0];
-    // First globally reset magnetic_tower_linear_contrib and
-    // magnetic_tower_quadratic_contrib
-    auto prev_task =
-        tl.AddTask(none, cluster::MagneticTowerResetPowerContribs, hydro_pkg.get());
-
-    // Adding one task for each partition. Given that they're all in one task list
-    // they'll be executed sequentially. Given that a par_reduce to a host var is
-    // blocking it's also save to store the variable in the Params for now.
-    for (int i = 0; i < num_partitions; i++) {
-      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      auto new_magnetic_tower_power_contrib =
-          tl.AddTask(prev_task, cluster::MagneticTowerReducePowerContribs, mu0.get(), tm);
-      prev_task = new_magnetic_tower_power_contrib;
+      pmb->meshblock_data.Add("u1", u0, GetRegisterFields(hydro_pkg.get(), "u1"));
     }
-#ifdef MPI_PARALLEL
-    auto reduce_magnetic_tower_power_contrib = tl.AddTask(
-        prev_task,
-        [](StateDescriptor *hydro_pkg) {
-          Real magnetic_tower_contribs[] = {
-              hydro_pkg->Param<Real>("magnetic_tower_linear_contrib"),
-              hydro_pkg->Param<Real>("magnetic_tower_quadratic_contrib")};
-          PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, magnetic_tower_contribs, 2,
-                                            MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
-          hydro_pkg->UpdateParam("magnetic_tower_linear_contrib",
-                                 magnetic_tower_contribs[0]);
-          hydro_pkg->UpdateParam("magnetic_tower_quadratic_contrib",
-                                 magnetic_tower_contribs[1]);
-          return TaskStatus::complete;
-        },
-        hydro_pkg.get());
-#endif
   }
 
   // First add split sources before the main time integration
@@ -545,7 +785,7 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     // If any tasks modify the conserved variables before this place, then
     // the STS tasks should be updated to not assume prim and cons are in sync.
     const auto &diffint = hydro_pkg->Param<DiffInt>("diffint");
-    if (diffint == DiffInt::rkl2) {
+    if (IsSTS(diffint)) {
       AddSTSTasks(&tc, pmesh, blocks, 0.5 * tm.dt);
     }
     TaskRegion &strang_init_region = tc.AddRegion(num_partitions);
@@ -558,7 +798,8 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
       // the source term is applied to all active registers in the flux calculation.
       // IMPORTANT 2: The tasks should work using `cons` variables as input as in the
       // final step, `prim` are not updated yet from the flux calculation.
-      tl.AddTask(none, AddSplitSourcesStrang, mu0.get(), tm);
+      tl.AddTask(none, timers->Timed("AddSplitSourcesStrang", AddSplitSourcesStrang),
+                 mu0.get(), tm);
     }
   }
 
@@ -573,19 +814,41 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
       auto &u1 = pmb->meshblock_data.Get("u1");
       auto init_u1 = tl.AddTask(
           none,
-          [](MeshBlockData<Real> *u0, MeshBlockData<Real> *u1, bool copy_prim) {
-            u1->Get("cons").data.DeepCopy(u0->Get("cons").data);
-            if (copy_prim) {
-              u1->Get("prim").data.DeepCopy(u0->Get("prim").data);
-            }
-            return TaskStatus::complete;
-          },
+          timers->Timed("InitU1",
+                        [](MeshBlockData<Real> *u0, MeshBlockData<Real> *u1,
+                           bool copy_prim) {
+                          u1->Get("cons").data.DeepCopy(u0->Get("cons").data);
+                          if (copy_prim) {
+                            u1->Get("prim").data.DeepCopy(u0->Get("prim").data);
+                          }
+                          return TaskStatus::complete;
+                        }),
           // First order flux correction needs the original prim variables in the
           // during the correction.
           u0.get(), u1.get(), hydro_pkg->Param<bool>("first_order_flux_correct"));
     }
   }
 
+  // Overlap the flux calculation with the ghost zone exchange between stages, see
+  // `hydro/overlap_flux_comm`.
+  const auto overlap_flux_comm = hydro_pkg->Param<bool>("overlap_flux_comm");
+
+  // First order split source terms that depend on global reductions (e.g., turbulence
+  // driving) are applied in separate regions after the final stage so that the ghost
+  // zone exchange needs to be deferred, too.
+  const auto split_source_reductions =
+      stage == integrator->nstages &&
+      !hydro_pkg->Param<StepReductions>("split_source_reductions").IsEmpty();
+
+  // The (reused) buffers of the first order flux correction are stored per partition,
+  // which may have changed with the mesh
+  if (hydro_pkg->Param<bool>("first_order_flux_correct")) {
+    hydro_pkg
+        ->MutableParam<std::vector<FirstOrderFluxCorrectBuffers>>(
+            "first_order_flux_correct_buffers")
+        ->resize(num_partitions);
+  }
+
   // note that task within this region that contains one tasklist per pack
   // could still be executed in parallel
   TaskRegion &single_tasklist_per_pack_region = tc.AddRegion(num_partitions);
@@ -595,13 +858,58 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     auto &mu1 = pmesh->mesh_data.GetOrAdd("u1", i);
 
     const auto any = parthenon::BoundaryType::any;
-    auto start_bnd = tl.AddTask(none, parthenon::StartReceiveBoundBufs<any>, mu0);
-    auto start_flxcor_recv =
-        tl.AddTask(none, parthenon::StartReceiveFluxCorrections, mu0);
-
-    const auto flux_str = (stage == 1) ? "flux_first_stage" : "flux_other_stage";
-    FluxFun_t *calc_flux_fun = hydro_pkg->Param<FluxFun_t *>(flux_str);
-    auto calc_flux = tl.AddTask(none, calc_flux_fun, mu0);
+    auto start_flxcor_recv = tl.AddTask(
+        none,
+        timers->Timed("StartReceiveFluxCorrections",
+                      parthenon::StartReceiveFluxCorrections),
+        mu0);
+
+    auto start_bnd = none;
+    auto calc_flux = none;
+    if (overlap_flux_comm && stage > 1) {
+      // The ghost zones sent at the end of the previous stage are still in flight, so
+      // calculate all fluxes that do not depend on ghost zones first.
+      auto calc_flux_interior = tl.AddTask(
+          none,
+          timers->Timed("CalculateFluxesInterior",
+                        hydro_pkg->Param<FluxFun_t *>("flux_interior")),
+          mu0);
+
+      auto recv_bnd = tl.AddTask(
+          none, timers->Timed("ReceiveBoundBufs", parthenon::ReceiveBoundBufs<any>), mu0);
+      auto set_bnd = tl.AddTask(
+          recv_bnd, timers->Timed("SetBounds", parthenon::SetBounds<any>), mu0);
+      auto bcs_bnd = tl.AddTask(
+          set_bnd,
+          timers->Timed("ApplyBoundaryConditions",
+                        parthenon::ApplyBoundaryConditionsOnCoarseOrFineMD),
+          mu0, false);
+      // `prim` of the interior cells has already been updated in FillDerived of the
+      // previous stage.
+      auto fill_derived_bnd = tl.AddTask(
+          bcs_bnd,
+          timers->Timed("ConsToPrimGhosts", hydro_pkg->Param<ConsToPrimGhostsFun_t *>(
+                                                "cons_to_prim_ghosts_fun")),
+          mu0.get());
+      calc_flux = tl.AddTask(calc_flux_interior | fill_derived_bnd,
+                             timers->Timed("CalculateFluxesShell",
+                                           hydro_pkg->Param<FluxFun_t *>("flux_shell")),
+                             mu0);
+      // Only post the receives for this stage once the previous ones are done so that
+      // the buffers are not reused while still being unpacked.
+      start_bnd = tl.AddTask(
+          set_bnd,
+          timers->Timed("StartReceiveBoundBufs", parthenon::StartReceiveBoundBufs<any>),
+          mu0);
+    } else {
+      start_bnd = tl.AddTask(
+          none,
+          timers->Timed("StartReceiveBoundBufs", parthenon::StartReceiveBoundBufs<any>),
+          mu0);
+      const auto flux_str = (stage == 1) ? "flux_first_stage" : "flux_other_stage";
+      FluxFun_t *calc_flux_fun = hydro_pkg->Param<FluxFun_t *>(flux_str);
+      calc_flux = tl.AddTask(none, timers->Timed("CalculateFluxes", calc_flux_fun), mu0);
+    }
 
     // TODO(pgrete) figure out what to do about the sources from the first stage
     // that are potentially disregarded when the (m)hd fluxes are corrected in the second
@@ -610,30 +918,38 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     if (hydro_pkg->Param<bool>("first_order_flux_correct")) {
       auto *first_order_flux_correct_fun =
           hydro_pkg->Param<FirstOrderFluxCorrectFun_t *>("first_order_flux_correct_fun");
-      first_order_flux_correct =
-          tl.AddTask(calc_flux, first_order_flux_correct_fun, mu0.get(), mu1.get(),
-                     integrator->gam0[stage - 1], integrator->gam1[stage - 1],
-                     integrator->beta[stage - 1] * integrator->dt);
+      first_order_flux_correct = tl.AddTask(
+          calc_flux, timers->Timed("FirstOrderFluxCorrect", first_order_flux_correct_fun),
+          mu0.get(), mu1.get(), integrator->gam0[stage - 1], integrator->gam1[stage - 1],
+          integrator->beta[stage - 1] * integrator->dt, i);
     }
 
-    auto send_flx =
-        tl.AddTask(first_order_flux_correct, parthenon::LoadAndSendFluxCorrections, mu0);
-    auto recv_flx = tl.AddTask(start_flxcor_recv, parthenon::ReceiveFluxCorrections, mu0);
-    auto set_flx = tl.AddTask(recv_flx | first_order_flux_correct,
-                              parthenon::SetFluxCorrections, mu0);
+    auto send_flx = tl.AddTask(first_order_flux_correct,
+                               timers->Timed("LoadAndSendFluxCorrections",
+                                             parthenon::LoadAndSendFluxCorrections),
+                               mu0);
+    auto recv_flx = tl.AddTask(
+        start_flxcor_recv,
+        timers->Timed("ReceiveFluxCorrections", parthenon::ReceiveFluxCorrections), mu0);
+    auto set_flx = tl.AddTask(
+        recv_flx | first_order_flux_correct,
+        timers->Timed("SetFluxCorrections", parthenon::SetFluxCorrections), mu0);
 
     // compute the divergence of fluxes of conserved variables
     auto update = tl.AddTask(
-        set_flx, parthenon::Update::UpdateWithFluxDivergence<MeshData<Real>>, mu0.get(),
-        mu1.get(), integrator->gam0[stage - 1], integrator->gam1[stage - 1],
+        set_flx,
+        timers->Timed("UpdateWithFluxDivergence",
+                      parthenon::Update::UpdateWithFluxDivergence<MeshData<Real>>),
+        mu0.get(), mu1.get(), integrator->gam0[stage - 1], integrator->gam1[stage - 1],
         integrator->beta[stage - 1] * integrator->dt);
 
     // Add non-operator split source terms.
     // Note: Directly update the "cons" variables of mu0 based on the "prim" variables
     // of mu0 as the "cons" variables have already been updated in this stage from the
     // fluxes in the previous step.
-    auto source_unsplit = tl.AddTask(update, AddUnsplitSources, mu0.get(), tm,
-                                     integrator->beta[stage - 1] * integrator->dt);
+    auto source_unsplit =
+        tl.AddTask(update, timers->Timed("AddUnsplitSources", AddUnsplitSources),
+                   mu0.get(), tm, integrator->beta[stage - 1] * integrator->dt);
 
     auto source_split_first_order = source_unsplit;
 
@@ -641,23 +957,38 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
       // Add final Strang split source terms, i.e., a dt/2 update
       // IMPORTANT: The tasks should work using `cons` variables as input as in the
       // final step, `prim` are not updated yet from the flux calculation.
-      auto source_split_strang_final =
-          tl.AddTask(source_unsplit, AddSplitSourcesStrang, mu0.get(), tm);
+      auto source_split_strang_final = tl.AddTask(
+          source_unsplit, timers->Timed("AddSplitSourcesStrang", AddSplitSourcesStrang),
+          mu0.get(), tm);
 
       // Add operator split source terms at first order, i.e., full dt update
       // after all stages of the integration.
       // Not recommended for but allows easy "reset" of variable for some
       // problem types, see random blasts.
-      source_split_first_order =
-          tl.AddTask(source_split_strang_final, AddSplitSourcesFirstOrder, mu0.get(), tm);
+      source_split_first_order = tl.AddTask(
+          source_split_strang_final,
+          timers->Timed("AddSplitSourcesFirstOrder", AddSplitSourcesFirstOrder),
+          mu0.get(), tm);
     }
 
-    // Update ghost cells (local and non local), prolongate and apply bound cond.
-    // TODO(someone) experiment with split (local/nonlocal) comms with respect to
-    // performance for various tests (static, amr, block sizes) and then decide on the
-    // best impl. Go with default call (split local/nonlocal) for now.
-    parthenon::AddBoundaryExchangeTasks(source_split_first_order | start_bnd, tl, mu0,
-                                        pmesh->multilevel);
+    if (overlap_flux_comm && stage < integrator->nstages) {
+      // Only send the ghost zones here. They are received (and set) in the next stage
+      // while the fluxes of the interior are calculated, see above.
+      tl.AddTask(source_split_first_order | start_bnd,
+                 timers->Timed("SendBoundBufs", parthenon::SendBoundBufs<any>), mu0);
+    } else if (!split_source_reductions) {
+      // Update ghost cells (local and non local), prolongate and apply bound cond.
+      // TODO(someone) experiment with split (local/nonlocal) comms with respect to
+      // performance for various tests (static, amr, block sizes) and then decide on the
+      // best impl. Go with default call (split local/nonlocal) for now.
+      AddTimedBoundaryExchangeTasks(source_split_first_order | start_bnd, tl, mu0,
+                                    pmesh->multilevel, timers);
+    }
+  }
+
+  if (split_source_reductions) {
+    AddStepReductionsStartTasks(&tc, pmesh, hydro_pkg.get(), tm,
+                                "split_source_reductions");
   }
 
   // Single task in single (serial) region to reset global vars used in reductions in the
@@ -669,26 +1000,50 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     auto &tl = reset_reduction_vars_region[0];
     tl.AddTask(
         none,
-        [](StateDescriptor *hydro_pkg) {
-          hydro_pkg->UpdateParam("mindx", std::numeric_limits<Real>::max());
-          hydro_pkg->UpdateParam("dt_hyp", std::numeric_limits<Real>::max());
-          hydro_pkg->UpdateParam("dt_diff", std::numeric_limits<Real>::max());
-          return TaskStatus::complete;
-        },
+        timers->Timed(
+            "ResetReductionVars",
+            [](StateDescriptor *hydro_pkg) {
+              hydro_pkg->UpdateParam("mindx", std::numeric_limits<Real>::max());
+              hydro_pkg->UpdateParam("dt_hyp", std::numeric_limits<Real>::max());
+              hydro_pkg->UpdateParam("dt_diff", std::numeric_limits<Real>::max());
+              if (hydro_pkg->AllParams().hasKey("conduction_dt_limiter_local")) {
+                hydro_pkg->UpdateParam("conduction_dt_limiter_local",
+                                       ConductionDtLimiter());
+              }
+              return TaskStatus::complete;
+            }),
         hydro_pkg.get());
   }
 
+  if (split_source_reductions) {
+    // All remaining tasks depend on the split source terms applied in the finalize
+    // functions, so only resetting the reduction vars above is done while the
+    // reduction is in flight.
+    AddStepReductionsFinishTasks(&tc, pmesh, hydro_pkg.get(), tm,
+                                 "split_source_reductions");
+
+    // Receives have already been posted above
+    TaskRegion &bnd_exchange_region = tc.AddRegion(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
+      auto &tl = bnd_exchange_region[i];
+      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
+      AddTimedBoundaryExchangeTasks(none, tl, mu0, pmesh->multilevel, timers);
+    }
+  }
+
   TaskRegion &single_tasklist_per_pack_region_3 = tc.AddRegion(num_partitions);
   for (int i = 0; i < num_partitions; i++) {
     auto &tl = single_tasklist_per_pack_region_3[i];
     auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-    auto fill_derived =
-        tl.AddTask(none, parthenon::Update::FillDerived<MeshData<Real>>, mu0.get());
+    auto fill_derived = tl.AddTask(
+        none,
+        timers->Timed("FillDerived", parthenon::Update::FillDerived<MeshData<Real>>),
+        mu0.get());
   }
   const auto &diffint = hydro_pkg->Param<DiffInt>("diffint");
   // If any tasks modify the conserved variables before this place and after FillDerived,
   // then the STS tasks should be updated to not assume prim and cons are in sync.
-  if (diffint == DiffInt::rkl2 && stage == integrator->nstages) {
+  if (IsSTS(diffint) && stage == integrator->nstages) {
     AddSTSTasks(&tc, pmesh, blocks, 0.5 * tm.dt);
   }
 
@@ -697,8 +1052,11 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     for (int i = 0; i < num_partitions; i++) {
       auto &tl = tr[i];
       auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      auto new_dt = tl.AddTask(none, parthenon::Update::EstimateTimestep<MeshData<Real>>,
-                               mu0.get());
+      auto new_dt = tl.AddTask(
+          none,
+          timers->Timed("EstimateTimestep",
+                        parthenon::Update::EstimateTimestep<MeshData<Real>>),
+          mu0.get());
     }
   }
 
@@ -707,8 +1065,9 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     for (int i = 0; i < blocks.size(); i++) {
       auto &tl = async_region_4[i];
       auto &u0 = blocks[i]->meshblock_data.Get("base");
-      auto tag_refine =
-          tl.AddTask(none, parthenon::Refinement::Tag<MeshBlockData<Real>>, u0.get());
+      auto tag_refine = tl.AddTask(
+          none, timers->Timed("Tag", parthenon::Refinement::Tag<MeshBlockData<Real>>),
+          u0.get());
     }
   }
 
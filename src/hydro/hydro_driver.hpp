@@ -25,6 +25,10 @@ class HydroDriver : public MultiStageDriver {
   //       DriverUtils::ConstructAndExecuteBlockTasks (driver.hpp)
   //         AdvectionDriver::MakeTaskList (advection.cpp)
   auto MakeTaskCollection(BlockList_t &blocks, int stage) -> TaskCollection;
+
+ protected:
+  // Writes the task timers of the last (incomplete) interval, see `task_timers.hpp`
+  void PostExecute(parthenon::DriverStatus status) override;
 };
 
 } // namespace Hydro
@@ -0,0 +1,82 @@
+#ifndef HYDRO_MIXED_PRECISION_HPP_
+#define HYDRO_MIXED_PRECISION_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file mixed_precision.hpp
+//  \brief Single precision copy of the primitive variables used as input to the flux
+//  calculation (only used if compiled with AthenaPK_ENABLE_MIXED_PRECISION=ON)
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+namespace Hydro {
+
+// Parthenon variables are always stored as `Real`, so the single precision primitive
+// variables are stored pairwise (as two floats) in the `Real` field "prim_sp" with
+// (nprim + 1) / 2 components. Only arithmetic is done in `Real`, i.e., the values are
+// rounded to single precision when stored and converted back when loaded.
+// The pairs are (un)packed with Kokkos::bit_cast (i.e., the `Real` storage is never
+// accessed through a float pointer, which would violate strict aliasing).
+struct FloatPair {
+  float v[2];
+};
+static_assert(sizeof(parthenon::Real) == sizeof(FloatPair),
+              "Mixed precision requires double precision Real.");
+
+// Number of `Real` components of the "prim_sp" field
+inline int NumPrimSPComponents(const int nprim) { return (nprim + 1) / 2; }
+
+// Store all `nprim` primitive variables of cell k,j,i from `prim` in `prim_sp`.
+// To be called directly after the primitive variables have been calculated so that they
+// are still in registers/cache and storing them only adds the (single precision) writes.
+// This needs to be done by *every* function writing `prim` of the "base" register
+// between the conserved to primitive conversion and the flux calculation (e.g., the
+// Strang split sources and the AGN triggering), as the fluxes are calculated from
+// `prim_sp` only.
+// `prim` and `prim_sp` are either a VariablePack or any other (n,k,j,i)-indexable object.
+template <typename QPack, typename SPPack>
+KOKKOS_FORCEINLINE_FUNCTION void StorePrimSP(const QPack &prim, const SPPack &prim_sp,
+                                             const int nprim, const int k, const int j,
+                                             const int i) {
+  for (int n = 0; n < nprim; n += 2) {
+    FloatPair pair;
+    pair.v[0] = static_cast<float>(prim(n, k, j, i));
+    pair.v[1] = n + 1 < nprim ? static_cast<float>(prim(n + 1, k, j, i)) : 0.0f;
+    prim_sp(n / 2, k, j, i) = Kokkos::bit_cast<parthenon::Real>(pair);
+  }
+}
+
+// Read-only view of the single precision primitive variables of a single block, which
+// can directly be passed to Reconstruct() in place of the (double precision) block pack.
+// `SPPack` is the block pack of "prim_sp" (or any other (n,k,j,i)-indexable object
+// providing GetDim() and GetCoords()).
+template <typename SPPack = parthenon::VariablePack<parthenon::Real>>
+class PrimSPBlock {
+ public:
+  KOKKOS_FORCEINLINE_FUNCTION
+  PrimSPBlock(const SPPack &prim_sp, const int nprim)
+      : prim_sp_(prim_sp), nprim_(nprim) {}
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  parthenon::Real operator()(const int n, const int k, const int j, const int i) const {
+    return static_cast<parthenon::Real>(
+        Kokkos::bit_cast<FloatPair>(prim_sp_(n / 2, k, j, i)).v[n % 2]);
+  }
+  // Following VariablePack convention, i.e., dim 4 is the variable index
+  KOKKOS_FORCEINLINE_FUNCTION
+  int GetDim(const int dim) const { return dim == 4 ? nprim_ : prim_sp_.GetDim(dim); }
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  const auto &GetCoords() const { return prim_sp_.GetCoords(); }
+
+ private:
+  const SPPack prim_sp_;
+  const int nprim_;
+};
+
+} // namespace Hydro
+
+#endif // HYDRO_MIXED_PRECISION_HPP_
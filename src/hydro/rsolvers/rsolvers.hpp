@@ -62,4 +62,15 @@ struct Riemann<Fluid::glmmhd, RiemannSolver::none> {
   }
 };
 
+// Riemann solvers used in the flux calculation
+#ifdef ATHENAPK_SIMD_RIEMANN
+// explicitly vectorized versions of the HLLE, HLLC, and HLLD solvers
+#include "simd_rsolvers.hpp"
+template <Fluid fluid, RiemannSolver rsolver>
+using FluxRiemann = SimdRiemann<fluid, rsolver>;
+#else
+template <Fluid fluid, RiemannSolver rsolver>
+using FluxRiemann = Riemann<fluid, rsolver>;
+#endif
+
 #endif // RSOLVERS_RSOLVERS_HPP_
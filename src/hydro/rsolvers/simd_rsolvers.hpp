@@ -0,0 +1,686 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file simd_rsolvers.hpp
+//! \brief Explicitly vectorized (Kokkos::Experimental::simd) versions of the HLLE, HLLC,
+//! and HLLD Riemann solvers (only used if compiled with
+//! AthenaPK_ENABLE_SIMD_RIEMANN=ON).
+//!
+//! The solvers are identical to the ones in hydro_hlle.hpp, hydro_hllc.hpp,
+//! glmmhd_hlle.hpp, and glmmhd_hlld.hpp but written branch free, i.e., all branches
+//! (e.g., the HLLD star states) are calculated and the result is selected per lane.
+//! Each solver is written once for a generic type `T` and instantiated both for a SIMD
+//! pack (processing `simd_t::size()` interfaces at once) and for `Real` (remainder of the
+//! pencil not filling a full pack).
+
+#ifndef RSOLVERS_SIMD_RSOLVERS_HPP_
+#define RSOLVERS_SIMD_RSOLVERS_HPP_
+
+#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP) ||                        \
+    defined(KOKKOS_ENABLE_SYCL)
+#error "AthenaPK_ENABLE_SIMD_RIEMANN is only supported for host (CPU) builds."
+#endif
+
+// C++ headers
+#include <algorithm> // max(), min()
+#include <cmath>     // sqrt()
+
+// Kokkos headers
+#include <Kokkos_SIMD.hpp>
+
+// AthenaPK headers
+#include "../../eos/adiabatic_glmmhd.hpp"
+#include "../../eos/adiabatic_hydro.hpp"
+#include "../../main.hpp"
+#include "rsolvers.hpp"
+
+namespace simd_rsolvers {
+using parthenon::Real;
+
+using simd_t = Kokkos::Experimental::native_simd<Real>;
+using mask_t = typename simd_t::mask_type;
+
+// Element-wise functions for both `Real` and `simd_t` so that the solvers below can be
+// instantiated for both.
+KOKKOS_FORCEINLINE_FUNCTION Real Select(const bool mask, const Real a, const Real b) {
+  return mask ? a : b;
+}
+KOKKOS_FORCEINLINE_FUNCTION simd_t Select(const mask_t &mask, const simd_t &a,
+                                          const simd_t &b) {
+  return Kokkos::Experimental::condition(mask, a, b);
+}
+template <typename T>
+KOKKOS_FORCEINLINE_FUNCTION T Min(const T &a, const T &b) {
+  return Select(a < b, a, b);
+}
+template <typename T>
+KOKKOS_FORCEINLINE_FUNCTION T Max(const T &a, const T &b) {
+  return Select(a > b, a, b);
+}
+template <typename T>
+KOKKOS_FORCEINLINE_FUNCTION T Abs(const T &a) {
+  return Select(a < T(0.0), -a, a);
+}
+KOKKOS_FORCEINLINE_FUNCTION Real Sqrt(const Real a) { return std::sqrt(a); }
+KOKKOS_FORCEINLINE_FUNCTION simd_t Sqrt(const simd_t &a) { return Kokkos::sqrt(a); }
+
+// Calculate the fluxes of all interfaces il..iu of a pencil with `solver`, which is
+// called for packs of interfaces with the L/R states `wli`/`wri` (ordered as IDN, IV1,
+// IV2, IV3, IPR, IB1, IB2, IB3, IPS with IV1 being the velocity normal to the interface)
+// and returns the fluxes in `flxi` (with the same ordering).
+template <int NVAR, typename Solver>
+KOKKOS_FORCEINLINE_FUNCTION void
+SolvePencil(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
+            const int iu, const int ivx, const ScratchPad2D<Real> &wl,
+            const ScratchPad2D<Real> &wr, VariableFluxPack<Real> &cons,
+            const Solver &solver) {
+  const int ivy = IV1 + ((ivx - IV1) + 1) % 3;
+  const int ivz = IV1 + ((ivx - IV1) + 2) % 3;
+  // Mapping of the local ordering to the primitive (and conserved) variable indices
+  int idx[NVAR];
+  idx[IDN] = IDN;
+  idx[IV1] = ivx;
+  idx[IV2] = ivy;
+  idx[IV3] = ivz;
+  idx[IPR] = IPR;
+  if constexpr (NVAR > NHYDRO) {
+    idx[IB1] = ivx - 1 + NHYDRO;
+    idx[IB2] = ivy - 1 + NHYDRO;
+    idx[IB3] = ivz - 1 + NHYDRO;
+    idx[IPS] = IPS;
+  }
+
+  constexpr int width = simd_t::size();
+  const int npacks = (iu - il + 1) / width;
+  const auto tag = Kokkos::Experimental::element_aligned_tag();
+
+  parthenon::par_for_inner(member, 0, npacks - 1, [&](const int p) {
+    const int i = il + p * width;
+    simd_t wli[NVAR], wri[NVAR], flxi[NVAR];
+    for (int n = 0; n < NVAR; ++n) {
+      wli[n].copy_from(&wl(idx[n], i), tag);
+      wri[n].copy_from(&wr(idx[n], i), tag);
+    }
+    solver(wli, wri, flxi);
+    for (int n = 0; n < NVAR; ++n) {
+      flxi[n].copy_to(&cons.flux(ivx, idx[n], k, j, i), tag);
+    }
+  });
+
+  // Remaining interfaces not filling a full pack
+  parthenon::par_for_inner(member, il + npacks * width, iu, [&](const int i) {
+    Real wli[NVAR], wri[NVAR], flxi[NVAR];
+    for (int n = 0; n < NVAR; ++n) {
+      wli[n] = wl(idx[n], i);
+      wri[n] = wr(idx[n], i);
+    }
+    solver(wli, wri, flxi);
+    for (int n = 0; n < NVAR; ++n) {
+      cons.flux(ivx, idx[n], k, j, i) = flxi[n];
+    }
+  });
+}
+
+//----------------------------------------------------------------------------------------
+//! HLLE Riemann solver for adiabatic hydrodynamics, see hydro_hlle.hpp
+struct HydroHLLE {
+  Real gamma, gm1, igm1;
+
+  template <typename T>
+  KOKKOS_FORCEINLINE_FUNCTION void operator()(const T *wli, const T *wri, T *flxi) const {
+    const T zero(0.0);
+    T wroe[NHYDRO], fl[NHYDRO], fr[NHYDRO];
+
+    //--- Step 2.  Compute Roe-averaged state
+    const T sqrtdl = Sqrt(wli[IDN]);
+    const T sqrtdr = Sqrt(wri[IDN]);
+    const T isdlpdr = 1.0 / (sqrtdl + sqrtdr);
+
+    wroe[IDN] = sqrtdl * sqrtdr;
+    wroe[IV1] = (sqrtdl * wli[IV1] + sqrtdr * wri[IV1]) * isdlpdr;
+    wroe[IV2] = (sqrtdl * wli[IV2] + sqrtdr * wri[IV2]) * isdlpdr;
+    wroe[IV3] = (sqrtdl * wli[IV3] + sqrtdr * wri[IV3]) * isdlpdr;
+
+    const T el = wli[IPR] * igm1 +
+                 0.5 * wli[IDN] * (SQR(wli[IV1]) + SQR(wli[IV2]) + SQR(wli[IV3]));
+    const T er = wri[IPR] * igm1 +
+                 0.5 * wri[IDN] * (SQR(wri[IV1]) + SQR(wri[IV2]) + SQR(wri[IV3]));
+    const T hroe = ((el + wli[IPR]) / sqrtdl + (er + wri[IPR]) / sqrtdr) * isdlpdr;
+
+    //--- Step 3.  Compute sound speed in L,R, and Roe-averaged states
+    const T cl = Sqrt(gamma * wli[IPR] / wli[IDN]);
+    const T cr = Sqrt(gamma * wri[IPR] / wri[IDN]);
+    const T q = hroe - 0.5 * (SQR(wroe[IV1]) + SQR(wroe[IV2]) + SQR(wroe[IV3]));
+    const T a = Sqrt(gm1 * Max(q, zero));
+
+    //--- Step 4. Compute the max/min wave speeds based on L/R and Roe-averaged values
+    const T al = Min(wroe[IV1] - a, wli[IV1] - cl);
+    const T ar = Max(wroe[IV1] + a, wri[IV1] + cr);
+
+    const T bp = Select(ar > zero, ar, T(TINY_NUMBER));
+    const T bm = Select(al < zero, al, T(TINY_NUMBER));
+
+    //-- Step 5. Compute L/R fluxes along lines bm/bp: F_L - (S_L)U_L; F_R - (S_R)U_R
+    const T vxl = wli[IV1] - bm;
+    const T vxr = wri[IV1] - bp;
+
+    fl[IDN] = wli[IDN] * vxl;
+    fr[IDN] = wri[IDN] * vxr;
+
+    fl[IV1] = wli[IDN] * wli[IV1] * vxl + wli[IPR];
+    fr[IV1] = wri[IDN] * wri[IV1] * vxr + wri[IPR];
+
+    fl[IV2] = wli[IDN] * wli[IV2] * vxl;
+    fr[IV2] = wri[IDN] * wri[IV2] * vxr;
+
+    fl[IV3] = wli[IDN] * wli[IV3] * vxl;
+    fr[IV3] = wri[IDN] * wri[IV3] * vxr;
+
+    fl[IEN] = el * vxl + wli[IPR] * wli[IV1];
+    fr[IEN] = er * vxr + wri[IPR] * wri[IV1];
+
+    //--- Step 6. Compute the HLLE flux at interface.
+    const auto distinct = bp != bm;
+    const T tmp = Select(distinct, 0.5 * (bp + bm) / Select(distinct, bp - bm, T(1.0)),
+                         zero);
+
+    for (int n = 0; n < NHYDRO; ++n) {
+      flxi[n] = 0.5 * (fl[n] + fr[n]) + (fl[n] - fr[n]) * tmp;
+    }
+  }
+};
+
+//----------------------------------------------------------------------------------------
+//! HLLC Riemann solver for adiabatic hydrodynamics, see hydro_hllc.hpp
+struct HydroHLLC {
+  Real gamma, gm1, igm1;
+
+  template <typename T>
+  KOKKOS_FORCEINLINE_FUNCTION void operator()(const T *wli, const T *wri, T *flxi) const {
+    const T zero(0.0);
+    const T one(1.0);
+    T fl[NHYDRO], fr[NHYDRO];
+
+    //--- Step 2.  Compute middle state estimates with PVRS (Toro 10.5.2)
+    const T cl = Sqrt(gamma * wli[IPR] / wli[IDN]);
+    const T cr = Sqrt(gamma * wri[IPR] / wri[IDN]);
+    const T el = wli[IPR] * igm1 +
+                 0.5 * wli[IDN] * (SQR(wli[IV1]) + SQR(wli[IV2]) + SQR(wli[IV3]));
+    const T er = wri[IPR] * igm1 +
+                 0.5 * wri[IDN] * (SQR(wri[IV1]) + SQR(wri[IV2]) + SQR(wri[IV3]));
+    const T rhoa = .5 * (wli[IDN] + wri[IDN]); // average density
+    const T ca = .5 * (cl + cr);               // average sound speed
+    const T pmid = .5 * (wli[IPR] + wri[IPR] + (wli[IV1] - wri[IV1]) * rhoa * ca);
+
+    //--- Step 3.  Compute sound speed in L,R
+    // The argument of the sqrt is <= 1 iff pmid <= p so that this equals the branches
+    // of the scalar version.
+    const Real fac = (gamma + 1) / (2 * gamma);
+    const T ql = Sqrt(Max(1.0 + fac * (pmid / wli[IPR] - 1.0), one));
+    const T qr = Sqrt(Max(1.0 + fac * (pmid / wri[IPR] - 1.0), one));
+
+    //--- Step 4.  Compute the max/min wave speeds based on L/R
+    const T al = wli[IV1] - cl * ql;
+    const T ar = wri[IV1] + cr * qr;
+
+    const T bp = Select(ar > zero, ar, T(TINY_NUMBER));
+    const T bm = Select(al < zero, al, T(-TINY_NUMBER));
+
+    //--- Step 5. Compute the contact wave speed and pressure
+    T vxl = wli[IV1] - al;
+    T vxr = wri[IV1] - ar;
+
+    const T tl = wli[IPR] + vxl * wli[IDN] * wli[IV1];
+    const T tr = wri[IPR] + vxr * wri[IDN] * wri[IV1];
+
+    const T ml = wli[IDN] * vxl;
+    const T mr = -(wri[IDN] * vxr);
+
+    // Determine the contact wave speed...
+    const T am = (tl - tr) / (ml + mr);
+    // ...and the pressure at the contact surface
+    const T cp = Max((ml * tr + mr * tl) / (ml + mr), zero);
+
+    //--- Step 6. Compute L/R fluxes along the line bm, bp
+    vxl = wli[IV1] - bm;
+    vxr = wri[IV1] - bp;
+
+    fl[IDN] = wli[IDN] * vxl;
+    fr[IDN] = wri[IDN] * vxr;
+
+    fl[IV1] = wli[IDN] * wli[IV1] * vxl + wli[IPR];
+    fr[IV1] = wri[IDN] * wri[IV1] * vxr + wri[IPR];
+
+    fl[IV2] = wli[IDN] * wli[IV2] * vxl;
+    fr[IV2] = wri[IDN] * wri[IV2] * vxr;
+
+    fl[IV3] = wli[IDN] * wli[IV3] * vxl;
+    fr[IV3] = wri[IDN] * wri[IV3] * vxr;
+
+    fl[IEN] = el * vxl + wli[IPR] * wli[IV1];
+    fr[IEN] = er * vxr + wri[IPR] * wri[IV1];
+
+    //--- Step 8. Compute flux weights or scales
+    // The denominators are > 0 in the selected branch and only guarded against division
+    // by zero in the other one.
+    const auto right_moving = am >= zero;
+    const T dl = Select(right_moving, am - bm, one);
+    const T dr = Select(right_moving, one, bp - am);
+    const T sl = Select(right_moving, am / dl, zero);
+    const T sr = Select(right_moving, zero, -am / dr);
+    const T sm = Select(right_moving, -bm / dl, bp / dr);
+
+    //--- Step 9. Compute the HLLC flux at interface, including weighted contribution
+    // of the flux along the contact
+    flxi[IDN] = sl * fl[IDN] + sr * fr[IDN];
+    flxi[IV1] = sl * fl[IV1] + sr * fr[IV1] + sm * cp;
+    flxi[IV2] = sl * fl[IV2] + sr * fr[IV2];
+    flxi[IV3] = sl * fl[IV3] + sr * fr[IV3];
+    flxi[IEN] = sl * fl[IEN] + sr * fr[IEN] + sm * cp * am;
+  }
+};
+
+// Fast magnetosonic speed, see AdiabaticGLMMHDEOS::FastMagnetosonicSpeed()
+template <typename T>
+KOKKOS_FORCEINLINE_FUNCTION T FastMagnetosonicSpeed(const Real gamma, const T &d,
+                                                    const T &p, const T &bx, const T &by,
+                                                    const T &bz) {
+  const T asq = gamma * p;
+  const T ct2 = by * by + bz * bz;
+  const T qsq = bx * bx + ct2 + asq;
+  const T tmp = bx * bx + ct2 - asq;
+  return Sqrt(0.5 * (qsq + Sqrt(tmp * tmp + 4.0 * asq * ct2)) / d);
+}
+
+//----------------------------------------------------------------------------------------
+//! HLLE Riemann solver for adiabatic GLM MHD, see glmmhd_hlle.hpp
+struct GLMMHDHLLE {
+  Real gamma, gm1, c_h;
+
+  template <typename T>
+  KOKKOS_FORCEINLINE_FUNCTION void operator()(const T *wli, const T *wri, T *flxi) const {
+    constexpr int NGLMMHD = 9;
+    const T zero(0.0);
+    T wroe[NGLMMHD], fl[NGLMMHD], fr[NGLMMHD];
+
+    // first solve the decoupled state, see eq (24) in Mignone & Tzeferacos (2010)
+    const T bxi = 0.5 * (wli[IB1] + wri[IB1]) - 0.5 / c_h * (wri[IPS] - wli[IPS]);
+    const T psii = 0.5 * (wli[IPS] + wri[IPS]) - 0.5 * c_h * (wri[IB1] - wli[IB1]);
+    // and store flux
+    flxi[IB1] = psii;
+    flxi[IPS] = SQR(c_h) * bxi;
+
+    //--- Step 2. Compute Roe-averaged state
+    const T sqrtdl = Sqrt(wli[IDN]);
+    const T sqrtdr = Sqrt(wri[IDN]);
+    const T isdlpdr = 1.0 / (sqrtdl + sqrtdr);
+
+    wroe[IDN] = sqrtdl * sqrtdr;
+    wroe[IV1] = (sqrtdl * wli[IV1] + sqrtdr * wri[IV1]) * isdlpdr;
+    wroe[IV2] = (sqrtdl * wli[IV2] + sqrtdr * wri[IV2]) * isdlpdr;
+    wroe[IV3] = (sqrtdl * wli[IV3] + sqrtdr * wri[IV3]) * isdlpdr;
+    // Note Roe average of magnetic field is different
+    wroe[IB2] = (sqrtdr * wli[IB2] + sqrtdl * wri[IB2]) * isdlpdr;
+    wroe[IB3] = (sqrtdr * wli[IB3] + sqrtdl * wri[IB3]) * isdlpdr;
+    const T x = 0.5 * (SQR(wli[IB2] - wri[IB2]) + SQR(wli[IB3] - wri[IB3])) /
+                (SQR(sqrtdl + sqrtdr));
+    const T y = 0.5 * (wli[IDN] + wri[IDN]) / wroe[IDN];
+
+    const T pbl = 0.5 * (bxi * bxi + SQR(wli[IB2]) + SQR(wli[IB3]));
+    const T pbr = 0.5 * (bxi * bxi + SQR(wri[IB2]) + SQR(wri[IB3]));
+    const T el = wli[IPR] / gm1 +
+                 0.5 * wli[IDN] * (SQR(wli[IV1]) + SQR(wli[IV2]) + SQR(wli[IV3])) + pbl;
+    const T er = wri[IPR] / gm1 +
+                 0.5 * wri[IDN] * (SQR(wri[IV1]) + SQR(wri[IV2]) + SQR(wri[IV3])) + pbr;
+    const T hroe =
+        ((el + wli[IPR] + pbl) / sqrtdl + (er + wri[IPR] + pbr) / sqrtdr) * isdlpdr;
+
+    //--- Step 3. Compute fast magnetosonic speed in L,R, and Roe-averaged states
+    const T cl =
+        FastMagnetosonicSpeed(gamma, wli[IDN], wli[IPR], wli[IB1], wli[IB2], wli[IB3]);
+    const T cr =
+        FastMagnetosonicSpeed(gamma, wri[IDN], wri[IPR], wri[IB1], wri[IB2], wri[IB3]);
+
+    const T btsq = SQR(wroe[IB2]) + SQR(wroe[IB3]);
+    const T vaxsq = bxi * bxi / wroe[IDN];
+    const T bt_starsq = (gm1 - (gm1 - 1.0) * y) * btsq;
+    const T hp = hroe - (vaxsq + btsq / wroe[IDN]);
+    const T vsq = SQR(wroe[IV1]) + SQR(wroe[IV2]) + SQR(wroe[IV3]);
+    const T twid_asq = Max(gm1 * (hp - 0.5 * vsq) - (gm1 - 1.0) * x, zero);
+    const T ct2 = bt_starsq / wroe[IDN];
+    const T tsum = vaxsq + ct2 + twid_asq;
+    const T tdif = vaxsq + ct2 - twid_asq;
+    const T cf2_cs2 = Sqrt(tdif * tdif + 4.0 * twid_asq * ct2);
+
+    const T cfsq = 0.5 * (tsum + cf2_cs2);
+    const T a = Sqrt(cfsq);
+
+    //--- Step 4. Compute the max/min wave speeds based on L/R and Roe-averaged values
+    const T al = Min(wroe[IV1] - a, wli[IV1] - cl);
+    const T ar = Max(wroe[IV1] + a, wri[IV1] + cr);
+
+    const T bp = Max(ar, zero);
+    const T bm = Min(al, zero);
+
+    //--- Step 5. Compute L/R fluxes along the lines bm/bp: F_L - (S_L)U_L; F_R -
+    //(S_R)U_R
+    const T vxl = wli[IV1] - bm;
+    const T vxr = wri[IV1] - bp;
+
+    fl[IDN] = wli[IDN] * vxl;
+    fr[IDN] = wri[IDN] * vxr;
+
+    fl[IV1] = wli[IDN] * wli[IV1] * vxl + pbl - SQR(bxi) + wli[IPR];
+    fr[IV1] = wri[IDN] * wri[IV1] * vxr + pbr - SQR(bxi) + wri[IPR];
+
+    fl[IV2] = wli[IDN] * wli[IV2] * vxl - bxi * wli[IB2];
+    fr[IV2] = wri[IDN] * wri[IV2] * vxr - bxi * wri[IB2];
+
+    fl[IV3] = wli[IDN] * wli[IV3] * vxl - bxi * wli[IB3];
+    fr[IV3] = wri[IDN] * wri[IV3] * vxr - bxi * wri[IB3];
+
+    fl[IEN] = el * vxl + wli[IV1] * (wli[IPR] + pbl - bxi * bxi) -
+              bxi * (wli[IB2] * wli[IV2] + wli[IB3] * wli[IV3]);
+    fr[IEN] = er * vxr + wri[IV1] * (wri[IPR] + pbr - bxi * bxi) -
+              bxi * (wri[IB2] * wri[IV2] + wri[IB3] * wri[IV3]);
+
+    fl[IB2] = wli[IB2] * vxl - bxi * wli[IV2];
+    fr[IB2] = wri[IB2] * vxr - bxi * wri[IV2];
+
+    fl[IB3] = wli[IB3] * vxl - bxi * wli[IV3];
+    fr[IB3] = wri[IB3] * vxr - bxi * wri[IV3];
+
+    //--- Step 6. Compute the HLLE flux at interface.
+    const auto distinct = bp != bm;
+    const T tmp = Select(distinct, 0.5 * (bp + bm) / Select(distinct, bp - bm, T(1.0)),
+                         zero);
+
+    for (int n = 0; n < NHYDRO; ++n) {
+      flxi[n] = 0.5 * (fl[n] + fr[n]) + (fl[n] - fr[n]) * tmp;
+    }
+    flxi[IB2] = 0.5 * (fl[IB2] + fr[IB2]) + (fl[IB2] - fr[IB2]) * tmp;
+    flxi[IB3] = 0.5 * (fl[IB3] + fr[IB3]) + (fl[IB3] - fr[IB3]) * tmp;
+  }
+};
+
+// (density, momentum, total energy, tranverse magnetic field) of a single state
+template <typename T>
+struct Cons1DT {
+  T d, mx, my, mz, e, by, bz;
+};
+
+//----------------------------------------------------------------------------------------
+//! HLLD Riemann solver for adiabatic GLM MHD, see glmmhd_hlld.hpp
+struct GLMMHDHLLD {
+  Real gamma, gm1, igm1, c_h;
+
+  // Star state (eqns (39) and (43)-(48) of Miyoshi & Kusano) on the side with the
+  // (outer) wave speed `s` with `sd` = S - u and `sdm` = S - S_M.
+  template <typename T>
+  KOKKOS_FORCEINLINE_FUNCTION void StarState(const T *w, const Cons1DT<T> &u, const T &pt,
+                                             const T &sd, const T &sdm, const T &sm,
+                                             const T &bxi, const T &bxsq, const T &ptst,
+                                             Cons1DT<T> &ust, T &vbst) const {
+    constexpr Real small_number = 1.0e-8;
+    ust.d = u.d * sd / sdm;
+    ust.mx = ust.d * sm;
+    const T den = u.d * sd * sdm - bxsq;
+    // Degenerate case in which the transverse components remain unchanged
+    const auto degenerate = Abs(den) < small_number * ptst;
+    const T den_safe = Select(degenerate, T(1.0), den);
+    // eqns (44) and (46) of M&K
+    T tmp = bxi * (sd - sdm) / den_safe;
+    ust.my = ust.d * Select(degenerate, w[IV2], w[IV2] - u.by * tmp);
+    ust.mz = ust.d * Select(degenerate, w[IV3], w[IV3] - u.bz * tmp);
+    // eqns (45) and (47) of M&K
+    tmp = (u.d * SQR(sd) - bxsq) / den_safe;
+    ust.by = Select(degenerate, u.by, u.by * tmp);
+    ust.bz = Select(degenerate, u.bz, u.bz * tmp);
+    // v_i* dot B_i*
+    vbst = (ust.mx * bxi + (ust.my * ust.by + ust.mz * ust.bz)) / ust.d;
+    // eqn (48) of M&K
+    ust.e = (sd * u.e - pt * w[IV1] + ptst * sm +
+             bxi * (w[IV1] * bxi + (w[IV2] * u.by + w[IV3] * u.bz) - vbst)) /
+            sdm;
+  }
+
+  template <typename T>
+  KOKKOS_FORCEINLINE_FUNCTION void operator()(const T *wli, const T *wri, T *flxi) const {
+    constexpr Real small_number = 1.0e-8;
+    const T zero(0.0);
+    T spd[5];                           // signal speeds, left to right
+    Cons1DT<T> ul, ur;                   // L/R states, conserved variables (computed)
+    Cons1DT<T> ulst, uldst, urdst, urst; // Conserved variable for all states
+    Cons1DT<T> fl, fr;                   // Fluxes for left & right states
+
+    // first solve the decoupled state, see eq (24) in Mignone & Tzeferacos (2010)
+    const T bxi = 0.5 * (wli[IB1] + wri[IB1]) - 0.5 / c_h * (wri[IPS] - wli[IPS]);
+    const T psii = 0.5 * (wli[IPS] + wri[IPS]) - 0.5 * c_h * (wri[IB1] - wli[IB1]);
+    // and store flux
+    flxi[IB1] = psii;
+    flxi[IPS] = SQR(c_h) * bxi;
+
+    // Compute L/R states for selected conserved variables
+    const T bxsq = bxi * bxi;
+    const T pbl = 0.5 * (bxsq + (SQR(wli[IB2]) + SQR(wli[IB3])));
+    const T pbr = 0.5 * (bxsq + (SQR(wri[IB2]) + SQR(wri[IB3])));
+    const T kel = 0.5 * wli[IDN] * (SQR(wli[IV1]) + (SQR(wli[IV2]) + SQR(wli[IV3])));
+    const T ker = 0.5 * wri[IDN] * (SQR(wri[IV1]) + (SQR(wri[IV2]) + SQR(wri[IV3])));
+
+    ul.d = wli[IDN];
+    ul.mx = wli[IV1] * ul.d;
+    ul.my = wli[IV2] * ul.d;
+    ul.mz = wli[IV3] * ul.d;
+    ul.e = wli[IPR] * igm1 + kel + pbl;
+    ul.by = wli[IB2];
+    ul.bz = wli[IB3];
+
+    ur.d = wri[IDN];
+    ur.mx = wri[IV1] * ur.d;
+    ur.my = wri[IV2] * ur.d;
+    ur.mz = wri[IV3] * ur.d;
+    ur.e = wri[IPR] * igm1 + ker + pbr;
+    ur.by = wri[IB2];
+    ur.bz = wri[IB3];
+
+    //--- Step 2.  Compute L & R wave speeds according to Miyoshi & Kusano, eqn. (67)
+    const T cfl =
+        FastMagnetosonicSpeed(gamma, wli[IDN], wli[IPR], wli[IB1], wli[IB2], wli[IB3]);
+    const T cfr =
+        FastMagnetosonicSpeed(gamma, wri[IDN], wri[IPR], wri[IB1], wri[IB2], wri[IB3]);
+
+    spd[0] = Min(wli[IV1] - cfl, wri[IV1] - cfr);
+    spd[4] = Max(wli[IV1] + cfl, wri[IV1] + cfr);
+
+    //--- Step 3.  Compute L/R fluxes
+    const T ptl = wli[IPR] + pbl; // total pressures L,R
+    const T ptr = wri[IPR] + pbr;
+
+    fl.d = ul.mx;
+    fl.mx = ul.mx * wli[IV1] + ptl - bxsq;
+    fl.my = ul.my * wli[IV1] - bxi * ul.by;
+    fl.mz = ul.mz * wli[IV1] - bxi * ul.bz;
+    fl.e = wli[IV1] * (ul.e + ptl - bxsq) - bxi * (wli[IV2] * ul.by + wli[IV3] * ul.bz);
+    fl.by = ul.by * wli[IV1] - bxi * wli[IV2];
+    fl.bz = ul.bz * wli[IV1] - bxi * wli[IV3];
+
+    fr.d = ur.mx;
+    fr.mx = ur.mx * wri[IV1] + ptr - bxsq;
+    fr.my = ur.my * wri[IV1] - bxi * ur.by;
+    fr.mz = ur.mz * wri[IV1] - bxi * ur.bz;
+    fr.e = wri[IV1] * (ur.e + ptr - bxsq) - bxi * (wri[IV2] * ur.by + wri[IV3] * ur.bz);
+    fr.by = ur.by * wri[IV1] - bxi * wri[IV2];
+    fr.bz = ur.bz * wri[IV1] - bxi * wri[IV3];
+
+    //--- Step 4.  Compute middle and Alfven wave speeds
+    const T sdl = spd[0] - wli[IV1]; // S_i-u_i (i=L or R)
+    const T sdr = spd[4] - wri[IV1];
+
+    // S_M: eqn (38) of Miyoshi & Kusano
+    spd[2] = (sdr * ur.mx - sdl * ul.mx + (ptl - ptr)) / (sdr * ur.d - sdl * ul.d);
+
+    const T sdml = spd[0] - spd[2]; // S_i-S_M (i=L or R)
+    const T sdmr = spd[4] - spd[2];
+
+    //--- Step 5.  Compute intermediate states
+    // eqn (23) explicitly becomes eq (41) of Miyoshi & Kusano
+    const T ptstl = ptl + ul.d * sdl * (spd[2] - wli[IV1]);
+    const T ptstr = ptr + ur.d * sdr * (spd[2] - wri[IV1]);
+    const T ptst = 0.5 * (ptstr + ptstl); // total pressure (star state)
+
+    T vbstl, vbstr;
+    StarState(wli, ul, ptl, sdl, sdml, spd[2], bxi, bxsq, ptst, ulst, vbstl);
+    StarState(wri, ur, ptr, sdr, sdmr, spd[2], bxi, bxsq, ptst, urst, vbstr);
+
+    const T sqrtdl = Sqrt(ulst.d);
+    const T sqrtdr = Sqrt(urst.d);
+
+    // eqn (51) of Miyoshi & Kusano
+    spd[1] = spd[2] - Abs(bxi) / sqrtdl;
+    spd[3] = spd[2] + Abs(bxi) / sqrtdr;
+
+    // ul** and ur** - if Bx is near zero, same as *-states
+    {
+      const auto bx_zero = 0.5 * bxsq < small_number * ptst;
+      const T ulst_d_inv = 1.0 / ulst.d;
+      const T urst_d_inv = 1.0 / urst.d;
+      const T invsumd = 1.0 / (sqrtdl + sqrtdr);
+      const T bxsig = Select(bxi > zero, T(1.0), T(-1.0));
+
+      uldst.d = ulst.d;
+      urdst.d = urst.d;
+
+      uldst.mx = ulst.mx;
+      urdst.mx = urst.mx;
+
+      // eqn (59) of M&K
+      T tmp = invsumd * (sqrtdl * (ulst.my * ulst_d_inv) +
+                         sqrtdr * (urst.my * urst_d_inv) + bxsig * (urst.by - ulst.by));
+      uldst.my = Select(bx_zero, ulst.my, uldst.d * tmp);
+      urdst.my = Select(bx_zero, urst.my, urdst.d * tmp);
+
+      // eqn (60) of M&K
+      tmp = invsumd * (sqrtdl * (ulst.mz * ulst_d_inv) + sqrtdr * (urst.mz * urst_d_inv) +
+                       bxsig * (urst.bz - ulst.bz));
+      uldst.mz = Select(bx_zero, ulst.mz, uldst.d * tmp);
+      urdst.mz = Select(bx_zero, urst.mz, urdst.d * tmp);
+
+      // eqn (61) of M&K
+      tmp = invsumd *
+            (sqrtdl * urst.by + sqrtdr * ulst.by +
+             bxsig * sqrtdl * sqrtdr * ((urst.my * urst_d_inv) - (ulst.my * ulst_d_inv)));
+      uldst.by = Select(bx_zero, ulst.by, tmp);
+      urdst.by = Select(bx_zero, urst.by, tmp);
+
+      // eqn (62) of M&K
+      tmp = invsumd *
+            (sqrtdl * urst.bz + sqrtdr * ulst.bz +
+             bxsig * sqrtdl * sqrtdr * ((urst.mz * urst_d_inv) - (ulst.mz * ulst_d_inv)));
+      uldst.bz = Select(bx_zero, ulst.bz, tmp);
+      urdst.bz = Select(bx_zero, urst.bz, tmp);
+
+      // eqn (63) of M&K
+      tmp = spd[2] * bxi + (uldst.my * uldst.by + uldst.mz * uldst.bz) / uldst.d;
+      uldst.e = Select(bx_zero, ulst.e, ulst.e - sqrtdl * bxsig * (vbstl - tmp));
+      urdst.e = Select(bx_zero, urst.e, urst.e + sqrtdr * bxsig * (vbstr - tmp));
+    }
+
+    //--- Step 6.  Compute flux
+    // Jumps across the waves, i.e., S_i * (U_i - U_{i-1})
+    const auto jump = [](const T &s, const Cons1DT<T> &a, const Cons1DT<T> &b) {
+      return Cons1DT<T>{s * (a.d - b.d),   s * (a.mx - b.mx), s * (a.my - b.my),
+                        s * (a.mz - b.mz), s * (a.e - b.e),   s * (a.by - b.by),
+                        s * (a.bz - b.bz)};
+    };
+    const auto djl = jump(spd[1], uldst, ulst);
+    const auto jl = jump(spd[0], ulst, ul);
+    const auto djr = jump(spd[3], urdst, urst);
+    const auto jr = jump(spd[4], urst, ur);
+
+    // Flux of the state the interface is located in. The selects are applied in reverse
+    // order of the branches of the scalar version so that the first matching one wins.
+    const auto flux = [&](T Cons1DT<T>::*var) {
+      T f = fr.*var + jr.*var;                                  // Fr*
+      f = Select(spd[3] > zero, fr.*var + jr.*var + djr.*var, f); // Fr**
+      f = Select(spd[2] >= zero, fl.*var + jl.*var + djl.*var, f); // Fl**
+      f = Select(spd[1] >= zero, fl.*var + jl.*var, f);            // Fl*
+      f = Select(spd[4] <= zero, fr.*var, f);                      // Fr
+      f = Select(spd[0] >= zero, fl.*var, f);                      // Fl
+      return f;
+    };
+    flxi[IDN] = flux(&Cons1DT<T>::d);
+    flxi[IV1] = flux(&Cons1DT<T>::mx);
+    flxi[IV2] = flux(&Cons1DT<T>::my);
+    flxi[IV3] = flux(&Cons1DT<T>::mz);
+    flxi[IEN] = flux(&Cons1DT<T>::e);
+    flxi[IB2] = flux(&Cons1DT<T>::by);
+    flxi[IB3] = flux(&Cons1DT<T>::bz);
+  }
+};
+
+} // namespace simd_rsolvers
+
+//----------------------------------------------------------------------------------------
+// Riemann solvers using the explicitly vectorized versions above. They are used in place
+// of the ones in hydro_hlle.hpp, hydro_hllc.hpp, glmmhd_hlle.hpp, and glmmhd_hlld.hpp
+// (see FluxRiemann in rsolvers.hpp), which remain available as reference, e.g., for the
+// comparison in bench/bench_kernels.cpp.
+// All other solvers fall back to the scalar versions.
+template <Fluid fluid, RiemannSolver rsolver>
+struct SimdRiemann : Riemann<fluid, rsolver> {};
+
+template <>
+struct SimdRiemann<Fluid::euler, RiemannSolver::hlle> {
+  static KOKKOS_INLINE_FUNCTION void
+  Solve(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
+        const int iu, const int ivx, const ScratchPad2D<Real> &wl,
+        const ScratchPad2D<Real> &wr, VariableFluxPack<Real> &cons,
+        const AdiabaticHydroEOS &eos, const Real c_h) {
+    const Real gamma = eos.GetGamma();
+    const simd_rsolvers::HydroHLLE solver{gamma, gamma - 1.0, 1.0 / (gamma - 1.0)};
+    simd_rsolvers::SolvePencil<NHYDRO>(member, k, j, il, iu, ivx, wl, wr, cons, solver);
+  }
+};
+
+template <>
+struct SimdRiemann<Fluid::euler, RiemannSolver::hllc> {
+  static KOKKOS_INLINE_FUNCTION void
+  Solve(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
+        const int iu, const int ivx, const ScratchPad2D<Real> &wl,
+        const ScratchPad2D<Real> &wr, VariableFluxPack<Real> &cons,
+        const AdiabaticHydroEOS &eos, const Real c_h) {
+    const Real gamma = eos.GetGamma();
+    const simd_rsolvers::HydroHLLC solver{gamma, gamma - 1.0, 1.0 / (gamma - 1.0)};
+    simd_rsolvers::SolvePencil<NHYDRO>(member, k, j, il, iu, ivx, wl, wr, cons, solver);
+  }
+};
+
+template <>
+struct SimdRiemann<Fluid::glmmhd, RiemannSolver::hlle> {
+  static KOKKOS_INLINE_FUNCTION void
+  Solve(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
+        const int iu, const int ivx, const ScratchPad2D<Real> &wl,
+        const ScratchPad2D<Real> &wr, VariableFluxPack<Real> &cons,
+        const AdiabaticGLMMHDEOS &eos, const Real c_h) {
+    const Real gamma = eos.GetGamma();
+    const simd_rsolvers::GLMMHDHLLE solver{gamma, gamma - 1.0, c_h};
+    simd_rsolvers::SolvePencil<IPS + 1>(member, k, j, il, iu, ivx, wl, wr, cons, solver);
+  }
+};
+
+template <>
+struct SimdRiemann<Fluid::glmmhd, RiemannSolver::hlld> {
+  static KOKKOS_INLINE_FUNCTION void
+  Solve(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
+        const int iu, const int ivx, const ScratchPad2D<Real> &wl,
+        const ScratchPad2D<Real> &wr, VariableFluxPack<Real> &cons,
+        const AdiabaticGLMMHDEOS &eos, const Real c_h) {
+    const Real gamma = eos.GetGamma();
+    const simd_rsolvers::GLMMHDHLLD solver{gamma, gamma - 1.0, 1.0 / (gamma - 1.0), c_h};
+    simd_rsolvers::SolvePencil<IPS + 1>(member, k, j, il, iu, ivx, wl, wr, cons, solver);
+  }
+};
+
+#endif // RSOLVERS_SIMD_RSOLVERS_HPP_
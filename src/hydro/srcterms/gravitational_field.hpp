@@ -22,6 +22,30 @@
 
 namespace cluster {
 
+// Apply the gravitational field as a source term to a single cell
+template <typename GravitationalField, typename View4D>
+KOKKOS_INLINE_FUNCTION void
+GravitationalFieldSrcTermCell(const GravitationalField &gravitationalField,
+                              const parthenon::Real beta_dt, View4D &cons,
+                              const View4D &prim, const parthenon::Real x,
+                              const parthenon::Real y, const parthenon::Real z,
+                              const int k, const int j, const int i) {
+  using parthenon::Real;
+
+  const Real r = sqrt(x * x + y * y + z * z);
+
+  const Real g_r = gravitationalField.g_from_r(r);
+
+  // Apply g_r as a source term
+  const Real den = prim(IDN, k, j, i);
+  const Real src = (r == 0) ? 0 : beta_dt * den * g_r / r;
+  cons(IM1, k, j, i) -= src * x;
+  cons(IM2, k, j, i) -= src * y;
+  cons(IM3, k, j, i) -= src * z;
+  cons(IEN, k, j, i) -=
+      src * (x * prim(IV1, k, j, i) + y * prim(IV2, k, j, i) + z * prim(IV3, k, j, i));
+}
+
 template <typename GravitationalField>
 void GravitationalFieldSrcTerm(parthenon::MeshData<parthenon::Real> *md,
                                const parthenon::Real beta_dt,
@@ -45,21 +69,9 @@ void GravitationalFieldSrcTerm(parthenon::MeshData<parthenon::Real> *md,
         auto &prim = prim_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
 
-        const Real r =
-            sqrt(coords.Xc<1>(i) * coords.Xc<1>(i) + coords.Xc<2>(j) * coords.Xc<2>(j) +
-                 coords.Xc<3>(k) * coords.Xc<3>(k));
-
-        const Real g_r = gravitationalField.g_from_r(r);
-
-        // Apply g_r as a source term
-        const Real den = prim(IDN, k, j, i);
-        const Real src = (r == 0) ? 0 : beta_dt * den * g_r / r;
-        cons(IM1, k, j, i) -= src * coords.Xc<1>(i);
-        cons(IM2, k, j, i) -= src * coords.Xc<2>(j);
-        cons(IM3, k, j, i) -= src * coords.Xc<3>(k);
-        cons(IEN, k, j, i) -= src * (coords.Xc<1>(i) * prim(IV1, k, j, i) +
-                                     coords.Xc<2>(j) * prim(IV2, k, j, i) +
-                                     coords.Xc<3>(k) * prim(IV3, k, j, i));
+        GravitationalFieldSrcTermCell(gravitationalField, beta_dt, cons, prim,
+                                      coords.Xc<1>(i), coords.Xc<2>(j), coords.Xc<3>(k),
+                                      k, j, i);
       });
 }
 
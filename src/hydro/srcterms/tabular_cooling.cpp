@@ -9,9 +9,12 @@
 //========================================================================================
 
 // C++ headers
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <limits>
+#include <string>
+#include <vector>
 
 // Parthenon headers
 #include <coordinates/uniform_cartesian.hpp>
@@ -40,9 +43,14 @@ TabularCooling::TabularCooling(ParameterInput *pin,
                                 pin->DoesParameterExist("cooling", "log_lambda_col"))) {
     PARTHENON_WARN("\"cooling/log_temp_col\" or \"cooling/log_lambda_col\" found in"
                    "the parameter input.\n"
-                   "These have been deprecated and only cooling tables for a single "
-                   "metallicity containing the log10 temperature and log10 lambdas are "
-                   "supported.\n");
+                   "These have been deprecated. The columns of the cooling table are "
+                   "the axes given by \"cooling/table_axes\" followed by the log10 "
+                   "lambdas.\n");
+  }
+  if (Globals::my_rank == 0 && pin->DoesParameterExist("cooling", "d_log_temp_tol")) {
+    PARTHENON_WARN("\"cooling/d_log_temp_tol\" found in the parameter input.\n"
+                   "It has been deprecated as the log10 temperatures in the cooling "
+                   "table are no longer required to be evenly spaced.\n");
   }
 
   const Real lambda_units_cgs = pin->GetReal("cooling", "lambda_units_cgs");
@@ -62,13 +70,94 @@ TabularCooling::TabularCooling(ParameterInput *pin,
   }
   max_iter_ = pin->GetOrAddInteger("cooling", "max_iter", 100);
   cooling_time_cfl_ = pin->GetOrAddReal("cooling", "cfl", 0.1);
-  d_log_temp_tol_ = pin->GetOrAddReal("cooling", "d_log_temp_tol", 1e-8);
   d_e_tol_ = pin->GetOrAddReal("cooling", "d_e_tol", 1e-8);
   // negative means disabled
   T_floor_ = pin->GetOrAddReal("hydro", "Tfloor", -1.0);
 
+  // Subcycles of the subcycling integrators can be tracked to set the cost of blocks for
+  // load balancing and to monitor the imbalance of the cooling across ranks
+  track_subcycles_ = pin->GetOrAddBoolean("cooling", "track_subcycles", false);
+  subcycle_cost_ = pin->GetOrAddReal("cooling", "subcycle_cost", 0.0);
+  subcycle_cost_interval_ = pin->GetOrAddInteger(
+      "cooling", "subcycle_cost_interval",
+      pin->GetOrAddInteger("parthenon/loadbalancing", "interval", 10));
+  PARTHENON_REQUIRE_THROWS(subcycle_cost_interval_ > 0,
+                           "cooling/subcycle_cost_interval needs to be positive");
+  if (subcycle_cost_ > 0.0) {
+    track_subcycles_ = true;
+    if (Globals::my_rank == 0 &&
+        pin->GetOrAddString("parthenon/loadbalancing", "balancer", "default") !=
+            "manual") {
+      PARTHENON_WARN("cooling/subcycle_cost is set but the block costs are only used "
+                     "with \"parthenon/loadbalancing/balancer = manual\".\n");
+    }
+  }
+  if (track_subcycles_ &&
+      (integrator_ == CoolIntegrator::rk12 || integrator_ == CoolIntegrator::rk45)) {
+    // Running counts (on this rank) of the current cycle. They are reset at the
+    // beginning of each cycle (registered in Hydro::Initialize) so that the history
+    // output contains the counts of the last cycle. The subcycles are accumulated on the
+    // device by the cooling kernel and only copied to the host for the history output.
+    hydro_pkg->AddParam("cooling_subcycles", ParArray1D<Real>("cooling_subcycles", 1));
+    hydro_pkg->AddParam("cooling_cell_updates", 0.0, true);
+
+    // Mean number of subcycles per cell on this rank in the last cycle.
+    // The history output evaluates the variables for each partition but the counts cover
+    // all partitions of this rank so each partition contributes the same share.
+    auto rank_subcycles = [](MeshData<Real> *md) {
+      auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+      const auto cell_updates = hydro_pkg->Param<Real>("cooling_cell_updates");
+      if (cell_updates <= 0.0) {
+        return 0.0;
+      }
+      const auto subcycles_h = Kokkos::create_mirror_view_and_copy(
+          parthenon::HostMemSpace(),
+          hydro_pkg->Param<ParArray1D<Real>>("cooling_subcycles"));
+      return subcycles_h(0) / cell_updates;
+    };
+    auto hst_vars = hydro_pkg->Param<parthenon::HstVar_list>(parthenon::hist_param_key);
+    // Maximum over all ranks
+    hst_vars.emplace_back(parthenon::HistoryOutputVar(
+        parthenon::UserHistoryOperation::max, rank_subcycles, "cool_subcyc_max"));
+    // Mean over all ranks
+    hst_vars.emplace_back(parthenon::HistoryOutputVar(
+        parthenon::UserHistoryOperation::sum,
+        [rank_subcycles](MeshData<Real> *md) {
+          const auto num_partitions = md->GetMeshPointer()->DefaultNumPartitions();
+          return rank_subcycles(md) / (Globals::nranks * num_partitions);
+        },
+        "cool_subcyc_mean"));
+    hydro_pkg->UpdateParam(parthenon::hist_param_key, hst_vars);
+  } else {
+    track_subcycles_ = false;
+  }
+
   std::stringstream msg;
 
+  // Axes of the table, i.e., the columns preceding the log10 lambdas
+  std::vector<std::string> table_axes;
+  {
+    std::stringstream axes_ss(pin->GetOrAddString("cooling", "table_axes", "log_temp"));
+    std::string axis;
+    while (std::getline(axes_ss, axis, ',')) {
+      axis.erase(0, axis.find_first_not_of(" "));
+      axis.erase(axis.find_last_not_of(" ") + 1);
+      if ((axis != "log_temp" && axis != "log_n_h" && axis != "log_z") ||
+          std::find(table_axes.begin(), table_axes.end(), axis) != table_axes.end()) {
+        msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]"
+            << std::endl
+            << "Unknown or duplicate axis \"" << axis << "\" in cooling/table_axes. "
+            << "Supported axes are log_temp, log_n_h, and log_z." << std::endl;
+        PARTHENON_FAIL(msg);
+      }
+      table_axes.push_back(axis);
+    }
+  }
+  PARTHENON_REQUIRE_THROWS(std::find(table_axes.begin(), table_axes.end(), "log_temp") !=
+                               table_axes.end(),
+                           "cooling/table_axes needs to contain log_temp");
+  const auto n_axes = table_axes.size();
+
   /****************************************
    * Read tab file with IOWrapper
    ****************************************/
@@ -101,9 +190,10 @@ TabularCooling::TabularCooling(ParameterInput *pin,
   input.Close();
 
   /****************************************
-   * Determine log_temps and and log_lambdas vectors
+   * Determine the axes values and log_lambdas of each line
    ****************************************/
-  std::vector<Real> log_temps, log_lambdas;
+  std::vector<std::vector<Real>> axes_values(n_axes);
+  std::vector<Real> line_log_lambdas;
   std::string line;
   std::size_t first_char;
   while (tab_ss.good()) {
@@ -118,20 +208,21 @@ TabularCooling::TabularCooling(ParameterInput *pin,
     std::vector<std::string> line_data{std::istream_iterator<std::string>{iss},
                                        std::istream_iterator<std::string>{}};
     // Check size
-    if (line_data.empty() || line_data.size() != 2) {
+    if (line_data.empty() || line_data.size() != n_axes + 1) {
       msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
-          << "Expected exactly two columns per line but got: \"" << line << "\""
-          << std::endl;
+          << "Expected exactly " << n_axes + 1 << " columns per line but got: \""
+          << line << "\"" << std::endl;
       PARTHENON_FAIL(msg);
     }
 
     try {
-      const Real log_temp = std::stod(line_data[0]);
-      const Real log_lambda = std::stod(line_data[1]);
+      for (size_t n = 0; n < n_axes; n++) {
+        axes_values[n].push_back(std::stod(line_data[n]));
+      }
+      const Real log_lambda = std::stod(line_data[n_axes]);
 
       // Add to growing list
-      log_temps.push_back(log_temp);
-      log_lambdas.push_back(log_lambda - std::log10(lambda_units));
+      line_log_lambdas.push_back(log_lambda - std::log10(lambda_units));
 
     } catch (const std::invalid_argument &ia) {
       msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
@@ -141,79 +232,123 @@ TabularCooling::TabularCooling(ParameterInput *pin,
   }
 
   /****************************************
-   * Check some assumtions about the cooling table
+   * Setup the (sorted) axes and check some assumtions about the cooling table
    ****************************************/
+  std::vector<Real> log_temps, log_n_hs{0.0}, log_zs{0.0};
+  std::vector<std::vector<Real> *> axes;
+  for (size_t n = 0; n < n_axes; n++) {
+    axes.push_back(table_axes[n] == "log_temp"
+                       ? &log_temps
+                       : (table_axes[n] == "log_n_h" ? &log_n_hs : &log_zs));
+    auto &axis = *axes[n];
+    axis = axes_values[n];
+    std::sort(axis.begin(), axis.end());
+    axis.erase(std::unique(axis.begin(), axis.end()), axis.end());
+  }
+  const auto n_temp = log_temps.size();
+  const auto n_n_h = log_n_hs.size();
+  const auto n_z = log_zs.size();
 
   // Ensure at least two data points in the table to interpolate from
-  if (log_temps.size() < 2 || log_lambdas.size() < 2) {
+  if (n_temp < 2) {
     msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
         << "Not enough data to interpolate cooling" << std::endl;
     PARTHENON_FAIL(msg);
   }
 
-  // Ensure that the first log_temp is increasing
-  const Real log_temp_start = log_temps[0];
-  const Real d_log_temp = log_temps[1] - log_temp_start;
-
-  if (d_log_temp <= 0) {
+  // Ensure that the table covers the full grid (with each point exactly once)
+  if (line_log_lambdas.size() != n_temp * n_n_h * n_z) {
     msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
-        << "second log_temp in table is descreasing" << std::endl;
+        << "Cooling table with " << line_log_lambdas.size() << " entries does not match "
+        << "the grid of " << n_temp << " log_temp x " << n_n_h << " log_n_h x " << n_z
+        << " log_z values" << std::endl;
     PARTHENON_FAIL(msg);
   }
-
-  // Ensure that log_temps is evenly spaced
-  for (size_t i = 1; i < log_temps.size(); i++) {
-    const Real d_log_temp_i = log_temps[i] - log_temps[i - 1];
-
-    if (d_log_temp_i < 0) {
-      msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
-          << "log_temp in table is descreasing at i= " << i
-          << " log_temp= " << log_temps[i] << std::endl;
-      PARTHENON_FAIL(msg);
+  std::vector<Real> log_lambdas(line_log_lambdas.size());
+  std::vector<bool> is_set(line_log_lambdas.size(), false);
+  for (size_t l = 0; l < line_log_lambdas.size(); l++) {
+    // log_temp varies fastest, then log_n_h, then log_z
+    size_t offset = 0;
+    for (size_t n = 0; n < n_axes; n++) {
+      const auto &axis = *axes[n];
+      const size_t stride = table_axes[n] == "log_temp"
+                                ? 1
+                                : (table_axes[n] == "log_n_h" ? n_temp : n_temp * n_n_h);
+      offset += stride * (std::lower_bound(axis.begin(), axis.end(), axes_values[n][l]) -
+                          axis.begin());
     }
-
-    // The Dedt() function currently relies on an equally spaced cooling table for faster
-    // lookup (direct indexing). It is used in the subcycling method and in order to
-    // restrict `dt` by a cooling cfl.
-    if (((integrator_ != CoolIntegrator::townsend) || (cooling_time_cfl_ > 0.0)) &&
-        (fabs(d_log_temp_i - d_log_temp) / d_log_temp > d_log_temp_tol_)) {
+    if (is_set[offset]) {
       msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
-          << "d_log_temp in table is uneven at i=" << i << " log_temp=" << log_temps[i]
-          << " d_log_temp= " << d_log_temp << " d_log_temp_i= " << d_log_temp_i
-          << " diff= " << d_log_temp_i - d_log_temp
-          << " rel_diff= " << fabs(d_log_temp_i - d_log_temp) / d_log_temp
-          << " tol= " << d_log_temp_tol_ << std::endl;
+          << "Duplicate entry in cooling table at log_temp= "
+          << log_temps[offset % n_temp]
+          << " log_n_h= " << log_n_hs[(offset / n_temp) % n_n_h]
+          << " log_z= " << log_zs[offset / (n_temp * n_n_h)] << std::endl;
       PARTHENON_FAIL(msg);
     }
+    is_set[offset] = true;
+    log_lambdas[offset] = line_log_lambdas[l];
+  }
+
+  // Metallicity used in the lookup
+  log_metallicity_ = pin->GetOrAddReal("cooling", "log_metallicity", 0.0);
+  const auto metallicity_scalar =
+      pin->GetOrAddInteger("cooling", "metallicity_scalar", -1);
+  if (metallicity_scalar >= 0) {
+    PARTHENON_REQUIRE_THROWS(n_z > 1, "cooling/metallicity_scalar requires a cooling "
+                                      "table with a log_z axis.");
+    PARTHENON_REQUIRE_THROWS(
+        metallicity_scalar < pin->GetOrAddInteger("hydro", "nscalars", 0),
+        "cooling/metallicity_scalar needs to be smaller than hydro/nscalars");
+    metallicity_idx_ = hydro_pkg->Param<int>("nhydro") + metallicity_scalar;
+  } else {
+    metallicity_idx_ = -1;
   }
 
   /****************************************
    * Move values read into the data table
    ****************************************/
 
-  n_temp_ = log_temps.size();
+  n_temp_ = n_temp;
   log_temp_start_ = log_temps[0];
   log_temp_final_ = log_temps[n_temp_ - 1];
-  d_log_temp_ = d_log_temp;
   lambda_final_ = std::pow(10.0, log_lambdas[n_temp_ - 1]);
 
-  // Setup log_lambdas_ used in Dedt()
+  // Setup log_lambdas_ (and the axes) used in Dedt()
   {
     // log_lambdas is used if the integrator isn't Townsend, if the cooling CFL
     // is set, or if cooling time is a extra derived field. Since we don't have
     // a good way to check the last condition we always initialize log_lambdas_
-    log_lambdas_ = ParArray1D<Real>("log_lambdas_", n_temp_);
+    log_lambdas_ = ParArray1D<Real>("log_lambdas_", log_lambdas.size());
 
     // Read log_lambdas in host_log_lambdas, changing to code units along the way
     auto host_log_lambdas = Kokkos::create_mirror_view(log_lambdas_);
-    for (unsigned int i = 0; i < n_temp_; i++) {
+    for (unsigned int i = 0; i < log_lambdas.size(); i++) {
       host_log_lambdas(i) = log_lambdas[i];
     }
     // Copy host_log_lambdas into device memory
     Kokkos::deep_copy(log_lambdas_, host_log_lambdas);
   }
+  auto copy_axis = [](const std::string &label, const std::vector<Real> &axis) {
+    ParArray1D<Real> arr(label, axis.size());
+    auto host_arr = Kokkos::create_mirror_view(arr);
+    for (size_t i = 0; i < axis.size(); i++) {
+      host_arr(i) = axis[i];
+    }
+    Kokkos::deep_copy(arr, host_arr);
+    return arr;
+  };
+  const auto log_temps_arr = copy_axis("log_temps", log_temps);
+  const auto log_n_hs_arr = copy_axis("log_n_hs", log_n_hs);
+  const auto log_zs_arr = copy_axis("log_zs", log_zs);
+
+  // Setup the lookup index of the temperature bins
+  Real d_log_temp_index;
+  const auto temp_bin_index =
+      CoolingTableObj::MakeTempBinIndex(log_temps, d_log_temp_index);
+
   // Setup Townsend cooling, i.e., precalulcate piecewise powerlaw approx.
-  if (integrator_ == CoolIntegrator::townsend) {
+  // Tables depending on density or metallicity are integrated bin by bin instead.
+  if (integrator_ == CoolIntegrator::townsend && n_n_h == 1 && n_z == 1) {
     lambdas_ = ParArray1D<Real>("lambdas_", n_temp_);
     temps_ = ParArray1D<Real>("temps_", n_temp_);
 
@@ -270,16 +405,18 @@ TabularCooling::TabularCooling(ParameterInput *pin,
   const auto adiabatic_index = hydro_pkg->Param<Real>("AdiabaticIndex");
   const auto He_mass_fraction = hydro_pkg->Param<Real>("He_mass_fraction");
 
-  cooling_table_obj_ = CoolingTableObj(log_lambdas_, log_temp_start_, log_temp_final_,
-                                       d_log_temp_, n_temp_, mbar_over_kb,
-                                       adiabatic_index, 1.0 - He_mass_fraction, units);
+  cooling_table_obj_ = CoolingTableObj(
+      log_lambdas_, log_temps_arr, log_n_hs_arr, log_zs_arr, temp_bin_index,
+      log_temp_start_, log_temp_final_, d_log_temp_index, log_metallicity_, mbar_over_kb,
+      adiabatic_index, 1.0 - He_mass_fraction, units);
 }
 
-void TabularCooling::SrcTerm(MeshData<Real> *md, const Real dt) const {
+void TabularCooling::SrcTerm(MeshData<Real> *md, const Real dt,
+                             const SimTime &tm) const {
   if (integrator_ == CoolIntegrator::rk12) {
-    SubcyclingFixedIntSrcTerm<RK12Stepper>(md, dt, RK12Stepper());
+    SubcyclingFixedIntSrcTerm<RK12Stepper>(md, dt, tm, RK12Stepper());
   } else if (integrator_ == CoolIntegrator::rk45) {
-    SubcyclingFixedIntSrcTerm<RK45Stepper>(md, dt, RK45Stepper());
+    SubcyclingFixedIntSrcTerm<RK45Stepper>(md, dt, tm, RK45Stepper());
   } else if (integrator_ == CoolIntegrator::townsend) {
     TownsendSrcTerm(md, dt);
   } else {
@@ -289,6 +426,7 @@ void TabularCooling::SrcTerm(MeshData<Real> *md, const Real dt) const {
 
 template <typename RKStepper>
 void TabularCooling::SubcyclingFixedIntSrcTerm(MeshData<Real> *md, const Real dt_,
+                                               const SimTime &tm,
                                                const RKStepper rk_stepper) const {
 
   const auto dt = dt_; // HACK capturing parameters still broken with Cuda 11.6 ...
@@ -306,6 +444,9 @@ void TabularCooling::SubcyclingFixedIntSrcTerm(MeshData<Real> *md, const Real dt
 
   const Real d_e_tol = d_e_tol_;
 
+  const auto metallicity_idx = metallicity_idx_;
+  const auto log_metallicity = log_metallicity_;
+
   // Determine the cooling floor, whichever is higher of the cooling table floor
   // or fluid solver floor
   const auto temp_cool_floor = std::pow(10.0, log_temp_start_); // low end of cool table
@@ -322,168 +463,227 @@ void TabularCooling::SubcyclingFixedIntSrcTerm(MeshData<Real> *md, const Real dt
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
 
-  par_for(
-      DEFAULT_LOOP_PATTERN, "TabularCooling::SubcyclingSplitSrcTerm", DevExecSpace(), 0,
-      cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
-        auto &cons = cons_pack(b);
-        auto &prim = prim_pack(b);
-        // Need to use `cons` here as prim may still contain state at t_0;
-        const Real rho = cons(IDN, k, j, i);
-        // TODO(pgrete) with potentially more EOS, a separate get_pressure (or similar)
-        // function could be useful.
-        Real internal_e =
-            cons(IEN, k, j, i) - 0.5 *
-                                     (SQR(cons(IM1, k, j, i)) + SQR(cons(IM2, k, j, i)) +
-                                      SQR(cons(IM3, k, j, i))) /
-                                     rho;
-        if (mhd_enabled) {
-          internal_e -= 0.5 * (SQR(cons(IB1, k, j, i)) + SQR(cons(IB2, k, j, i)) +
-                               SQR(cons(IB3, k, j, i)));
-        }
-        internal_e /= rho;
-        const Real internal_e_initial = internal_e;
-
-        bool dedt_valid = true;
-
-        // Wrap DeDt into a functor for the RKStepper
-        auto DeDt_wrapper = [&](const Real t, const Real e, bool &valid) {
-          return cooling_table_obj.DeDt(e, rho, valid);
-        };
-
-        Real sub_t = 0; // current subcycle time
-        // Try full dt. If error is too large adaptive timestepping will reduce sub_dt
-        Real sub_dt = dt;
-
-        // Check if cooling is actually happening, e.g., when T below T_cool_min or if
-        // temperature is already below floor.
-        const Real dedt_initial = DeDt_wrapper(0.0, internal_e_initial, dedt_valid);
-        if (dedt_initial == 0.0 || internal_e_initial <= internal_e_floor) {
-          return;
-        }
-
-        // Use minumum subcycle timestep when d_e_tol == 0
-        if (d_e_tol == 0) {
-          sub_dt = min_sub_dt;
-        }
+  // Cools a single cell and returns the number of subcycles used
+  auto cool_cell = KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+    auto &cons = cons_pack(b);
+    auto &prim = prim_pack(b);
+    // Need to use `cons` here as prim may still contain state at t_0;
+    const Real rho = cons(IDN, k, j, i);
+    // TODO(pgrete) with potentially more EOS, a separate get_pressure (or similar)
+    // function could be useful.
+    Real internal_e =
+        cons(IEN, k, j, i) - 0.5 *
+                                 (SQR(cons(IM1, k, j, i)) + SQR(cons(IM2, k, j, i)) +
+                                  SQR(cons(IM3, k, j, i))) /
+                                 rho;
+    if (mhd_enabled) {
+      internal_e -= 0.5 * (SQR(cons(IB1, k, j, i)) + SQR(cons(IB2, k, j, i)) +
+                           SQR(cons(IB3, k, j, i)));
+    }
+    internal_e /= rho;
+    const Real internal_e_initial = internal_e;
+    const Real log_z = metallicity_idx >= 0
+                           ? log10(cons(metallicity_idx, k, j, i) / rho)
+                           : log_metallicity;
+
+    bool dedt_valid = true;
+
+    // Wrap DeDt into a functor for the RKStepper
+    auto DeDt_wrapper = [&](const Real t, const Real e, bool &valid) {
+      return cooling_table_obj.DeDt(e, rho, log_z, valid);
+    };
+
+    Real sub_t = 0; // current subcycle time
+    // Try full dt. If error is too large adaptive timestepping will reduce sub_dt
+    Real sub_dt = dt;
+
+    // Check if cooling is actually happening, e.g., when T below T_cool_min or if
+    // temperature is already below floor.
+    const Real dedt_initial = DeDt_wrapper(0.0, internal_e_initial, dedt_valid);
+    if (dedt_initial == 0.0 || internal_e_initial <= internal_e_floor) {
+      return 0u;
+    }
 
-        unsigned int sub_iter = 0;
-        // check for dedt != 0.0 required in case cooling floor it hit during subcycling
-        while ((sub_t * (1 + KEpsilon_) < dt) &&
-               (DeDt_wrapper(sub_t, internal_e, dedt_valid) != 0.0)) {
+    // Use minumum subcycle timestep when d_e_tol == 0
+    if (d_e_tol == 0) {
+      sub_dt = min_sub_dt;
+    }
 
-          if (sub_iter > max_iter) {
-            // Due to sub_dt >= min_dt, this error should never happen
-            PARTHENON_FAIL(
-                "FATAL ERROR in [TabularCooling::SubcyclingFixedIntSrcTerm]: Sub "
-                "cycles exceed max_iter (This should be impossible)");
+    unsigned int sub_iter = 0;
+    // check for dedt != 0.0 required in case cooling floor it hit during subcycling
+    while ((sub_t * (1 + KEpsilon_) < dt) &&
+           (DeDt_wrapper(sub_t, internal_e, dedt_valid) != 0.0)) {
+
+      if (sub_iter > max_iter) {
+        // Due to sub_dt >= min_dt, this error should never happen
+        PARTHENON_FAIL(
+            "FATAL ERROR in [TabularCooling::SubcyclingFixedIntSrcTerm]: Sub "
+            "cycles exceed max_iter (This should be impossible)");
+      }
+
+      // Next higher order estimate
+      Real internal_e_next_h;
+      // Error in estimate of higher order
+      Real d_e_err;
+      // Number of attempts on this subcycle
+      unsigned int sub_attempt = 0;
+      // Whether to reattempt this subcycle
+      bool reattempt_sub = true;
+      do {
+        // Next lower order estimate
+        Real internal_e_next_l;
+        // Do one dual order RK step
+        dedt_valid = true;
+        RKStepper::Step(sub_t, sub_dt, internal_e, DeDt_wrapper, internal_e_next_h,
+                        internal_e_next_l, dedt_valid);
+
+        sub_attempt++;
+
+        if (!dedt_valid) {
+          if (sub_dt == min_sub_dt) {
+            // Cooling is so fast that even the minimum subcycle dt would lead to
+            // negative internal energy -- so just cool to the floor of the cooling
+            // table
+            sub_dt = (dt - sub_t);
+            internal_e_next_h = internal_e_floor;
+            reattempt_sub = false;
+          } else {
+            reattempt_sub = true;
+            sub_dt = min_sub_dt;
           }
-
-          // Next higher order estimate
-          Real internal_e_next_h;
-          // Error in estimate of higher order
-          Real d_e_err;
-          // Number of attempts on this subcycle
-          unsigned int sub_attempt = 0;
-          // Whether to reattempt this subcycle
-          bool reattempt_sub = true;
-          do {
-            // Next lower order estimate
-            Real internal_e_next_l;
-            // Do one dual order RK step
-            dedt_valid = true;
-            RKStepper::Step(sub_t, sub_dt, internal_e, DeDt_wrapper, internal_e_next_h,
-                            internal_e_next_l, dedt_valid);
-
-            sub_attempt++;
-
-            if (!dedt_valid) {
-              if (sub_dt == min_sub_dt) {
-                // Cooling is so fast that even the minimum subcycle dt would lead to
-                // negative internal energy -- so just cool to the floor of the cooling
-                // table
-                sub_dt = (dt - sub_t);
-                internal_e_next_h = internal_e_floor;
-                reattempt_sub = false;
-              } else {
-                reattempt_sub = true;
-                sub_dt = min_sub_dt;
-              }
+        } else {
+
+          // Compute error
+          d_e_err = fabs((internal_e_next_h - internal_e_next_l) / internal_e_next_h);
+
+          reattempt_sub = false;
+          // Accepting or reattempting the subcycle:
+          //
+          // -If the error is small, accept the subcycle
+          //
+          // -If the error on the subcycle is too high, compute a new time
+          // step to reattempt the subcycle
+          //   -But if the new time step is smaller than the minimum subcycle
+          //   time step (total step duration/ max iterations), just use the
+          //   minimum subcycle time step instead
+
+          if (std::isnan(d_e_err)) {
+            reattempt_sub = true;
+            sub_dt = min_sub_dt;
+          } else if (d_e_err >= d_e_tol && sub_dt > min_sub_dt) {
+            // Reattempt this subcycle
+            reattempt_sub = true;
+            // Error was too high, shrink the timestep
+            if (d_e_tol == 0) {
+              sub_dt = min_sub_dt;
             } else {
-
-              // Compute error
-              d_e_err = fabs((internal_e_next_h - internal_e_next_l) / internal_e_next_h);
-
-              reattempt_sub = false;
-              // Accepting or reattempting the subcycle:
-              //
-              // -If the error is small, accept the subcycle
-              //
-              // -If the error on the subcycle is too high, compute a new time
-              // step to reattempt the subcycle
-              //   -But if the new time step is smaller than the minimum subcycle
-              //   time step (total step duration/ max iterations), just use the
-              //   minimum subcycle time step instead
-
-              if (std::isnan(d_e_err)) {
-                reattempt_sub = true;
-                sub_dt = min_sub_dt;
-              } else if (d_e_err >= d_e_tol && sub_dt > min_sub_dt) {
-                // Reattempt this subcycle
-                reattempt_sub = true;
-                // Error was too high, shrink the timestep
-                if (d_e_tol == 0) {
-                  sub_dt = min_sub_dt;
-                } else {
-                  sub_dt = RKStepper::OptimalStep(sub_dt, d_e_err, d_e_tol);
-                }
-                // Don't drop timestep under maximum iteration count
-                if (sub_dt < min_sub_dt || sub_attempt >= max_iter) {
-                  sub_dt = min_sub_dt;
-                }
-              }
+              sub_dt = RKStepper::OptimalStep(sub_dt, d_e_err, d_e_tol);
+            }
+            // Don't drop timestep under maximum iteration count
+            if (sub_dt < min_sub_dt || sub_attempt >= max_iter) {
+              sub_dt = min_sub_dt;
             }
+          }
+        }
 
-          } while (reattempt_sub);
-          // Accept this subcycle
-          sub_t += sub_dt;
+      } while (reattempt_sub);
+      // Accept this subcycle
+      sub_t += sub_dt;
 
-          internal_e = internal_e_next_h;
+      internal_e = internal_e_next_h;
 
-          // skip to the end of subcycling if error is 0 (very unlikely)
-          if (d_e_err == 0) {
-            sub_dt = dt - sub_t;
-          } else {
-            // Grow the timestep
-            // (or shrink in case d_e_err >= d_e_tol and sub_dt is already at min_sub_dt)
-            sub_dt = RKStepper::OptimalStep(sub_dt, d_e_err, d_e_tol);
-          }
+      // skip to the end of subcycling if error is 0 (very unlikely)
+      if (d_e_err == 0) {
+        sub_dt = dt - sub_t;
+      } else {
+        // Grow the timestep
+        // (or shrink in case d_e_err >= d_e_tol and sub_dt is already at min_sub_dt)
+        sub_dt = RKStepper::OptimalStep(sub_dt, d_e_err, d_e_tol);
+      }
 
-          if (d_e_tol == 0) {
-            sub_dt = min_sub_dt;
-          }
+      if (d_e_tol == 0) {
+        sub_dt = min_sub_dt;
+      }
 
-          // Don't drop timestep under the minimum step size
-          sub_dt = std::max(sub_dt, min_sub_dt);
+      // Don't drop timestep under the minimum step size
+      sub_dt = std::max(sub_dt, min_sub_dt);
 
-          // Limit by end time
-          sub_dt = std::min(sub_dt, dt - sub_t);
+      // Limit by end time
+      sub_dt = std::min(sub_dt, dt - sub_t);
 
-          sub_iter++;
-        }
+      sub_iter++;
+    }
 
-        // If cooled below floor, reset to floor value.
-        // This could happen if the floor value is larger than the lower end of the
-        // cooling table or if they are close and the last subcycle in the cooling above
-        // the lower end pushed the temperature below the lower end (and the floor).
-        internal_e = (internal_e > internal_e_floor) ? internal_e : internal_e_floor;
+    // If cooled below floor, reset to floor value.
+    // This could happen if the floor value is larger than the lower end of the
+    // cooling table or if they are close and the last subcycle in the cooling above
+    // the lower end pushed the temperature below the lower end (and the floor).
+    internal_e = (internal_e > internal_e_floor) ? internal_e : internal_e_floor;
+
+    // Remove the cooling from the total energy density
+    cons(IEN, k, j, i) += rho * (internal_e - internal_e_initial);
+    // Latter technically not required if no other tasks follows before
+    // ConservedToPrim conversion, but keeping it for now (better safe than sorry).
+    prim(IPR, k, j, i) = rho * internal_e * gm1;
+
+    return sub_iter;
+  };
+
+  if (!track_subcycles_) {
+    par_for(
+        DEFAULT_LOOP_PATTERN, "TabularCooling::SubcyclingSplitSrcTerm", DevExecSpace(), 0,
+        cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+          cool_cell(b, k, j, i);
+        });
+    return;
+  }
 
-        // Remove the cooling from the total energy density
-        cons(IEN, k, j, i) += rho * (internal_e - internal_e_initial);
-        // Latter technically not required if no other tasks follows before
-        // ConservedToPrim conversion, but keeping it for now (better safe than sorry).
-        prim(IPR, k, j, i) = rho * internal_e * gm1;
+  // Also count the subcycles (reduced within each row of cells first to limit the number
+  // of atomics). The counter of this rank stays on the device and the counts of each
+  // block are only required (and copied to the host) when the block costs are updated,
+  // i.e., every subcycle_cost_interval_ cycles as every update triggers a load balancing.
+  const auto nblocks = cons_pack.GetDim(5);
+  const auto subcycles = hydro_pkg->Param<ParArray1D<Real>>("cooling_subcycles");
+  const bool set_cost = subcycle_cost_ > 0.0 && tm.ncycle % subcycle_cost_interval_ == 0;
+  ParArray1D<Real> block_subcycles;
+  if (set_cost) {
+    block_subcycles = ParArray1D<Real>("block_subcycles", nblocks);
+  }
+  parthenon::par_for_outer(
+      DEFAULT_OUTER_LOOP_PATTERN, "TabularCooling::SubcyclingSplitSrcTerm",
+      DevExecSpace(), 0, 0, 0, nblocks - 1, kb.s, kb.e, jb.s, jb.e,
+      KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int k, const int j) {
+        Real row_subcycles = 0.0;
+        Kokkos::parallel_reduce(
+            Kokkos::TeamThreadRange(member, ib.s, ib.e + 1),
+            [&](const int i, Real &lsubcycles) { lsubcycles += cool_cell(b, k, j, i); },
+            row_subcycles);
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          Kokkos::atomic_add(&subcycles(0), row_subcycles);
+          if (set_cost) {
+            Kokkos::atomic_add(&block_subcycles(b), row_subcycles);
+          }
+        });
       });
+
+  // Update the per rank number of cell updates for the history output (tasks are
+  // executed sequentially so modifying the package is safe)
+  const auto ncells_block = static_cast<Real>((ib.e - ib.s + 1) * (jb.e - jb.s + 1) *
+                                              (kb.e - kb.s + 1));
+  hydro_pkg->UpdateParam("cooling_cell_updates",
+                         hydro_pkg->Param<Real>("cooling_cell_updates") +
+                             nblocks * ncells_block);
+
+  // Set the cost of each block for load balancing
+  if (set_cost) {
+    auto block_subcycles_h =
+        Kokkos::create_mirror_view_and_copy(parthenon::HostMemSpace(), block_subcycles);
+    for (int b = 0; b < nblocks; b++) {
+      md->GetBlockData(b)->GetBlockPointer()->SetCostForLoadBalancing(
+          1.0 + subcycle_cost_ * block_subcycles_h(b) / ncells_block);
+    }
+  }
 }
 
 void TabularCooling::TownsendSrcTerm(parthenon::MeshData<parthenon::Real> *md,
@@ -517,7 +717,10 @@ void TabularCooling::TownsendSrcTerm(parthenon::MeshData<parthenon::Real> *md,
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
 
-  const auto nbins = alpha_k.extent_int(0);
+  const CoolingTableObj cooling_table_obj = cooling_table_obj_;
+  const bool temperature_only = cooling_table_obj.IsTemperatureOnly();
+  const auto metallicity_idx = metallicity_idx_;
+  const auto log_metallicity = log_metallicity_;
 
   // Get reference values
   const auto temp_final = std::pow(10.0, log_temp_final_);
@@ -560,38 +763,41 @@ void TabularCooling::TownsendSrcTerm(parthenon::MeshData<parthenon::Real> *md,
         if (temp < temp_cool_floor) {
           return;
         }
-        const Real n_h2_by_rho = rho * X_by_mh2;
 
-        // Get the index of the right temperature bin
-        // TODO(?) this could be optimized for using a binary search
-        auto idx = 0;
-        while ((idx < nbins - 1) && (temps(idx + 1) < temp)) {
-          idx += 1;
+        Real temp_new;
+        if (temperature_only) {
+          const Real n_h2_by_rho = rho * X_by_mh2;
+
+          // Get the index of the right temperature bin
+          auto idx = cooling_table_obj.FindTempBin(log10(temp));
+
+          // Compute the Temporal Evolution Function Y(T) (Eq. A5)
+          const auto alpha_k_m1 = alpha_k(idx) - 1.0;
+          const auto tef =
+              Y_k(idx) + (lambda_final / lambdas(idx)) * (temps(idx) / temp_final) *
+                             (std::pow(temps(idx) / temp, alpha_k_m1) - 1.0) / alpha_k_m1;
+
+          // Compute the adjusted TEF for new timestep (Eqn. 26) (term in brackets)
+          const auto tef_adj =
+              tef + lambda_final * dt / temp_final * mbar_gm1_over_kb * n_h2_by_rho;
+
+          // TEF is a strictly decreasing function and new_tef > tef
+          // Check if the new TEF falls into a lower bin, i.e., find the right bin for A7
+          // If so, update slopes and coefficients
+          idx = FindTownsendTEFBin(Y_k, idx, tef_adj);
+
+          // Compute the Inverse Temporal Evolution Function Y^{-1}(Y) (Eq. A7)
+          temp_new = temps(idx) *
+                     std::pow(1 - (1.0 - alpha_k(idx)) * (lambdas(idx) / lambda_final) *
+                                      (temp_final / temps(idx)) * (tef_adj - Y_k(idx)),
+                              1.0 / (1.0 - alpha_k(idx)));
+        } else {
+          // Tables depending on density or metallicity are integrated bin by bin
+          const Real log_z = metallicity_idx >= 0
+                                 ? log10(cons(metallicity_idx, k, j, i) / rho)
+                                 : log_metallicity;
+          temp_new = cooling_table_obj.IntegrateTemp(temp, rho, log_z, dt);
         }
-
-        // Compute the Temporal Evolution Function Y(T) (Eq. A5)
-        const auto alpha_k_m1 = alpha_k(idx) - 1.0;
-        const auto tef =
-            Y_k(idx) + (lambda_final / lambdas(idx)) * (temps(idx) / temp_final) *
-                           (std::pow(temps(idx) / temp, alpha_k_m1) - 1.0) / alpha_k_m1;
-
-        // Compute the adjusted TEF for new timestep (Eqn. 26) (term in brackets)
-        const auto tef_adj =
-            tef + lambda_final * dt / temp_final * mbar_gm1_over_kb * n_h2_by_rho;
-
-        // TEF is a strictly decreasing function and new_tef > tef
-        // Check if the new TEF falls into a lower bin, i.e., find the right bin for A7
-        // If so, update slopes and coefficients
-        while ((idx > 0) && (tef_adj > Y_k(idx))) {
-          idx -= 1;
-        }
-
-        // Compute the Inverse Temporal Evolution Function Y^{-1}(Y) (Eq. A7)
-        const auto temp_new =
-            temps(idx) *
-            std::pow(1 - (1.0 - alpha_k(idx)) * (lambdas(idx) / lambda_final) *
-                             (temp_final / temps(idx)) * (tef_adj - Y_k(idx)),
-                     1.0 / (1.0 - alpha_k(idx)));
         // Set new temp (at the lowest to the lower end of the cooling table)
         const auto internal_e_new = temp_new > temp_cool_floor
                                         ? temp_new / mbar_gm1_over_kb
@@ -625,6 +831,9 @@ Real TabularCooling::EstimateTimeStep(MeshData<Real> *md) const {
 
   const Real internal_e_floor = temp_floor / mbar_gm1_over_kb; // specific internal en.
 
+  const auto metallicity_idx = metallicity_idx_;
+  const auto log_metallicity = log_metallicity_;
+
   // Grab some necessary variables
   const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
   IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
@@ -647,8 +856,10 @@ Real TabularCooling::EstimateTimeStep(MeshData<Real> *md) const {
         const Real pres = prim(IPR, k, j, i);
 
         const Real internal_e = pres / (rho * gm1);
+        const Real log_z = metallicity_idx >= 0 ? log10(prim(metallicity_idx, k, j, i))
+                                                : log_metallicity;
 
-        const Real de_dt = cooling_table_obj.DeDt(internal_e, rho);
+        const Real de_dt = cooling_table_obj.DeDt(internal_e, rho, log_z);
 
         // Compute cooling time
         // If de_dt is zero (temperature is smaller than lower end of cooling table) or
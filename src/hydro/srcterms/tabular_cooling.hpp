@@ -9,14 +9,18 @@
 #define HYDRO_SRCTERMS_TABULAR_COOLING_HPP_
 
 // C++ headers
+#include <algorithm> // min
+#include <cmath>     // ceil, fabs, log10, pow
 #include <fstream>   // stringstream
 #include <iterator>  // istream_iterator
+#include <limits>    // numeric_limits
 #include <sstream>   // stringstream
 #include <stdexcept> // runtime_error
 #include <string>    // string
 #include <vector>    // vector
 
 // Parthenon headers
+#include <basic_types.hpp>
 #include <interface/mesh_data.hpp>
 #include <interface/variable_pack.hpp>
 #include <mesh/domain.hpp>
@@ -87,21 +91,55 @@ struct RK45Stepper {
 
 enum class CoolIntegrator { undefined, rk12, rk45, townsend };
 
+// Get the index of the bin for the adjusted temporal evolution function tef_adj, i.e.,
+// the largest idx in [0, idx_start] with tef_adj <= Y_k(idx) (or 0 if there is none)
+// using a binary search given that Y_k is strictly decreasing.
+KOKKOS_INLINE_FUNCTION int
+FindTownsendTEFBin(const parthenon::ParArray1D<parthenon::Real> &Y_k, const int idx_start,
+                   const parthenon::Real tef_adj) {
+  if (!(tef_adj > Y_k(idx_start))) {
+    return idx_start;
+  }
+  int lo = 0;
+  int hi = idx_start;
+  while (hi - lo > 1) {
+    const int mid = (lo + hi) / 2;
+    if (!(tef_adj > Y_k(mid))) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
 class CoolingTableObj {
   /************************************************************
    *  Cooling Table Object, for interpolating a cooling rate out of a cooling
-   *  table. Currently assumes evenly space log_temperatures in cooling table
+   *  table. The log temperatures do not need to be evenly spaced and the table
+   *  may optionally depend on the hydrogen number density and the metallicity.
    *
    *  Lightweight object intended for inlined computation within kernels
    ************************************************************/
  private:
-  // Log cooling rate/ne^3
+  // Log cooling rate/ne^3 with log_temp varying fastest, then log_n_h, then log_z
   parthenon::ParArray1D<parthenon::Real> log_lambdas_;
 
-  // Spacing of cooling table
-  // TODO: assumes evenly spaced cooling table
-  parthenon::Real log_temp_start_, log_temp_final_, d_log_temp_;
-  unsigned int n_temp_;
+  // Axes of the cooling table (log_n_hs_ and log_zs_ contain a single, unused entry if
+  // the table does not depend on the density or metallicity)
+  parthenon::ParArray1D<parthenon::Real> log_temps_, log_n_hs_, log_zs_;
+  int n_temp_, n_n_h_, n_z_;
+  parthenon::Real log_temp_start_, log_temp_final_;
+
+  // Lookup index of the temperature bins with uniform spacing (at most the smallest
+  // bin width) so that log_temp_start_ + c * d_log_temp_index_ is in bin
+  // temp_bin_index_(c)
+  parthenon::ParArray1D<int> temp_bin_index_;
+  parthenon::Real d_log_temp_index_;
+  int n_temp_index_;
+
+  // Log metallicity used if none is provided
+  parthenon::Real log_z_default_;
 
   // Mean molecular mass * ( adiabatic_index -1) / boltzmann_constant
   parthenon::Real mbar_gm1_over_k_B_;
@@ -109,25 +147,170 @@ class CoolingTableObj {
   // (Hydrogen mass fraction / hydrogen atomic mass)^2
   parthenon::Real x_H_over_m_h2_;
 
+  // log10 of the hydrogen number density (in cm^-3) per unit (code) density
+  parthenon::Real log_n_h_per_rho_;
+
+  // Get the index of the bin containing x in the (sorted) axis of size n, i.e., the
+  // largest idx in [0, n - 2] with axis(idx) <= x, and the linear interpolation weight of
+  // axis(idx + 1). Values outside the axis are clamped to its ends.
+  KOKKOS_INLINE_FUNCTION static void
+  GetAxisWeight(const parthenon::ParArray1D<parthenon::Real> &axis, const int n,
+                const parthenon::Real x, int &idx, parthenon::Real &weight) {
+    idx = 0;
+    weight = 0.0;
+    if ((n == 1) || !(x > axis(0))) {
+      return;
+    }
+    if (!(x < axis(n - 1))) {
+      idx = n - 2;
+      weight = 1.0;
+      return;
+    }
+    int hi = n - 1;
+    while (hi - idx > 1) {
+      const int mid = (idx + hi) / 2;
+      if (axis(mid) <= x) {
+        idx = mid;
+      } else {
+        hi = mid;
+      }
+    }
+    weight = (x - axis(idx)) / (axis(idx + 1) - axis(idx));
+  }
+
  public:
+  // Offsets and weights of the (up to four) temperature columns of the table used to
+  // interpolate the cooling rate at a given hydrogen number density and metallicity
+  struct ColumnStencil {
+    int offset[4];
+    parthenon::Real weight[4];
+    int n;
+  };
+
   CoolingTableObj()
-      : log_lambdas_(), log_temp_start_(NAN), log_temp_final_(NAN), d_log_temp_(NAN),
-        n_temp_(0), mbar_gm1_over_k_B_(NAN), x_H_over_m_h2_(NAN) {}
+      : log_lambdas_(), log_temps_(), log_n_hs_(), log_zs_(), n_temp_(0), n_n_h_(0),
+        n_z_(0), log_temp_start_(NAN), log_temp_final_(NAN), temp_bin_index_(),
+        d_log_temp_index_(NAN), n_temp_index_(0), log_z_default_(NAN),
+        mbar_gm1_over_k_B_(NAN), x_H_over_m_h2_(NAN), log_n_h_per_rho_(NAN) {}
   CoolingTableObj(const parthenon::ParArray1D<parthenon::Real> log_lambdas,
+                  const parthenon::ParArray1D<parthenon::Real> log_temps,
+                  const parthenon::ParArray1D<parthenon::Real> log_n_hs,
+                  const parthenon::ParArray1D<parthenon::Real> log_zs,
+                  const parthenon::ParArray1D<int> temp_bin_index,
                   const parthenon::Real log_temp_start,
-                  const parthenon::Real log_temp_final, const parthenon::Real d_log_temp,
-                  const unsigned int n_temp, const parthenon::Real mbar_over_kb,
+                  const parthenon::Real log_temp_final,
+                  const parthenon::Real d_log_temp_index,
+                  const parthenon::Real log_z_default, const parthenon::Real mbar_over_kb,
                   const parthenon::Real adiabatic_index, const parthenon::Real x_H,
                   const Units units)
-      : log_lambdas_(log_lambdas), log_temp_start_(log_temp_start),
-        log_temp_final_(log_temp_final), d_log_temp_(d_log_temp), n_temp_(n_temp),
+      : log_lambdas_(log_lambdas), log_temps_(log_temps), log_n_hs_(log_n_hs),
+        log_zs_(log_zs), n_temp_(log_temps.extent_int(0)),
+        n_n_h_(log_n_hs.extent_int(0)), n_z_(log_zs.extent_int(0)),
+        log_temp_start_(log_temp_start), log_temp_final_(log_temp_final),
+        temp_bin_index_(temp_bin_index), d_log_temp_index_(d_log_temp_index),
+        n_temp_index_(temp_bin_index.extent_int(0)), log_z_default_(log_z_default),
         mbar_gm1_over_k_B_(mbar_over_kb * (adiabatic_index - 1)),
-        x_H_over_m_h2_(SQR(x_H / units.mh())) {}
+        x_H_over_m_h2_(SQR(x_H / units.mh())),
+        log_n_h_per_rho_(std::log10(x_H / units.mh() * std::pow(units.cm(), 3))) {}
+
+  // Setup the lookup index of the temperature bins for the (sorted) log temperatures of a
+  // table. Its spacing (returned in d_log_temp_index) is the smallest bin width so that
+  // each index entry contains at most one temperature of the table, but the index is
+  // limited in size for tables with very unevenly spaced temperatures.
+  static parthenon::ParArray1D<int>
+  MakeTempBinIndex(const std::vector<parthenon::Real> &log_temps,
+                   parthenon::Real &d_log_temp_index) {
+    using parthenon::Real;
+    const auto n_temp = log_temps.size();
+    const Real log_temp_start = log_temps.front();
+    const Real log_temp_final = log_temps.back();
+    Real d_log_temp_min = std::numeric_limits<Real>::max();
+    for (size_t i = 1; i < n_temp; i++) {
+      d_log_temp_min = std::min(d_log_temp_min, log_temps[i] - log_temps[i - 1]);
+    }
+    const int max_n_temp_index = 16 * (n_temp - 1);
+    const Real n_temp_index_min =
+        std::ceil((log_temp_final - log_temp_start) / d_log_temp_min - 1e-6);
+    const int n_temp_index =
+        n_temp_index_min > max_n_temp_index ? max_n_temp_index : n_temp_index_min;
+    d_log_temp_index = (log_temp_final - log_temp_start) / n_temp_index;
+    parthenon::ParArray1D<int> temp_bin_index("temp_bin_index", n_temp_index);
+    auto host_temp_bin_index = Kokkos::create_mirror_view(temp_bin_index);
+    size_t i_temp = 0;
+    for (int c = 0; c < n_temp_index; c++) {
+      const Real log_temp = log_temp_start + c * d_log_temp_index;
+      while ((i_temp < n_temp - 2) && (log_temps[i_temp + 1] <= log_temp)) {
+        i_temp++;
+      }
+      host_temp_bin_index(c) = i_temp;
+    }
+    Kokkos::deep_copy(temp_bin_index, host_temp_bin_index);
+    return temp_bin_index;
+  }
+
+  // Whether the table only depends on temperature
+  KOKKOS_INLINE_FUNCTION bool IsTemperatureOnly() const {
+    return (n_n_h_ == 1) && (n_z_ == 1);
+  }
+
+  // Get the index of the temperature bin containing log_temp, i.e., the largest idx in
+  // [0, n_temp_ - 2] with log_temps_(idx) <= log_temp (or 0 if there is none).
+  KOKKOS_INLINE_FUNCTION int FindTempBin(const parthenon::Real log_temp) const {
+    parthenon::Real x = (log_temp - log_temp_start_) / d_log_temp_index_;
+    x = !(x > 0.0) ? 0.0 : (x > n_temp_index_ - 1 ? n_temp_index_ - 1 : x);
+    int idx = temp_bin_index_(static_cast<int>(x));
+    // Given the spacing of the index at most one step is required (apart from roundoff)
+    while ((idx < n_temp_ - 2) && (log_temps_(idx + 1) <= log_temp)) {
+      idx += 1;
+    }
+    while ((idx > 0) && (log_temps_(idx) > log_temp)) {
+      idx -= 1;
+    }
+    return idx;
+  }
+
+  KOKKOS_INLINE_FUNCTION ColumnStencil
+  GetColumnStencil(const parthenon::Real &rho, const parthenon::Real &log_z) const {
+    ColumnStencil stencil;
+    if (IsTemperatureOnly()) {
+      stencil.offset[0] = 0;
+      stencil.weight[0] = 1.0;
+      stencil.n = 1;
+      return stencil;
+    }
+    int i_n_h, i_z;
+    parthenon::Real w_n_h, w_z;
+    GetAxisWeight(log_n_hs_, n_n_h_, log_n_h_per_rho_ + log10(rho), i_n_h, w_n_h);
+    GetAxisWeight(log_zs_, n_z_, log_z, i_z, w_z);
+
+    stencil.n = 0;
+    for (int dz = 0; dz < (n_z_ > 1 ? 2 : 1); dz++) {
+      for (int dn = 0; dn < (n_n_h_ > 1 ? 2 : 1); dn++) {
+        stencil.offset[stencil.n] = ((i_z + dz) * n_n_h_ + i_n_h + dn) * n_temp_;
+        stencil.weight[stencil.n] = (dz == 1 ? w_z : 1.0 - w_z) *
+                                    (dn == 1 ? w_n_h : 1.0 - w_n_h);
+        stencil.n += 1;
+      }
+    }
+    return stencil;
+  }
+
+  // Interpolated log cooling rate at the i_temp-th temperature of the table
+  KOKKOS_INLINE_FUNCTION parthenon::Real GetLogLambda(const ColumnStencil &stencil,
+                                                      const int i_temp) const {
+    parthenon::Real log_lambda = 0.0;
+    for (int n = 0; n < stencil.n; n++) {
+      log_lambda += stencil.weight[n] * log_lambdas_(stencil.offset[n] + i_temp);
+    }
+    return log_lambda;
+  }
 
   // Interpolate a cooling rate from the table
-  // from internal energy density and density
-  KOKKOS_INLINE_FUNCTION parthenon::Real
-  DeDt(const parthenon::Real &e, const parthenon::Real &rho, bool &is_valid) const {
+  // from internal energy density, density, and log metallicity
+  KOKKOS_INLINE_FUNCTION parthenon::Real DeDt(const parthenon::Real &e,
+                                              const parthenon::Real &rho,
+                                              const parthenon::Real &log_z,
+                                              bool &is_valid) const {
     using namespace parthenon;
 
     if (e < 0 || std::isnan(e)) {
@@ -137,34 +320,32 @@ class CoolingTableObj {
 
     const Real temp = mbar_gm1_over_k_B_ * e;
     const Real log_temp = log10(temp);
-    Real log_lambda;
     if (log_temp < log_temp_start_) {
       return 0;
-    } else if (log_temp > log_temp_final_) {
+    }
+    const auto stencil = GetColumnStencil(rho, log_z);
+    Real log_lambda;
+    if (log_temp > log_temp_final_) {
       // Above table
       // Return de/dt
       // TODO(forrestglines):Currently free-free cooling is used for
       // temperatures above the table. This behavior could be generalized via
       // templates
-      log_lambda = 0.5 * log_temp - 0.5 * log_temp_final_ + log_lambdas_(n_temp_ - 1);
+      log_lambda =
+          0.5 * log_temp - 0.5 * log_temp_final_ + GetLogLambda(stencil, n_temp_ - 1);
     } else {
-      // Inside table, interpolate assuming log spaced temperatures
-
-      // Determine where temp is in the table
-      const unsigned int i_temp =
-          static_cast<unsigned int>((log_temp - log_temp_start_) / d_log_temp_);
-      const Real log_temp_i = log_temp_start_ + d_log_temp_ * i_temp;
-
-      // log_temp should be between log_temps[i_temp] and log_temps[i_temp+1]
-      PARTHENON_REQUIRE(log_temp >= log_temp_i && log_temp <= log_temp_i + d_log_temp_,
-                        "FATAL ERROR in [CoolingTable::DeDt]: Failed to find log_temp");
+      // Inside table, interpolate between the temperatures of the bin
+      const int i_temp = FindTempBin(log_temp);
+      const Real log_temp_i = log_temps_(i_temp);
+      const Real log_temp_ip1 = log_temps_(i_temp + 1);
 
-      const Real log_lambda_i = log_lambdas_(i_temp);
-      const Real log_lambda_ip1 = log_lambdas_(i_temp + 1);
+      const Real log_lambda_i = GetLogLambda(stencil, i_temp);
+      const Real log_lambda_ip1 = GetLogLambda(stencil, i_temp + 1);
 
       // Linearly interpolate lambda at log_temp
       log_lambda = log_lambda_i + (log_temp - log_temp_i) *
-                                      (log_lambda_ip1 - log_lambda_i) / d_log_temp_;
+                                      (log_lambda_ip1 - log_lambda_i) /
+                                      (log_temp_ip1 - log_temp_i);
     }
     // Return de/dt
     const Real lambda = pow(10., log_lambda);
@@ -172,24 +353,104 @@ class CoolingTableObj {
     return de_dt;
   }
 
+  KOKKOS_INLINE_FUNCTION parthenon::Real DeDt(const parthenon::Real &e,
+                                              const parthenon::Real &rho,
+                                              bool &is_valid) const {
+    return DeDt(e, rho, log_z_default_, is_valid);
+  }
+
+  KOKKOS_INLINE_FUNCTION parthenon::Real DeDt(const parthenon::Real &e,
+                                              const parthenon::Real &rho,
+                                              const parthenon::Real &log_z) const {
+    bool is_valid = true;
+    return DeDt(e, rho, log_z, is_valid);
+  }
+
   KOKKOS_INLINE_FUNCTION parthenon::Real DeDt(const parthenon::Real &e,
                                               const parthenon::Real &rho) const {
     bool is_valid = true;
-    return DeDt(e, rho, is_valid);
+    return DeDt(e, rho, log_z_default_, is_valid);
+  }
+
+  // Exact integration (following Townsend 2009) of the isochoric cooling from temp over
+  // dt by successively integrating the (interpolated) piecewise power law cooling
+  // function bin by bin. Used for tables also depending on density or metallicity for
+  // which the temporal evolution functions cannot be precalculated.
+  // Above the table free-free cooling (lambda ~ T^0.5) is used, consistent with DeDt.
+  // Returns the new temperature (at the lowest the lower end of the table).
+  KOKKOS_INLINE_FUNCTION parthenon::Real
+  IntegrateTemp(const parthenon::Real temp_initial, const parthenon::Real rho,
+                const parthenon::Real log_z, const parthenon::Real dt) const {
+    using namespace parthenon;
+    const auto stencil = GetColumnStencil(rho, log_z);
+    // dT/dt = -c_cool * lambda(T)
+    const Real c_cool = mbar_gm1_over_k_B_ * x_H_over_m_h2_ * rho;
+
+    Real temp = temp_initial;
+    Real dt_left = dt;
+    if (log10(temp) > log_temp_final_) {
+      // Free-free cooling (1 - alpha = 0.5) down to the upper end of the table
+      const Real temp_final = pow(10., log_temp_final_);
+      const Real rate_final =
+          c_cool * pow(10., GetLogLambda(stencil, n_temp_ - 1)) / temp_final;
+      const Real sqrt_temp_ratio = sqrt(temp / temp_final);
+      const Real t_final = (sqrt_temp_ratio - 1.0) / (0.5 * rate_final);
+      if (t_final > dt_left) {
+        return temp_final * SQR(sqrt_temp_ratio - 0.5 * rate_final * dt_left);
+      }
+      dt_left -= t_final;
+      temp = temp_final;
+    }
+    int idx = FindTempBin(log10(temp));
+    Real log_lambda_ip1 = GetLogLambda(stencil, idx + 1);
+    while (true) {
+      const Real log_lambda_i = GetLogLambda(stencil, idx);
+      const Real one_m_alpha = 1.0 - (log_lambda_ip1 - log_lambda_i) /
+                                         (log_temps_(idx + 1) - log_temps_(idx));
+      const Real temp_i = pow(10., log_temps_(idx));
+      // Inverse of the cooling timescale at the lower end of the bin
+      const Real rate_i = c_cool * pow(10., log_lambda_i) / temp_i;
+
+      // Time to cool to the lower end of the bin
+      const Real t_i = fabs(one_m_alpha) < 1e-12
+                           ? log(temp / temp_i) / rate_i
+                           : (pow(temp / temp_i, one_m_alpha) - 1.0) /
+                                 (one_m_alpha * rate_i);
+      if (t_i > dt_left) {
+        if (fabs(one_m_alpha) < 1e-12) {
+          return temp * exp(-rate_i * dt_left);
+        }
+        return temp_i * pow(pow(temp / temp_i, one_m_alpha) -
+                                one_m_alpha * rate_i * dt_left,
+                            1.0 / one_m_alpha);
+      }
+      if (idx == 0) {
+        return temp_i;
+      }
+      dt_left -= t_i;
+      temp = temp_i;
+      log_lambda_ip1 = log_lambda_i;
+      idx -= 1;
+    }
   }
 };
 
 class TabularCooling {
  private:
-  // Defines uniformly spaced log temperature range of the table
+  // Defines the log temperature range of the table
   unsigned int n_temp_;
-  parthenon::Real log_temp_start_, log_temp_final_, d_log_temp_, lambda_final_;
+  parthenon::Real log_temp_start_, log_temp_final_, lambda_final_;
+
+  // Index of the passive scalar (within cons/prim, i.e., including the offset nhydro)
+  // containing the metallicity (or -1 to use the constant log_metallicity_ instead)
+  int metallicity_idx_;
+  parthenon::Real log_metallicity_;
 
   // Table of log cooling rates
   // TODO(forrestglines): Make log_lambdas_ explicitly a texture cache array, use CUDA to
   // interpolate directly
   // Log versions are used in subcyling cooling where cooling rates are interpolated
-  // Non-log versions are used for Townsend cooling
+  // Non-log versions are used for Townsend cooling (of temperature only tables)
   parthenon::ParArray1D<parthenon::Real> log_lambdas_;
   parthenon::ParArray1D<parthenon::Real> lambdas_;
   parthenon::ParArray1D<parthenon::Real> temps_;
@@ -212,12 +473,20 @@ class TabularCooling {
   // Cooling CFL
   parthenon::Real cooling_time_cfl_;
 
+  // Whether to count the subcycles of the subcycling integrators (for history output)
+  bool track_subcycles_;
+  // Cost of a single subcycle of a cell relative to the remaining update of a cell used
+  // to set the cost of each block for load balancing (disabled if <= 0) every
+  // subcycle_cost_interval_ cycles
+  parthenon::Real subcycle_cost_;
+  int subcycle_cost_interval_;
+
   // Minimum timestep that the cooling may limit the simulation timestep
   // Use nonpositive values to disable
   parthenon::Real min_cooling_timestep_;
 
   // Tolerances
-  parthenon::Real d_log_temp_tol_, d_e_tol_;
+  parthenon::Real d_e_tol_;
 
   // Used for roundoff as subcycle approaches end of timestep
   static constexpr parthenon::Real KEpsilon_ = 1e-12;
@@ -228,7 +497,8 @@ class TabularCooling {
   TabularCooling(parthenon::ParameterInput *pin,
                  std::shared_ptr<parthenon::StateDescriptor> hydro_pkg);
 
-  void SrcTerm(parthenon::MeshData<parthenon::Real> *md, const parthenon::Real dt) const;
+  void SrcTerm(parthenon::MeshData<parthenon::Real> *md, const parthenon::Real dt,
+               const parthenon::SimTime &tm) const;
 
   // Townsend 2009 exact integration scheme
   void TownsendSrcTerm(parthenon::MeshData<parthenon::Real> *md,
@@ -237,7 +507,7 @@ class TabularCooling {
   // (Adaptive) subcyling using a fixed integration scheme
   template <typename RKStepper>
   void SubcyclingFixedIntSrcTerm(parthenon::MeshData<parthenon::Real> *md,
-                                 const parthenon::Real dt,
+                                 const parthenon::Real dt, const parthenon::SimTime &tm,
                                  const RKStepper rk_stepper) const;
 
   parthenon::Real EstimateTimeStep(parthenon::MeshData<parthenon::Real> *md) const;
@@ -245,6 +515,10 @@ class TabularCooling {
   // Get a lightweight object for computing cooling rate from the cooling table
   const CoolingTableObj GetCoolingTableObj() const { return cooling_table_obj_; }
 
+  // Get the index of the passive scalar (within cons/prim) containing the metallicity
+  // (or -1 if the constant metallicity of the cooling table object is used)
+  int GetMetallicityIdx() const { return metallicity_idx_; }
+
   void TestCoolingTable(parthenon::ParameterInput *pin) const;
 };
 
@@ -0,0 +1,212 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file step_reductions.cpp
+//  \brief Registry of global scalar reductions performed once per cycle
+
+// C++ headers
+#include <algorithm> // copy, min, max
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+#include <utils/error_checking.hpp>
+
+// AthenaPK headers
+#include "step_reductions.hpp"
+
+namespace Hydro {
+
+#ifdef MPI_PARALLEL
+namespace {
+// Reduction operations of the in-flight reduction (there's at most one at a time). These
+// are identical on all ranks given that quantities are registered (in the same order)
+// during initialization.
+std::vector<ReductionOp> mpi_reduction_ops;
+
+// Element-wise reduction of the whole buffer. The buffer is sent as a single element of
+// a contiguous datatype so that MPI never splits it (which would break the mapping of
+// buffer entries to reduction operations).
+void StepReductionsMPIOp(void *in, void *inout, int *len, MPI_Datatype * /*datatype*/) {
+  const auto *in_vals = static_cast<const Real *>(in);
+  auto *inout_vals = static_cast<Real *>(inout);
+  const int n = static_cast<int>(mpi_reduction_ops.size());
+  for (int l = 0; l < *len; l++) {
+    for (int q = 0; q < n; q++) {
+      const int idx = l * n + q;
+      switch (mpi_reduction_ops[q]) {
+      case ReductionOp::minloc: {
+        // Lexicographic comparison of the whole group (so that the operation is
+        // commutative) and copy of the group from the smaller one
+        int group_size = 1;
+        while (q + group_size < n &&
+               mpi_reduction_ops[q + group_size] == ReductionOp::loc) {
+          group_size++;
+        }
+        for (int g = 0; g < group_size; g++) {
+          if (in_vals[idx + g] != inout_vals[idx + g]) {
+            if (in_vals[idx + g] < inout_vals[idx + g]) {
+              std::copy(in_vals + idx, in_vals + idx + group_size, inout_vals + idx);
+            }
+            break;
+          }
+        }
+        q += group_size - 1;
+        break;
+      }
+      case ReductionOp::loc:
+        // Handled as part of the preceding `minloc` entry
+        break;
+      case ReductionOp::sum:
+        inout_vals[idx] += in_vals[idx];
+        break;
+      case ReductionOp::min:
+        inout_vals[idx] = std::min(inout_vals[idx], in_vals[idx]);
+        break;
+      case ReductionOp::max:
+        inout_vals[idx] = std::max(inout_vals[idx], in_vals[idx]);
+        break;
+      }
+    }
+  }
+}
+} // namespace
+#endif
+
+void StepReductions::RequireNotRegistered(const std::string &param_name) const {
+  for (const auto &name : param_names_) {
+    PARTHENON_REQUIRE_THROWS(name != param_name,
+                             "Quantity '" + param_name +
+                                 "' already registered for step reductions.");
+  }
+}
+
+void StepReductions::AddQuantity(const std::string &param_name, const ReductionOp op) {
+  RequireNotRegistered(param_name);
+  PARTHENON_REQUIRE_THROWS(op != ReductionOp::minloc && op != ReductionOp::loc,
+                           "Use AddMinLocQuantities to register quantity '" + param_name +
+                               "' for a minloc reduction.");
+  param_names_.push_back(param_name);
+  ops_.push_back(op);
+}
+
+void StepReductions::AddMinLocQuantities(const std::vector<std::string> &param_names) {
+  PARTHENON_REQUIRE_THROWS(!param_names.empty(),
+                           "No quantities given for the minloc step reduction.");
+  for (int q = 0; q < param_names.size(); q++) {
+    RequireNotRegistered(param_names[q]);
+    param_names_.push_back(param_names[q]);
+    ops_.push_back(q == 0 ? ReductionOp::minloc : ReductionOp::loc);
+  }
+}
+
+void StepReductions::SetupMPI() {
+#ifdef MPI_PARALLEL
+  if (mpi_setup_ || IsEmpty()) {
+    return;
+  }
+  const int n = static_cast<int>(param_names_.size());
+  PARTHENON_MPI_CHECK(MPI_Type_contiguous(n, MPI_PARTHENON_REAL, &datatype_));
+  PARTHENON_MPI_CHECK(MPI_Type_commit(&datatype_));
+  PARTHENON_MPI_CHECK(MPI_Op_create(StepReductionsMPIOp, 1, &mpi_op_));
+  buffer_.resize(n);
+  mpi_setup_ = true;
+#endif
+}
+
+void StepReductions::FreeMPI() {
+#ifdef MPI_PARALLEL
+  if (!mpi_setup_) {
+    return;
+  }
+  PARTHENON_MPI_CHECK(MPI_Op_free(&mpi_op_));
+  PARTHENON_MPI_CHECK(MPI_Type_free(&datatype_));
+  mpi_setup_ = false;
+#endif
+}
+
+TaskStatus StepReductionsReset(StateDescriptor *hydro_pkg, const SimTime &tm,
+                               const std::string &registry) {
+  const auto &step_reductions = hydro_pkg->Param<StepReductions>(registry);
+  for (const auto &fun : step_reductions.reset_funs_) {
+    fun(hydro_pkg, tm);
+  }
+  return TaskStatus::complete;
+}
+
+TaskStatus StepReductionsLocal(MeshData<Real> *md, const SimTime &tm,
+                               const std::string &registry) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto &step_reductions = hydro_pkg->Param<StepReductions>(registry);
+  // Given that the partitions are processed sequentially and that reductions to host vars
+  // are blocking it's save to accumulate the quantities in the Params.
+  for (const auto &fun : step_reductions.local_funs_) {
+    fun(md, tm);
+  }
+  return TaskStatus::complete;
+}
+
+TaskStatus StepReductionsStartMPI(StateDescriptor *hydro_pkg,
+                                  const std::string &registry) {
+#ifdef MPI_PARALLEL
+  auto *step_reductions = hydro_pkg->MutableParam<StepReductions>(registry);
+  PARTHENON_REQUIRE(step_reductions->mpi_setup_,
+                    "MPI datatype of the step reductions '" + registry +
+                        "' has not been set up.");
+  const int n = static_cast<int>(step_reductions->param_names_.size());
+
+  for (int q = 0; q < n; q++) {
+    step_reductions->buffer_[q] =
+        hydro_pkg->Param<Real>(step_reductions->param_names_[q]);
+  }
+  mpi_reduction_ops = step_reductions->ops_;
+
+  PARTHENON_MPI_CHECK(MPI_Iallreduce(MPI_IN_PLACE, step_reductions->buffer_.data(), 1,
+                                     step_reductions->datatype_, step_reductions->mpi_op_,
+                                     MPI_COMM_WORLD, &step_reductions->request_));
+#endif
+  return TaskStatus::complete;
+}
+
+TaskStatus StepReductionsFinishMPI(StateDescriptor *hydro_pkg,
+                                   const std::string &registry) {
+#ifdef MPI_PARALLEL
+  auto *step_reductions = hydro_pkg->MutableParam<StepReductions>(registry);
+
+  int done = 0;
+  PARTHENON_MPI_CHECK(MPI_Test(&step_reductions->request_, &done, MPI_STATUS_IGNORE));
+  if (!done) {
+    return TaskStatus::incomplete;
+  }
+
+  const int n = static_cast<int>(step_reductions->param_names_.size());
+  for (int q = 0; q < n; q++) {
+    hydro_pkg->UpdateParam(step_reductions->param_names_[q], step_reductions->buffer_[q]);
+  }
+#endif
+  return TaskStatus::complete;
+}
+
+TaskStatus StepReductionsFinalizePartition(MeshData<Real> *md, const SimTime &tm,
+                                           const std::string &registry) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto &step_reductions = hydro_pkg->Param<StepReductions>(registry);
+  for (const auto &fun : step_reductions.partition_finalize_funs_) {
+    fun(md, tm);
+  }
+  return TaskStatus::complete;
+}
+
+TaskStatus StepReductionsFinalize(StateDescriptor *hydro_pkg, const SimTime &tm,
+                                  const std::string &registry) {
+  const auto &step_reductions = hydro_pkg->Param<StepReductions>(registry);
+  for (const auto &fun : step_reductions.finalize_funs_) {
+    fun(hydro_pkg, tm);
+  }
+  return TaskStatus::complete;
+}
+
+} // namespace Hydro
@@ -0,0 +1,137 @@
+#ifndef HYDRO_STEP_REDUCTIONS_HPP_
+#define HYDRO_STEP_REDUCTIONS_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file step_reductions.hpp
+//  \brief Registry of global scalar reductions performed once per cycle
+
+// C++ headers
+#include <functional>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+namespace Hydro {
+using parthenon::MeshData;
+using parthenon::Real;
+using parthenon::SimTime;
+using parthenon::StateDescriptor;
+using parthenon::TaskStatus;
+
+// `minloc` and `loc` are only used internally for quantities registered via
+// `AddMinLocQuantities`
+enum class ReductionOp { sum, min, max, minloc, loc };
+
+// Modules (e.g., AGN triggering or the magnetic tower) register scalar quantities (stored
+// as `Real` params of the "Hydro" package) that need to be reduced over all ranks once
+// per cycle, together with the functions to reset and to locally reduce them (per mesh
+// partition) and the functions using the reduced quantities.
+// All quantities are then reduced over all ranks in a single non-blocking
+// MPI_Iallreduce instead of separate (blocking) MPI_Allreduce calls per module.
+// Two registries are stored as mutable params of the "Hydro" package and populated
+// during package initialization:
+// - "step_reductions" are processed at the beginning of each cycle, and
+// - "split_source_reductions" are processed after the final stage (following the first
+//   order operator split source terms) and before the ghost zone exchange so that first
+//   order split source terms that depend on global quantities (e.g., the normalization
+//   of the turbulence driving) can be applied in the partition finalize functions.
+class StepReductions {
+ public:
+  using PkgFun_t =
+      std::function<TaskStatus(StateDescriptor *hydro_pkg, const SimTime &tm)>;
+  using PartitionFun_t = std::function<TaskStatus(MeshData<Real> *md, const SimTime &tm)>;
+
+  // Register the `Real` param `param_name` of the "Hydro" package to be reduced with `op`
+  // over all ranks
+  void AddQuantity(const std::string &param_name, const ReductionOp op);
+  // Register the `Real` params `param_names` of the "Hydro" package so that the first one
+  // is reduced with `min` over all ranks and the remaining ones (e.g., the location or
+  // other data associated with the minimum) are taken from the rank holding the minimum.
+  // Ties are broken by comparing the remaining params in order.
+  void AddMinLocQuantities(const std::vector<std::string> &param_names);
+  // Register a function resetting the quantities before the local reductions
+  void AddReset(const PkgFun_t &fun) { reset_funs_.push_back(fun); }
+  // Register a function (locally) reducing quantities over a single partition
+  void AddLocalReduction(const PartitionFun_t &fun) { local_funs_.push_back(fun); }
+  // Register a function called for each partition after the global reduction
+  void AddPartitionFinalize(const PartitionFun_t &fun) {
+    partition_finalize_funs_.push_back(fun);
+  }
+  // Register a function called once after the global reduction
+  void AddFinalize(const PkgFun_t &fun) { finalize_funs_.push_back(fun); }
+
+  bool IsEmpty() const { return param_names_.empty(); }
+
+  // Create (and free) the MPI datatype and reduction operation. To be called once after
+  // all quantities have been registered (and before the simulation is finalized).
+  void SetupMPI();
+  void FreeMPI();
+
+  friend TaskStatus StepReductionsReset(StateDescriptor *hydro_pkg, const SimTime &tm,
+                                        const std::string &registry);
+  friend TaskStatus StepReductionsLocal(MeshData<Real> *md, const SimTime &tm,
+                                        const std::string &registry);
+  friend TaskStatus StepReductionsStartMPI(StateDescriptor *hydro_pkg,
+                                           const std::string &registry);
+  friend TaskStatus StepReductionsFinishMPI(StateDescriptor *hydro_pkg,
+                                            const std::string &registry);
+  friend TaskStatus StepReductionsFinalizePartition(MeshData<Real> *md,
+                                                    const SimTime &tm,
+                                                    const std::string &registry);
+  friend TaskStatus StepReductionsFinalize(StateDescriptor *hydro_pkg,
+                                           const SimTime &tm,
+                                           const std::string &registry);
+
+ private:
+  void RequireNotRegistered(const std::string &param_name) const;
+
+  std::vector<std::string> param_names_;
+  std::vector<ReductionOp> ops_;
+
+  std::vector<PkgFun_t> reset_funs_;
+  std::vector<PartitionFun_t> local_funs_;
+  std::vector<PartitionFun_t> partition_finalize_funs_;
+  std::vector<PkgFun_t> finalize_funs_;
+
+  // Send/receive buffer of the in-flight global reduction
+  std::vector<Real> buffer_;
+#ifdef MPI_PARALLEL
+  bool mpi_setup_ = false;
+  MPI_Request request_;
+  MPI_Datatype datatype_;
+  MPI_Op mpi_op_;
+#endif
+};
+
+// Tasks to be called (in this order) for the registry stored in the param `registry` of
+// the "Hydro" package. The tasks up to StepReductionsStartMPI and the ones starting with
+// StepReductionsFinishMPI are each added to a single task list (in separate regions) so
+// that independent work can be placed in between while the reduction is in flight.
+TaskStatus StepReductionsReset(StateDescriptor *hydro_pkg, const SimTime &tm,
+                               const std::string &registry);
+// Called once per partition (sequentially)
+TaskStatus StepReductionsLocal(MeshData<Real> *md, const SimTime &tm,
+                               const std::string &registry);
+TaskStatus StepReductionsStartMPI(StateDescriptor *hydro_pkg,
+                                  const std::string &registry);
+// Returns `incomplete` while the reduction is in flight
+TaskStatus StepReductionsFinishMPI(StateDescriptor *hydro_pkg,
+                                   const std::string &registry);
+// Called once per partition (sequentially)
+TaskStatus StepReductionsFinalizePartition(MeshData<Real> *md, const SimTime &tm,
+                                           const std::string &registry);
+TaskStatus StepReductionsFinalize(StateDescriptor *hydro_pkg, const SimTime &tm,
+                                  const std::string &registry);
+
+} // namespace Hydro
+
+#endif // HYDRO_STEP_REDUCTIONS_HPP_
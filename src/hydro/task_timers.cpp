@@ -0,0 +1,162 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file task_timers.cpp
+//  \brief Wallclock timers around the task functions of the HydroDriver
+
+// C++ headers
+#include <algorithm> // fill
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <globals.hpp>
+#include <mesh/mesh.hpp>
+#include <parthenon/package.hpp>
+#include <utils/error_checking.hpp>
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+// AthenaPK headers
+#include "task_timers.hpp"
+
+namespace Hydro {
+
+TaskTimers::TaskTimers(ParameterInput *pin) {
+  enabled_ = pin->GetOrAddBoolean("hydro", "task_timers", false);
+  if (!enabled_) {
+    return;
+  }
+  fence_ = pin->GetOrAddBoolean("hydro", "task_timers_fence", false);
+
+  // Default to the interval of the (first) history output
+  Real hst_dt = -1.0;
+  for (int n = 0; n < 100 && hst_dt <= 0.0; n++) {
+    const std::string block = "parthenon/output" + std::to_string(n);
+    if (pin->DoesParameterExist(block, "file_type") &&
+        pin->GetString(block, "file_type") == "hst" &&
+        pin->DoesParameterExist(block, "dt")) {
+      hst_dt = pin->GetReal(block, "dt");
+    }
+  }
+  dt_ = pin->GetOrAddReal("hydro", "task_timers_dt", hst_dt);
+  PARTHENON_REQUIRE_THROWS(dt_ > 0.0,
+                           "hydro/task_timers requires a history output (with dt > 0) "
+                           "or hydro/task_timers_dt > 0.");
+
+  filename_ = pin->GetOrAddString("job", "problem_id", "unset") + ".task_timers.csv";
+}
+
+int TaskTimers::GetId(const std::string &label) {
+  const auto it = ids_.find(label);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+  const int id = static_cast<int>(labels_.size());
+  ids_[label] = id;
+  labels_.push_back(label);
+  seconds_.push_back(0.0);
+  calls_.push_back(0.0);
+  return id;
+}
+
+void TaskTimers::Add(const int id, const double seconds) {
+  std::lock_guard<std::mutex> lock(*mutex_);
+  seconds_[id] += seconds;
+  calls_[id] += 1.0;
+}
+
+void TaskTimers::Output(Mesh *pmesh, const SimTime &tm, const bool force) {
+  if (!enabled_) {
+    return;
+  }
+  if (!initialized_) {
+    // Align the outputs with the history outputs
+    next_time_ = (std::floor(tm.time / dt_) + 1.0) * dt_;
+    last_cycle_ = tm.cycle;
+    last_mbcnt_ = pmesh->mbcnt;
+    interval_timer_ = std::make_shared<Kokkos::Timer>();
+    initialized_ = true;
+  }
+  if (!force && tm.time < next_time_) {
+    return;
+  }
+  while (next_time_ <= tm.time) {
+    next_time_ += dt_;
+  }
+
+  const int n = static_cast<int>(labels_.size());
+#ifdef MPI_PARALLEL
+  // The reductions below require identical labels (in the same order) on all ranks.
+  // Compare a (FNV-1a) hash of all labels (separated by '\0') and its complement so
+  // that a single max reduction yields both the maximum and minimum over all ranks.
+  std::uint64_t labels_hash = 14695981039346656037ULL;
+  for (const auto &label : labels_) {
+    for (const char c : label + '\0') {
+      labels_hash = (labels_hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+    }
+  }
+  std::uint64_t hashes[2] = {labels_hash, ~labels_hash};
+  PARTHENON_MPI_CHECK(
+      MPI_Allreduce(MPI_IN_PLACE, hashes, 2, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD));
+  PARTHENON_REQUIRE(hashes[0] == labels_hash && hashes[1] == ~labels_hash,
+                    "Task timers (labels or their order) differ between ranks.");
+#endif
+
+  // Per task times followed by the wallclock time of the whole interval
+  std::vector<double> local(seconds_);
+  local.push_back(interval_timer_->seconds());
+  std::vector<double> calls(calls_);
+  calls.push_back(static_cast<double>(tm.cycle - last_cycle_));
+
+  std::vector<double> min_s(local), max_s(local), sum_s(local), sum_calls(calls);
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(MPI_Reduce(local.data(), min_s.data(), n + 1, MPI_DOUBLE, MPI_MIN,
+                                 0, MPI_COMM_WORLD));
+  PARTHENON_MPI_CHECK(MPI_Reduce(local.data(), max_s.data(), n + 1, MPI_DOUBLE, MPI_MAX,
+                                 0, MPI_COMM_WORLD));
+  PARTHENON_MPI_CHECK(MPI_Reduce(local.data(), sum_s.data(), n + 1, MPI_DOUBLE, MPI_SUM,
+                                 0, MPI_COMM_WORLD));
+  PARTHENON_MPI_CHECK(MPI_Reduce(calls.data(), sum_calls.data(), n + 1, MPI_DOUBLE,
+                                 MPI_SUM, 0, MPI_COMM_WORLD));
+#endif
+
+  if (parthenon::Globals::my_rank == 0) {
+    // Total number of cell updates (over all ranks) in this interval
+    const auto zone_cycles = static_cast<double>(pmesh->mbcnt - last_mbcnt_) *
+                             static_cast<double>(pmesh->GetNumberOfMeshBlockCells());
+    const auto nranks = static_cast<double>(parthenon::Globals::nranks);
+
+    const bool write_header = !std::ifstream(filename_).good();
+    std::ofstream csv(filename_, std::ios::app);
+    if (write_header) {
+      csv << "time,cycle,task,calls,min_s,max_s,mean_s,zone_cycles_per_s\n";
+    }
+    csv << std::scientific << std::setprecision(6);
+    for (int id = 0; id <= n; id++) {
+      // Number of calls (summed over all ranks) or the number of cycles for the total
+      const auto ncalls = static_cast<std::int64_t>(id < n ? sum_calls[id] : calls[n]);
+      // The zone-cycles per second are based on the slowest rank, i.e., they are the
+      // throughput if the whole step was spent in this task.
+      csv << tm.time << "," << tm.cycle << "," << (id < n ? labels_[id] : "total") << ","
+          << ncalls << "," << min_s[id] << "," << max_s[id] << "," << sum_s[id] / nranks
+          << "," << (max_s[id] > 0.0 ? zone_cycles / max_s[id] : 0.0) << "\n";
+    }
+  }
+
+  std::fill(seconds_.begin(), seconds_.end(), 0.0);
+  std::fill(calls_.begin(), calls_.end(), 0.0);
+  last_cycle_ = tm.cycle;
+  last_mbcnt_ = pmesh->mbcnt;
+  interval_timer_->reset();
+}
+
+} // namespace Hydro
@@ -0,0 +1,102 @@
+#ifndef HYDRO_TASK_TIMERS_HPP_
+#define HYDRO_TASK_TIMERS_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file task_timers.hpp
+//  \brief Wallclock timers around the task functions of the HydroDriver
+
+// C++ headers
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+namespace Hydro {
+using parthenon::Mesh;
+using parthenon::ParameterInput;
+using parthenon::Real;
+using parthenon::SimTime;
+using parthenon::TaskStatus;
+
+// Accumulates the wallclock time spent in each (labeled) task function on each rank.
+// Task functions are wrapped in `Timed()` when the tasks are added in the driver.
+// Every `dt` (by default the interval of the history output) the accumulated times are
+// reduced (min/max/mean) over all ranks and appended to `<problem_id>.task_timers.csv`
+// together with the zone-cycles per second over the interval.
+// The registry is stored as mutable param "task_timers" of the "Hydro" package and
+// always present so that the driver can unconditionally wrap the task functions (which
+// only adds a branch if the timers are disabled).
+class TaskTimers {
+ public:
+  TaskTimers() = default;
+  // Reads the `hydro/task_timers*` parameters
+  explicit TaskTimers(ParameterInput *pin);
+
+  bool IsEnabled() const { return enabled_; }
+
+  // Returns `func` wrapped in a timer accumulating to the timer `label`.
+  // Calls returning `TaskStatus::incomplete` (e.g., while waiting for communication) are
+  // included.
+  template <typename F>
+  auto Timed(const std::string &label, F func) {
+    const int id = enabled_ ? GetId(label) : -1;
+    return [this, id, func](auto &&...args) mutable -> TaskStatus {
+      if (id < 0) {
+        return func(std::forward<decltype(args)>(args)...);
+      }
+      Kokkos::Timer timer;
+      const TaskStatus status = func(std::forward<decltype(args)>(args)...);
+      if (fence_) {
+        Kokkos::fence();
+      }
+      Add(id, timer.seconds());
+      return status;
+    };
+  }
+
+  // Reduces the timers over all ranks and writes them if the output is due (or if
+  // `force` is set). To be called in between cycles on all ranks.
+  void Output(Mesh *pmesh, const SimTime &tm, const bool force);
+
+ private:
+  int GetId(const std::string &label);
+  void Add(const int id, const double seconds);
+
+  bool enabled_ = false;
+  // Fence after each task so that asynchronously executed kernels are included
+  bool fence_ = false;
+  Real dt_ = -1.0;
+  std::string filename_;
+
+  // Labels in the order of registration, which is identical on all ranks as all ranks
+  // construct the same task collections.
+  std::vector<std::string> labels_;
+  std::map<std::string, int> ids_;
+  // Accumulated time (in s) and number of calls since the last output on this rank
+  std::vector<double> seconds_;
+  std::vector<double> calls_;
+
+  // Task lists may be executed by multiple threads
+  std::shared_ptr<std::mutex> mutex_ = std::make_shared<std::mutex>();
+
+  // State of the last output
+  bool initialized_ = false;
+  Real next_time_;
+  int last_cycle_;
+  std::uint64_t last_mbcnt_;
+  // (Kokkos::Timer is not copyable)
+  std::shared_ptr<Kokkos::Timer> interval_timer_;
+};
+
+} // namespace Hydro
+
+#endif // HYDRO_TASK_TIMERS_HPP_
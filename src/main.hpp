@@ -34,6 +34,7 @@ enum class RiemannSolver { undefined, none, hlle, llf, hllc, hlld };
 enum class Reconstruction { undefined, dc, plm, ppm, wenoz, weno3, limo3 };
 enum class Integrator { undefined, rk1, rk2, vl2, rk3 };
 enum class Fluid { undefined, euler, glmmhd };
+enum class FluxKernel { undefined, pencil, fused };
 enum class Cooling { none, tabular };
 enum class Conduction { none, isotropic, anisotropic };
 enum class ConductionCoeff { none, fixed, spitzer };
@@ -41,7 +42,11 @@ enum class Viscosity { none, isotropic };
 enum class ViscosityCoeff { none, fixed };
 enum class Resistivity { none, ohmic };
 enum class ResistivityCoeff { none, fixed, spitzer };
-enum class DiffInt { none, unsplit, rkl2 };
+enum class DiffInt { none, unsplit, rkl1, rkl2, rkg2 };
+// Whether diffusion is integrated operator split using super-time-stepping (STS)
+constexpr bool IsSTS(const DiffInt diffint) {
+  return diffint == DiffInt::rkl1 || diffint == DiffInt::rkl2 || diffint == DiffInt::rkg2;
+}
 
 enum class Hst { idx, ekin, emag, divb };
 
@@ -38,6 +38,7 @@
 #include "../eos/adiabatic_glmmhd.hpp"
 #include "../eos/adiabatic_hydro.hpp"
 #include "../hydro/hydro.hpp"
+#include "../hydro/step_reductions.hpp"
 #include "../hydro/srcterms/gravitational_field.hpp"
 #include "../hydro/srcterms/tabular_cooling.hpp"
 #include "../main.hpp"
@@ -46,6 +47,7 @@
 // Cluster headers
 #include "cluster/agn_feedback.hpp"
 #include "cluster/agn_triggering.hpp"
+#include "cluster/cluster_block_culling.hpp"
 #include "cluster/cluster_clips.hpp"
 #include "cluster/cluster_gravity.hpp"
 #include "cluster/cluster_reductions.hpp"
@@ -60,36 +62,234 @@ using namespace parthenon::driver::prelude;
 using namespace parthenon::package::prelude;
 using utils::few_modes_ft::FewModesFT;
 
+// Apply all enabled unsplit source terms (gravity, AGN feedback, magnetic tower, and
+// SNIA feedback) in a single kernel. The source terms are applied in sequence to each
+// cell so that the result matches applying them one after another over all cells.
+template <typename EOS>
 void ClusterUnsplitSrcTerm(MeshData<Real> *md, const parthenon::SimTime &tm,
-                           const Real beta_dt) {
+                           const Real beta_dt, const EOS &eos) {
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
 
-  const bool &gravity_srcterm = hydro_pkg->Param<bool>("gravity_srcterm");
+  // Collect the enabled source terms and the region they affect
+  CullingRegion region;
 
+  const bool gravity_srcterm = hydro_pkg->Param<bool>("gravity_srcterm");
+  const ClusterGravity cluster_gravity =
+      hydro_pkg->Param<ClusterGravity>("cluster_gravity");
   if (gravity_srcterm) {
-    const ClusterGravity &cluster_gravity =
-        hydro_pkg->Param<ClusterGravity>("cluster_gravity");
-
-    GravitationalFieldSrcTerm(md, beta_dt, cluster_gravity);
+    region.Add(CullingRegion::Everywhere());
   }
 
   const auto &agn_feedback = hydro_pkg->Param<AGNFeedback>("agn_feedback");
-  agn_feedback.FeedbackSrcTerm(md, beta_dt, tm);
+  const bool agn_feedback_active = agn_feedback.IsActive(hydro_pkg.get());
+  const AGNFeedbackObj agn_feedback_obj =
+      agn_feedback.GetFeedbackObj(hydro_pkg.get(), beta_dt, tm);
+  if (agn_feedback_active) {
+    PARTHENON_REQUIRE(agn_feedback.magnetic_fraction_ != 0 ||
+                          agn_feedback.thermal_fraction_ != 0 ||
+                          agn_feedback.kinetic_fraction_ != 0,
+                      "AGNFeedback Magnetic, Thermal, and Kinetic fractions are all "
+                      "zero");
+    region.Add(agn_feedback.GetCullingRegion(hydro_pkg.get(), beta_dt, tm));
+  }
 
+  // Magnetic tower driven by the AGN feedback power
   const auto &magnetic_tower = hydro_pkg->Param<MagneticTower>("magnetic_tower");
-  magnetic_tower.FixedFieldSrcTerm(md, beta_dt, tm);
+  Real power_field_to_add = 0.0, power_mass_to_add = 0.0;
+  if (agn_feedback_active) {
+    const Real magnetic_power =
+        agn_feedback.GetFeedbackPower(hydro_pkg.get()) * agn_feedback.magnetic_fraction_;
+    if (magnetic_power != 0) {
+      power_field_to_add =
+          magnetic_tower.GetPowerFieldToAdd(magnetic_power, beta_dt, hydro_pkg.get());
+      power_mass_to_add = agn_feedback.GetFeedbackMassRate(hydro_pkg.get()) *
+                          agn_feedback.magnetic_mass_fraction_ * beta_dt;
+    }
+  }
+  const bool power_tower_active = power_field_to_add != 0 || power_mass_to_add != 0;
+  const MagneticTowerObj power_tower = magnetic_tower.GetSrcTermObj(
+      power_field_to_add, power_mass_to_add, hydro_pkg.get(), tm);
+
+  // Magnetic tower with a fixed field rate
+  const Real fixed_field_to_add =
+      magnetic_tower.fixed_field_rate_ != 0 ? magnetic_tower.fixed_field_rate_ * beta_dt
+                                            : 0.0;
+  const Real fixed_mass_to_add =
+      magnetic_tower.fixed_field_rate_ != 0 ? magnetic_tower.fixed_mass_rate_ * beta_dt
+                                            : 0.0;
+  const bool fixed_tower_active = fixed_field_to_add != 0 || fixed_mass_to_add != 0;
+  const MagneticTowerObj fixed_tower = magnetic_tower.GetSrcTermObj(
+      fixed_field_to_add, fixed_mass_to_add, hydro_pkg.get(), tm);
+
+  const JetCoords jet_coords =
+      hydro_pkg->Param<JetCoordsFactory>("jet_coords_factory").CreateJetCoords(tm.time);
+  if (power_tower_active) {
+    region.Add(magnetic_tower.GetCullingRegion(jet_coords, power_mass_to_add > 0.0));
+  }
+  if (fixed_tower_active) {
+    region.Add(magnetic_tower.GetCullingRegion(jet_coords, fixed_mass_to_add > 0.0));
+  }
 
   const auto &snia_feedback = hydro_pkg->Param<SNIAFeedback>("snia_feedback");
-  snia_feedback.FeedbackSrcTerm(md, beta_dt, tm);
-};
+  const bool snia_feedback_active = snia_feedback.IsActive();
+  const SNIAFeedbackObj snia_feedback_obj =
+      snia_feedback.GetFeedbackObj(hydro_pkg.get(), beta_dt);
+  if (snia_feedback_active) {
+    region.Add(CullingRegion::Everywhere());
+  }
+
+  if (!gravity_srcterm && !agn_feedback_active && !power_tower_active &&
+      !fixed_tower_active && !snia_feedback_active) {
+    return;
+  }
+
+  const auto culled = CullBlocks(md, region);
+  const auto &block_idx = culled.idx;
+
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "Cluster::UnsplitSrcTerm", parthenon::DevExecSpace(), 0,
+      culled.n - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i) {
+        const int b = block_idx(n);
+        auto &cons = cons_pack(b);
+        auto &prim = prim_pack(b);
+        const auto &coords = cons_pack.GetCoords(b);
+
+        const Real x = coords.Xc<1>(i);
+        const Real y = coords.Xc<2>(j);
+        const Real z = coords.Xc<3>(k);
+
+        if (gravity_srcterm) {
+          GravitationalFieldSrcTermCell(cluster_gravity, beta_dt, cons, prim, x, y, z, k,
+                                        j, i);
+        }
+        if (agn_feedback_active) {
+          agn_feedback_obj.FeedbackSrcTermCell(eos, cons, prim, x, y, z, k, j, i);
+        }
+        if (power_tower_active) {
+          power_tower.AddSrcTermCell(cons, prim, coords, k, j, i);
+        }
+        if (fixed_tower_active) {
+          fixed_tower.AddSrcTermCell(cons, prim, coords, k, j, i);
+        }
+        if (snia_feedback_active) {
+          snia_feedback_obj.FeedbackSrcTermCell(eos, cons, prim, x, y, z, k, j, i);
+        }
+      });
+}
+
+void ClusterUnsplitSrcTerm(MeshData<Real> *md, const parthenon::SimTime &tm,
+                           const Real beta_dt) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  auto fluid = hydro_pkg->Param<Fluid>("fluid");
+  if (fluid == Fluid::euler) {
+    ClusterUnsplitSrcTerm(md, tm, beta_dt, hydro_pkg->Param<AdiabaticHydroEOS>("eos"));
+  } else if (fluid == Fluid::glmmhd) {
+    ClusterUnsplitSrcTerm(md, tm, beta_dt, hydro_pkg->Param<AdiabaticGLMMHDEOS>("eos"));
+  } else {
+    PARTHENON_FAIL("Cluster::ClusterUnsplitSrcTerm: Unknown EOS");
+  }
+}
+
+// Apply all enabled split source terms (stellar feedback and clips) in a single kernel
+// and reduce the removed mass by stellar feedback and the added mass/removed energy by
+// the clips.
+template <typename EOS>
 void ClusterSplitSrcTerm(MeshData<Real> *md, const parthenon::SimTime &tm,
-                         const Real dt) {
+                         const Real dt, const EOS &eos) {
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
 
   const auto &stellar_feedback = hydro_pkg->Param<StellarFeedback>("stellar_feedback");
-  stellar_feedback.FeedbackSrcTerm(md, dt, tm);
+  const bool stellar_feedback_active = stellar_feedback.IsActive();
+  const bool clips_active = ClusterClipsActive(hydro_pkg.get());
+
+  if (!stellar_feedback_active && !clips_active) {
+    return;
+  }
 
-  ApplyClusterClips(md, tm, dt);
+  const StellarFeedbackObj stellar_feedback_obj =
+      stellar_feedback_active ? stellar_feedback.GetFeedbackObj(hydro_pkg.get())
+                              : StellarFeedbackObj();
+  const ClusterClipsObj clips_obj = GetClusterClipsObj(hydro_pkg.get());
+
+  CullingRegion region;
+  if (stellar_feedback_active) {
+    region.Add(CullingRegion::Sphere(stellar_feedback.GetStellarRadius()));
+  }
+  if (clips_active) {
+    region.Add(CullingRegion::Sphere(hydro_pkg->Param<Real>("cluster_clip_r")));
+  }
+  const auto culled = CullBlocks(md, region);
+  const auto &block_idx = culled.idx;
+
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  Real stellar_mass = 0.0, added_dfloor_mass = 0.0, removed_vceil_energy = 0.0,
+       added_vAceil_mass = 0.0, removed_eceil_energy = 0.0;
+
+  Kokkos::parallel_reduce(
+      "Cluster::SplitSrcTerm",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(DevExecSpace(), {0, kb.s, jb.s, ib.s},
+                                             {culled.n, kb.e + 1, jb.e + 1, ib.e + 1},
+                                             {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i,
+                    Real &stellar_mass_team, Real &added_dfloor_mass_team,
+                    Real &removed_vceil_energy_team, Real &added_vAceil_mass_team,
+                    Real &removed_eceil_energy_team) {
+        const int b = block_idx(n);
+        auto &cons = cons_pack(b);
+        auto &prim = prim_pack(b);
+        const auto &coords = cons_pack.GetCoords(b);
+
+        const Real x = coords.Xc<1>(i);
+        const Real y = coords.Xc<2>(j);
+        const Real z = coords.Xc<3>(k);
+        const Real cell_volume = coords.CellVolume(k, j, i);
+
+        if (stellar_feedback_active) {
+          stellar_mass_team += stellar_feedback_obj.FeedbackSrcTermCell(
+              eos, cons, prim, x, y, z, cell_volume, k, j, i);
+        }
+        if (clips_active) {
+          clips_obj.ClipsCell(eos, cons, prim, x, y, z, cell_volume, k, j, i,
+                              added_dfloor_mass_team, removed_vceil_energy_team,
+                              added_vAceil_mass_team, removed_eceil_energy_team);
+        }
+      },
+      stellar_mass, added_dfloor_mass, removed_vceil_energy, added_vAceil_mass,
+      removed_eceil_energy);
+
+  if (stellar_feedback_active) {
+    hydro_pkg->UpdateParam("stellar_mass",
+                           stellar_mass + hydro_pkg->Param<Real>("stellar_mass"));
+  }
+  if (clips_active) {
+    AddClusterClipsReductions(hydro_pkg.get(), added_dfloor_mass, removed_vceil_energy,
+                              added_vAceil_mass, removed_eceil_energy);
+  }
+}
+
+void ClusterSplitSrcTerm(MeshData<Real> *md, const parthenon::SimTime &tm,
+                         const Real dt) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  auto fluid = hydro_pkg->Param<Fluid>("fluid");
+  if (fluid == Fluid::euler) {
+    ClusterSplitSrcTerm(md, tm, dt, hydro_pkg->Param<AdiabaticHydroEOS>("eos"));
+  } else if (fluid == Fluid::glmmhd) {
+    ClusterSplitSrcTerm(md, tm, dt, hydro_pkg->Param<AdiabaticGLMMHDEOS>("eos"));
+  } else {
+    PARTHENON_FAIL("Cluster::ClusterSplitSrcTerm: Unknown EOS");
+  }
 }
 
 Real ClusterEstimateTimestep(MeshData<Real> *md) {
@@ -198,6 +398,18 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *hyd
   HydrostaticEquilibriumSphere hse_sphere(pin, hydro_pkg, cluster_gravity,
                                           entropy_profile);
 
+  /************************************************************
+   * Read Block Culling
+   ************************************************************/
+
+  // Restrict source terms localized around the SMBH (AGN feedback and triggering,
+  // magnetic tower, stellar feedback, and clips) to blocks intersecting their regions
+  const bool block_culling =
+      pin->GetOrAddBoolean("problem/cluster", "block_culling", true);
+  hydro_pkg->AddParam<>("block_culling", block_culling);
+  // Device buffers of the culled block indices, see `CullBlocks`
+  hydro_pkg->AddParam<>("culled_block_idx", CulledBlockIdxBuffers(), true);
+
   /************************************************************
    * Read Precessing Jet Coordinate system
    ************************************************************/
@@ -229,6 +441,20 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *hyd
        (agn_feedback.fixed_power_ != 0 ||
         agn_triggering.triggering_mode_ != AGNTriggeringMode::NONE));
   hydro_pkg->AddParam("magnetic_tower_power_scaling", magnetic_tower_power_scaling);
+  if (magnetic_tower_power_scaling) {
+    // The contributions are reduced over all ranks at the beginning of each cycle
+    auto step_reductions =
+        hydro_pkg->MutableParam<Hydro::StepReductions>("step_reductions");
+    step_reductions->AddQuantity("magnetic_tower_linear_contrib",
+                                 Hydro::ReductionOp::sum);
+    step_reductions->AddQuantity("magnetic_tower_quadratic_contrib",
+                                 Hydro::ReductionOp::sum);
+    step_reductions->AddReset(
+        [](parthenon::StateDescriptor *hydro_pkg, const parthenon::SimTime &) {
+          return MagneticTowerResetPowerContribs(hydro_pkg);
+        });
+    step_reductions->AddLocalReduction(MagneticTowerReducePowerContribs);
+  }
 
   /************************************************************
    * Read SNIA Feedback
@@ -882,6 +1108,7 @@ void UserWorkBeforeOutput(MeshBlock *pmb, ParameterInput *pin,
     const cooling::TabularCooling &tabular_cooling =
         pkg->Param<cooling::TabularCooling>("tabular_cooling");
     const auto cooling_table_obj = tabular_cooling.GetCoolingTableObj();
+    const auto metallicity_idx = tabular_cooling.GetMetallicityIdx();
 
     pmb->par_for(
         "Cluster::UserWorkBeforeOutput::CoolingTime", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
@@ -892,7 +1119,10 @@ void UserWorkBeforeOutput(MeshBlock *pmb, ParameterInput *pin,
 
           // compute cooling time
           const Real eint = P / (rho * gm1);
-          const Real edot = cooling_table_obj.DeDt(eint, rho);
+          const Real edot = metallicity_idx >= 0
+                                ? cooling_table_obj.DeDt(
+                                      eint, rho, log10(prim(metallicity_idx, k, j, i)))
+                                : cooling_table_obj.DeDt(eint, rho);
           cooling_time(k, j, i) = (edot != 0) ? -eint / edot : NAN;
         });
   }
@@ -8,6 +8,7 @@
 //  tower
 
 #include <cmath>
+#include <limits>
 
 // Parthenon headers
 #include <coordinates/uniform_cartesian.hpp>
@@ -24,6 +25,7 @@
 #include "../../units.hpp"
 #include "agn_feedback.hpp"
 #include "agn_triggering.hpp"
+#include "cluster_block_culling.hpp"
 #include "cluster_utils.hpp"
 #include "magnetic_tower.hpp"
 #include "utils/error_checking.hpp"
@@ -211,56 +213,21 @@ parthenon::Real AGNFeedback::GetFeedbackMassRate(StateDescriptor *hydro_pkg) con
   return mass_rate;
 }
 
-void AGNFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
-                                  const parthenon::Real beta_dt,
-                                  const parthenon::SimTime &tm) const {
-  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-  auto fluid = hydro_pkg->Param<Fluid>("fluid");
-  if (fluid == Fluid::euler) {
-    FeedbackSrcTerm(md, beta_dt, tm, hydro_pkg->Param<AdiabaticHydroEOS>("eos"));
-  } else if (fluid == Fluid::glmmhd) {
-    FeedbackSrcTerm(md, beta_dt, tm, hydro_pkg->Param<AdiabaticGLMMHDEOS>("eos"));
-  } else {
-    PARTHENON_FAIL("AGNFeedback::FeedbackSrcTerm: Unknown EOS");
-  }
+bool AGNFeedback::IsActive(StateDescriptor *hydro_pkg) const {
+  return !disabled_ && GetFeedbackPower(hydro_pkg) != 0;
 }
-template <typename EOS>
-void AGNFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
-                                  const parthenon::Real beta_dt,
-                                  const parthenon::SimTime &tm, const EOS &eos) const {
-  using parthenon::IndexDomain;
-  using parthenon::IndexRange;
-  using parthenon::Real;
-
-  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-  auto units = hydro_pkg->Param<Units>("units");
 
-  const Real power = GetFeedbackPower(hydro_pkg.get());
-  const Real mass_rate = GetFeedbackMassRate(hydro_pkg.get());
-
-  if (power == 0 || disabled_) {
-    // No AGN feedback, return
-    return;
-  }
-
-  PARTHENON_REQUIRE(magnetic_fraction_ != 0 || thermal_fraction_ != 0 ||
-                        kinetic_fraction_ != 0,
-                    "AGNFeedback::FeedbackSrcTerm Magnetic, Thermal, and Kinetic "
-                    "fractions are all zero");
+AGNFeedbackObj AGNFeedback::GetFeedbackObj(StateDescriptor *hydro_pkg,
+                                           const parthenon::Real beta_dt,
+                                           const parthenon::SimTime &tm) const {
+  using parthenon::Real;
 
-  // Grab some necessary variables
-  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
-  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
-  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
-  const auto nhydro = hydro_pkg->Param<int>("nhydro");
-  const auto nscalars = hydro_pkg->Param<int>("nscalars");
+  const Real power = GetFeedbackPower(hydro_pkg);
+  const Real mass_rate = GetFeedbackMassRate(hydro_pkg);
 
   ////////////////////////////////////////////////////////////////////////////////
   // Thermal quantities
   ////////////////////////////////////////////////////////////////////////////////
-  const Real thermal_radius2 = thermal_radius_ * thermal_radius_;
   const Real thermal_scaling_factor = 1 / (4. / 3. * M_PI * pow(thermal_radius_, 3));
 
   // Amount of energy/volume to dump in each cell
@@ -276,10 +243,6 @@ void AGNFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
   const Real kinetic_scaling_factor =
       1 / (2 * kinetic_jet_thickness_ * M_PI * pow(kinetic_jet_radius_, 2));
 
-  const Real kinetic_jet_radius = kinetic_jet_radius_;
-  const Real kinetic_jet_thickness = kinetic_jet_thickness_;
-  const Real kinetic_jet_offset = kinetic_jet_offset_;
-
   // Matches 1/2.*jet_density*jet_velocity*jet_velocity*beta_dt;
   // const Real kinetic_feedback =
   //    kinetic_fraction_ * power * kinetic_scaling_factor * beta_dt; // energy/volume
@@ -290,7 +253,6 @@ void AGNFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
 
   // Velocity of added gas
   const Real jet_velocity = kinetic_jet_velocity_;
-  const Real jet_specific_internal_e = kinetic_jet_e_;
 
   // Amount of momentum density ( density * velocity) to dump in each cell
   const Real jet_momentum = jet_density * jet_velocity;
@@ -298,123 +260,52 @@ void AGNFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
   // Amount of total energy to dump in each cell
   const Real jet_feedback = kinetic_fraction_ * power * kinetic_scaling_factor * beta_dt;
 
-  const Real vceil = vceil_;
-  const Real vceil2 = SQR(vceil);
-  const Real eceil = eceil_;
   const Real gm1 = (hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0);
-  const auto enable_tracer = enable_tracer_;
   ////////////////////////////////////////////////////////////////////////////////
 
-  const parthenon::Real time = tm.time;
-
   const auto &jet_coords_factory =
       hydro_pkg->Param<JetCoordsFactory>("jet_coords_factory");
-  const JetCoords jet_coords = jet_coords_factory.CreateJetCoords(time);
-
-  // Appy kinietic jet and thermal feedback
-  parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "HydroAGNFeedback::FeedbackSrcTerm",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e, KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
-        auto &cons = cons_pack(b);
-        auto &prim = prim_pack(b);
-        const auto &coords = cons_pack.GetCoords(b);
-
-        const Real x = coords.Xc<1>(i);
-        const Real y = coords.Xc<2>(j);
-        const Real z = coords.Xc<3>(k);
-
-        // Thermal Feedback
-        if (thermal_feedback > 0 || thermal_density > 0) {
-          const Real r2 = x * x + y * y + z * z;
-          // Determine if point is in sphere r<=thermal_radius
-          if (r2 <= thermal_radius2) {
-            // Then apply heating
-            if (thermal_feedback > 0) cons(IEN, k, j, i) += thermal_feedback;
-            // Add density at constant velocity
-            if (thermal_density > 0)
-              AddDensityToConsAtFixedVel(thermal_density, cons, prim, k, j, i);
-          }
-        }
-
-        // Kinetic Jet Feedback
-        if (jet_density > 0) {
-          // Get position in jet cylindrical coords
-          Real r, cos_theta, sin_theta, h;
-          jet_coords.SimCartToJetCylCoords(x, y, z, r, cos_theta, sin_theta, h);
-
-          if (r < kinetic_jet_radius && fabs(h) >= kinetic_jet_offset &&
-              fabs(h) <= kinetic_jet_offset + kinetic_jet_thickness) {
-            // Cell falls inside jet deposition volume
-
-            // Get the vector of the jet axis
-            Real jet_axis_x, jet_axis_y, jet_axis_z;
-            jet_coords.JetCylToSimCartVector(cos_theta, sin_theta, 0, 0, 1, jet_axis_x,
-                                             jet_axis_y, jet_axis_z);
-
-            const Real sign_jet = (h > 0) ? 1 : -1; // Above or below jet-disk
-
-            ///////////////////////////////////////////////////////////////////
-            //  We add the kinetic jet with a fixed jet velocity and specific
-            //  internal energy/temperature of the added gas. The density,
-            //  momentum, and total energy added depend on the triggered power.
-            ///////////////////////////////////////////////////////////////////
-
-            eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
-
-            cons(IDN, k, j, i) += jet_density;
-            cons(IM1, k, j, i) += jet_momentum * sign_jet * jet_axis_x;
-            cons(IM2, k, j, i) += jet_momentum * sign_jet * jet_axis_y;
-            cons(IM3, k, j, i) += jet_momentum * sign_jet * jet_axis_z;
-            cons(IEN, k, j, i) += jet_feedback;
-
-            // Reset tracer to one for the entire material in the jet launching region as
-            // we cannot distinguish between original material in a cell and new jet
-            // material in the evolution of the jet. Eventually, we're just interested in
-            // stuff that came from here.
-            if (enable_tracer) {
-              cons(nhydro, k, j, i) = 1.0 * cons(IDN, k, j, i);
-            }
-
-            eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
-          }
-
-          // Apply velocity ceiling
-          const Real v2 =
-              SQR(prim(IV1, k, j, i)) + SQR(prim(IV2, k, j, i)) + SQR(prim(IV3, k, j, i));
-          if (vceil2 > 0 && v2 > vceil2) {
-            // Fix the velocity to the velocity ceiling
-            const Real v = sqrt(v2);
-            cons(IM1, k, j, i) *= vceil / v;
-            cons(IM2, k, j, i) *= vceil / v;
-            cons(IM3, k, j, i) *= vceil / v;
-            prim(IV1, k, j, i) *= vceil / v;
-            prim(IV2, k, j, i) *= vceil / v;
-            prim(IV3, k, j, i) *= vceil / v;
-
-            // Remove kinetic energy
-            cons(IEN, k, j, i) -= 0.5 * prim(IDN, k, j, i) * (v2 - vceil2);
-          }
-
-          // Apply  internal energy ceiling as a pressure ceiling
-          const Real internal_e = prim(IPR, k, j, i) / (gm1 * prim(IDN, k, j, i));
-          if (eceil > 0 && internal_e > eceil) {
-            cons(IEN, k, j, i) -= prim(IDN, k, j, i) * (internal_e - eceil);
-            prim(IPR, k, j, i) = gm1 * prim(IDN, k, j, i) * eceil;
-          }
-        }
-
-        eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
-        PARTHENON_REQUIRE(prim(IPR, k, j, i) > 0,
-                          "Kinetic injection leads to negative pressure");
-      });
-
-  // Apply magnetic tower feedback
-  const auto &magnetic_tower = hydro_pkg->Param<MagneticTower>("magnetic_tower");
-
-  const Real magnetic_power = power * magnetic_fraction_;
-  const Real magnetic_mass_rate = mass_rate * magnetic_mass_fraction_;
-  magnetic_tower.PowerSrcTerm(magnetic_power, magnetic_mass_rate, md, beta_dt, tm);
+  const JetCoords jet_coords = jet_coords_factory.CreateJetCoords(tm.time);
+
+  return AGNFeedbackObj(SQR(thermal_radius_), thermal_feedback, thermal_density,
+                        kinetic_jet_radius_, kinetic_jet_thickness_, kinetic_jet_offset_,
+                        jet_density, jet_momentum, jet_feedback, vceil_, eceil_, gm1,
+                        enable_tracer_, hydro_pkg->Param<int>("nhydro"),
+                        hydro_pkg->Param<int>("nscalars"), jet_coords);
+}
+
+CullingRegion AGNFeedback::GetCullingRegion(StateDescriptor *hydro_pkg,
+                                            const parthenon::Real beta_dt,
+                                            const parthenon::SimTime &tm) const {
+  using parthenon::Real;
+
+  const Real power = GetFeedbackPower(hydro_pkg);
+  const Real mass_rate = GetFeedbackMassRate(hydro_pkg);
+
+  CullingRegion region;
+  // Thermal sphere
+  if (thermal_fraction_ * power * beta_dt > 0 ||
+      thermal_mass_fraction_ * mass_rate * beta_dt > 0) {
+    region.Add(CullingRegion::Sphere(thermal_radius_));
+  }
+  // Jet launching region
+  if (kinetic_mass_fraction_ * mass_rate * beta_dt > 0) {
+    const Real inf = std::numeric_limits<Real>::infinity();
+    if ((vceil_ > 0 && vceil_ < inf) || (eceil_ > 0 && eceil_ < inf)) {
+      // The ceilings are applied to all cells while the jet is active
+      region.Add(CullingRegion::Everywhere());
+    } else {
+      const auto &jet_coords_factory =
+          hydro_pkg->Param<JetCoordsFactory>("jet_coords_factory");
+      const JetCoords jet_coords = jet_coords_factory.CreateJetCoords(tm.time);
+      Real jet_axis_x, jet_axis_y, jet_axis_z;
+      jet_coords.JetCylToSimCartVector(1, 0, 0, 0, 1, jet_axis_x, jet_axis_y, jet_axis_z);
+      region.Add(CullingRegion::Cylinder(kinetic_jet_radius_,
+                                         kinetic_jet_offset_ + kinetic_jet_thickness_,
+                                         jet_axis_x, jet_axis_y, jet_axis_z));
+    }
+  }
+  return region;
 }
 
 } // namespace cluster
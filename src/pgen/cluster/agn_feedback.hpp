@@ -16,10 +16,149 @@
 #include <parameter_input.hpp>
 #include <parthenon/package.hpp>
 
+#include "cluster_block_culling.hpp"
+#include "cluster_utils.hpp"
 #include "jet_coords.hpp"
 
 namespace cluster {
 
+/************************************************************
+ *  AGN Feedback Object, for applying thermal and kinetic AGN feedback with a
+ *  fixed power and mass rate over a fixed timestep to single cells
+ *    Lightweight object intended for inlined computation within kernels
+ ************************************************************/
+class AGNFeedbackObj {
+ private:
+  // Energy and density per volume added to each cell by thermal feedback
+  const parthenon::Real thermal_radius2_, thermal_feedback_, thermal_density_;
+
+  // Density, momentum, and energy per volume added to each cell by the kinetic jet
+  const parthenon::Real kinetic_jet_radius_, kinetic_jet_thickness_, kinetic_jet_offset_;
+  const parthenon::Real jet_density_, jet_momentum_, jet_feedback_;
+
+  // Velocity and internal energy ceilings
+  const parthenon::Real vceil_, eceil_, gm1_;
+
+  const bool enable_tracer_;
+  const int nhydro_, nscalars_;
+
+  const JetCoords jet_coords_;
+
+ public:
+  AGNFeedbackObj(const parthenon::Real thermal_radius2,
+                 const parthenon::Real thermal_feedback,
+                 const parthenon::Real thermal_density,
+                 const parthenon::Real kinetic_jet_radius,
+                 const parthenon::Real kinetic_jet_thickness,
+                 const parthenon::Real kinetic_jet_offset,
+                 const parthenon::Real jet_density, const parthenon::Real jet_momentum,
+                 const parthenon::Real jet_feedback,
+                 const parthenon::Real vceil, const parthenon::Real eceil,
+                 const parthenon::Real gm1, const bool enable_tracer, const int nhydro,
+                 const int nscalars, const JetCoords jet_coords)
+      : thermal_radius2_(thermal_radius2), thermal_feedback_(thermal_feedback),
+        thermal_density_(thermal_density), kinetic_jet_radius_(kinetic_jet_radius),
+        kinetic_jet_thickness_(kinetic_jet_thickness),
+        kinetic_jet_offset_(kinetic_jet_offset), jet_density_(jet_density),
+        jet_momentum_(jet_momentum), jet_feedback_(jet_feedback), vceil_(vceil),
+        eceil_(eceil), gm1_(gm1), enable_tracer_(enable_tracer), nhydro_(nhydro),
+        nscalars_(nscalars), jet_coords_(jet_coords) {}
+
+  // Apply kinetic jet and thermal feedback to the cell at x, y, z
+  template <typename EOS, typename View4D>
+  KOKKOS_INLINE_FUNCTION void
+  FeedbackSrcTermCell(const EOS &eos, View4D &cons, View4D &prim, const parthenon::Real x,
+                      const parthenon::Real y, const parthenon::Real z, const int k,
+                      const int j, const int i) const __attribute__((always_inline)) {
+    using parthenon::Real;
+
+    // Thermal Feedback
+    if (thermal_feedback_ > 0 || thermal_density_ > 0) {
+      const Real r2 = x * x + y * y + z * z;
+      // Determine if point is in sphere r<=thermal_radius
+      if (r2 <= thermal_radius2_) {
+        // Then apply heating
+        if (thermal_feedback_ > 0) cons(IEN, k, j, i) += thermal_feedback_;
+        // Add density at constant velocity
+        if (thermal_density_ > 0)
+          AddDensityToConsAtFixedVel(thermal_density_, cons, prim, k, j, i);
+      }
+    }
+
+    // Kinetic Jet Feedback
+    if (jet_density_ > 0) {
+      // Get position in jet cylindrical coords
+      Real r, cos_theta, sin_theta, h;
+      jet_coords_.SimCartToJetCylCoords(x, y, z, r, cos_theta, sin_theta, h);
+
+      if (r < kinetic_jet_radius_ && fabs(h) >= kinetic_jet_offset_ &&
+          fabs(h) <= kinetic_jet_offset_ + kinetic_jet_thickness_) {
+        // Cell falls inside jet deposition volume
+
+        // Get the vector of the jet axis
+        Real jet_axis_x, jet_axis_y, jet_axis_z;
+        jet_coords_.JetCylToSimCartVector(cos_theta, sin_theta, 0, 0, 1, jet_axis_x,
+                                          jet_axis_y, jet_axis_z);
+
+        const Real sign_jet = (h > 0) ? 1 : -1; // Above or below jet-disk
+
+        ///////////////////////////////////////////////////////////////////
+        //  We add the kinetic jet with a fixed jet velocity and specific
+        //  internal energy/temperature of the added gas. The density,
+        //  momentum, and total energy added depend on the triggered power.
+        ///////////////////////////////////////////////////////////////////
+
+        eos.ConsToPrim(cons, prim, nhydro_, nscalars_, k, j, i);
+
+        cons(IDN, k, j, i) += jet_density_;
+        cons(IM1, k, j, i) += jet_momentum_ * sign_jet * jet_axis_x;
+        cons(IM2, k, j, i) += jet_momentum_ * sign_jet * jet_axis_y;
+        cons(IM3, k, j, i) += jet_momentum_ * sign_jet * jet_axis_z;
+        cons(IEN, k, j, i) += jet_feedback_;
+
+        // Reset tracer to one for the entire material in the jet launching region as
+        // we cannot distinguish between original material in a cell and new jet
+        // material in the evolution of the jet. Eventually, we're just interested in
+        // stuff that came from here.
+        if (enable_tracer_) {
+          cons(nhydro_, k, j, i) = 1.0 * cons(IDN, k, j, i);
+        }
+
+        eos.ConsToPrim(cons, prim, nhydro_, nscalars_, k, j, i);
+      }
+
+      // Apply velocity ceiling
+      const Real vceil2 = SQR(vceil_);
+      const Real v2 =
+          SQR(prim(IV1, k, j, i)) + SQR(prim(IV2, k, j, i)) + SQR(prim(IV3, k, j, i));
+      if (vceil2 > 0 && v2 > vceil2) {
+        // Fix the velocity to the velocity ceiling
+        const Real v = sqrt(v2);
+        cons(IM1, k, j, i) *= vceil_ / v;
+        cons(IM2, k, j, i) *= vceil_ / v;
+        cons(IM3, k, j, i) *= vceil_ / v;
+        prim(IV1, k, j, i) *= vceil_ / v;
+        prim(IV2, k, j, i) *= vceil_ / v;
+        prim(IV3, k, j, i) *= vceil_ / v;
+
+        // Remove kinetic energy
+        cons(IEN, k, j, i) -= 0.5 * prim(IDN, k, j, i) * (v2 - vceil2);
+      }
+
+      // Apply  internal energy ceiling as a pressure ceiling
+      const Real internal_e = prim(IPR, k, j, i) / (gm1_ * prim(IDN, k, j, i));
+      if (eceil_ > 0 && internal_e > eceil_) {
+        cons(IEN, k, j, i) -= prim(IDN, k, j, i) * (internal_e - eceil_);
+        prim(IPR, k, j, i) = gm1_ * prim(IDN, k, j, i) * eceil_;
+      }
+    }
+
+    eos.ConsToPrim(cons, prim, nhydro_, nscalars_, k, j, i);
+    PARTHENON_REQUIRE(prim(IPR, k, j, i) > 0,
+                      "Kinetic injection leads to negative pressure");
+  }
+};
+
 /************************************************************
  *  AGNFeedback
  ************************************************************/
@@ -54,14 +193,19 @@ class AGNFeedback {
   parthenon::Real GetFeedbackPower(parthenon::StateDescriptor *hydro_pkg) const;
   parthenon::Real GetFeedbackMassRate(parthenon::StateDescriptor *hydro_pkg) const;
 
-  void FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
-                       const parthenon::Real beta_dt, const parthenon::SimTime &tm) const;
+  // Whether hydrodynamic or magnetic AGN feedback is currently injected
+  bool IsActive(parthenon::StateDescriptor *hydro_pkg) const;
+
+  // Get the object to apply hydrodynamic AGN feedback (kinetic jets and thermal
+  // feedback) over beta_dt within a kernel
+  AGNFeedbackObj GetFeedbackObj(parthenon::StateDescriptor *hydro_pkg,
+                                const parthenon::Real beta_dt,
+                                const parthenon::SimTime &tm) const;
 
-  // Apply the feedback from hydrodynamic AGN feedback (kinetic jets and thermal feedback)
-  template <typename EOS>
-  void FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
-                       const parthenon::Real beta_dt, const parthenon::SimTime &tm,
-                       const EOS &eos) const;
+  // Get the region affected by hydrodynamic AGN feedback over beta_dt
+  CullingRegion GetCullingRegion(parthenon::StateDescriptor *hydro_pkg,
+                                 const parthenon::Real beta_dt,
+                                 const parthenon::SimTime &tm) const;
 };
 
 } // namespace cluster
@@ -22,10 +22,15 @@
 // Athena headers
 #include "../../eos/adiabatic_glmmhd.hpp"
 #include "../../eos/adiabatic_hydro.hpp"
+#include "../../hydro/step_reductions.hpp"
+#ifdef ATHENAPK_MIXED_PRECISION
+#include "../../hydro/mixed_precision.hpp"
+#endif
 #include "../../main.hpp"
 #include "../../units.hpp"
 #include "agn_feedback.hpp"
 #include "agn_triggering.hpp"
+#include "cluster_block_culling.hpp"
 #include "cluster_utils.hpp"
 
 namespace cluster {
@@ -77,32 +82,40 @@ AGNTriggering::AGNTriggering(parthenon::ParameterInput *pin,
 
   mean_molecular_mass_ = mu * units.atomic_mass_unit();
 
-  if (triggering_mode_ == AGNTriggeringMode::NONE) {
-    hydro_pkg->AddParam<bool>("agn_triggering_reduce_accretion_rate", false);
-  } else {
-    hydro_pkg->AddParam<bool>("agn_triggering_reduce_accretion_rate", true);
-  }
+  // The triggering quantities are reduced over all ranks at the beginning of each cycle
+  auto step_reductions =
+      hydro_pkg->MutableParam<Hydro::StepReductions>("step_reductions");
   switch (triggering_mode_) {
   case AGNTriggeringMode::COLD_GAS: {
     hydro_pkg->AddParam<Real>("agn_triggering_cold_mass", 0, Params::Mutability::Restart);
+    step_reductions->AddQuantity("agn_triggering_cold_mass", Hydro::ReductionOp::sum);
     break;
   }
   case AGNTriggeringMode::BOOSTED_BONDI:
   case AGNTriggeringMode::BOOTH_SCHAYE: {
-    hydro_pkg->AddParam<Real>("agn_triggering_total_mass", 0,
-                              Params::Mutability::Restart);
-    hydro_pkg->AddParam<Real>("agn_triggering_mass_weighted_density", 0,
-                              Params::Mutability::Restart);
-    hydro_pkg->AddParam<Real>("agn_triggering_mass_weighted_velocity", 0,
-                              Params::Mutability::Restart);
-    hydro_pkg->AddParam<Real>("agn_triggering_mass_weighted_cs", 0,
-                              Params::Mutability::Restart);
+    for (const auto &name :
+         {"agn_triggering_total_mass", "agn_triggering_mass_weighted_density",
+          "agn_triggering_mass_weighted_velocity", "agn_triggering_mass_weighted_cs"}) {
+      hydro_pkg->AddParam<Real>(name, 0, Params::Mutability::Restart);
+      step_reductions->AddQuantity(name, Hydro::ReductionOp::sum);
+    }
     break;
   }
   case AGNTriggeringMode::NONE: {
     break;
   }
   }
+  if (triggering_mode_ != AGNTriggeringMode::NONE) {
+    step_reductions->AddReset(
+        [](parthenon::StateDescriptor *hydro_pkg, const parthenon::SimTime &) {
+          return AGNTriggeringResetTriggering(hydro_pkg);
+        });
+    step_reductions->AddLocalReduction(
+        [](parthenon::MeshData<parthenon::Real> *md, const parthenon::SimTime &tm) {
+          return AGNTriggeringReduceTriggering(md, tm.dt);
+        });
+    step_reductions->AddPartitionFinalize(AGNTriggeringFinalizeTriggering);
+  }
 
   // Set up writing the triggering to file, used for debugging and regression
   // testing. Note that this is written every timestep, which is more
@@ -133,6 +146,11 @@ void AGNTriggering::ReduceColdMass(parthenon::Real &cold_mass,
   // Grab some necessary variables
   const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
   const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+#ifdef ATHENAPK_MIXED_PRECISION
+  // The single precision copy of `prim` used in the flux calculation needs to be updated
+  // together with `prim`
+  const auto &prim_sp_pack = md->PackVariables(std::vector<std::string>{"prim_sp"});
+#endif
   IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
@@ -155,12 +173,16 @@ void AGNTriggering::ReduceColdMass(parthenon::Real &cold_mass,
 
   Real md_cold_mass = 0;
 
+  // Only launch over blocks within the accretion radius
+  const auto culled = CullBlocks(md, CullingRegion::Sphere(accretion_radius_));
+  const auto &block_idx = culled.idx;
+
   parthenon::par_reduce(
       parthenon::loop_pattern_mdrange_tag, "AGNTriggering::ReduceColdGas",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e,
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i,
+      parthenon::DevExecSpace(), 0, culled.n - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i,
                     Real &team_cold_mass) {
+        const int b = block_idx(n);
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
@@ -189,6 +211,9 @@ void AGNTriggering::ReduceColdMass(parthenon::Real &cold_mass,
                                              k, j, i);
               // Update the Primitives
               eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+#ifdef ATHENAPK_MIXED_PRECISION
+              Hydro::StorePrimSP(prim, prim_sp_pack(b), nhydro + nscalars, k, j, i);
+#endif
             }
           }
         }
@@ -225,15 +250,19 @@ void AGNTriggering::ReduceBondiTriggeringQuantities(
 
   const parthenon::Real gamma = gamma_;
 
+  // Only launch over blocks within the accretion radius
+  const auto culled = CullBlocks(md, CullingRegion::Sphere(accretion_radius_));
+  const auto &block_idx = culled.idx;
+
   Kokkos::parallel_reduce(
       "AGNTriggering::ReduceBondi",
-      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
-          DevExecSpace(), {0, kb.s, jb.s, ib.s},
-          {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
-          {1, 1, 1, ib.e + 1 - ib.s}),
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i,
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(DevExecSpace(), {0, kb.s, jb.s, ib.s},
+                                             {culled.n, kb.e + 1, jb.e + 1, ib.e + 1},
+                                             {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i,
                     Real &ltotal_mass_red, Real &lmass_weighted_density_red,
                     Real &lmass_weighted_velocity_red, Real &lmass_weighted_cs_red) {
+        const int b = block_idx(n);
         auto &prim = prim_pack(b);
         const auto &coords = prim_pack.GetCoords(b);
         const parthenon::Real r2 =
@@ -279,6 +308,11 @@ void AGNTriggering::RemoveBondiAccretedGas(parthenon::MeshData<parthenon::Real>
   // FIXME(forrestglines) When reductions are called, is `prim` up to date?
   const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
   const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+#ifdef ATHENAPK_MIXED_PRECISION
+  // The single precision copy of `prim` used in the flux calculation needs to be updated
+  // together with `prim`
+  const auto &prim_sp_pack = md->PackVariables(std::vector<std::string>{"prim_sp"});
+#endif
   IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
@@ -290,10 +324,15 @@ void AGNTriggering::RemoveBondiAccretedGas(parthenon::MeshData<parthenon::Real>
   const Real accretion_rate = GetAccretionRate(hydro_pkg.get());
   const Real total_mass = hydro_pkg->Param<Real>("agn_triggering_total_mass");
 
+  // Only launch over blocks within the accretion radius
+  const auto culled = CullBlocks(md, CullingRegion::Sphere(accretion_radius_));
+  const auto &block_idx = culled.idx;
+
   parthenon::par_for(
       parthenon::loop_pattern_mdrange_tag, "AGNTriggering::RemoveBondiAccretedGas",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e, KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+      parthenon::DevExecSpace(), 0, culled.n - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i) {
+        const int b = block_idx(n);
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
@@ -310,6 +349,9 @@ void AGNTriggering::RemoveBondiAccretedGas(parthenon::MeshData<parthenon::Real>
 
           // Update the Primitives
           eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+#ifdef ATHENAPK_MIXED_PRECISION
+          Hydro::StorePrimSP(prim, prim_sp_pack(b), nhydro + nscalars, k, j, i);
+#endif
         }
       });
 }
@@ -440,47 +482,6 @@ AGNTriggeringReduceTriggering(parthenon::MeshData<parthenon::Real> *md,
   return TaskStatus::complete;
 }
 
-parthenon::TaskStatus
-AGNTriggeringMPIReduceTriggering(parthenon::StateDescriptor *hydro_pkg) {
-#ifdef MPI_PARALLEL
-  const auto &agn_triggering = hydro_pkg->Param<AGNTriggering>("agn_triggering");
-  switch (agn_triggering.triggering_mode_) {
-  case AGNTriggeringMode::COLD_GAS: {
-
-    Real accretion_rate = hydro_pkg->Param<Real>("agn_triggering_cold_mass");
-    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &accretion_rate, 1,
-                                      MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
-    hydro_pkg->UpdateParam("agn_triggering_cold_mass", accretion_rate);
-    break;
-  }
-  case AGNTriggeringMode::BOOSTED_BONDI:
-  case AGNTriggeringMode::BOOTH_SCHAYE: {
-    Real triggering_quantities[] = {
-        hydro_pkg->Param<Real>("agn_triggering_total_mass"),
-        hydro_pkg->Param<Real>("agn_triggering_mass_weighted_density"),
-        hydro_pkg->Param<Real>("agn_triggering_mass_weighted_velocity"),
-        hydro_pkg->Param<Real>("agn_triggering_mass_weighted_cs"),
-    };
-
-    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &triggering_quantities, 4,
-                                      MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
-
-    hydro_pkg->UpdateParam("agn_triggering_total_mass", triggering_quantities[0]);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_density",
-                           triggering_quantities[1]);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_velocity",
-                           triggering_quantities[2]);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_cs", triggering_quantities[3]);
-    break;
-  }
-  case AGNTriggeringMode::NONE: {
-    break;
-  }
-  }
-#endif
-  return TaskStatus::complete;
-}
-
 parthenon::TaskStatus
 AGNTriggeringFinalizeTriggering(parthenon::MeshData<parthenon::Real> *md,
                                 const parthenon::SimTime &tm) {
@@ -100,9 +100,6 @@ class AGNTriggering {
   AGNTriggeringReduceTriggering(parthenon::MeshData<parthenon::Real> *md,
                                 const parthenon::Real dt);
 
-  friend parthenon::TaskStatus
-  AGNTriggeringMPIReduceTriggering(parthenon::StateDescriptor *hydro_pkg);
-
   friend parthenon::TaskStatus
   AGNTriggeringFinalizeTriggering(parthenon::MeshData<parthenon::Real> *md,
                                   const parthenon::SimTime &tm);
@@ -119,9 +116,6 @@ parthenon::TaskStatus
 AGNTriggeringReduceTriggering(parthenon::MeshData<parthenon::Real> *md,
                               const parthenon::Real dt);
 
-parthenon::TaskStatus
-AGNTriggeringMPIReduceTriggering(parthenon::StateDescriptor *hydro_pkg);
-
 parthenon::TaskStatus
 AGNTriggeringFinalizeTriggering(parthenon::MeshData<parthenon::Real> *md,
                                 const parthenon::SimTime &tm);
@@ -0,0 +1,154 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file cluster_block_culling.cpp
+//  \brief Culling of blocks for source terms that are localized around the SMBH
+
+// C++ headers
+#include <algorithm> // max
+#include <cmath>     // fabs, sqrt
+#include <mutex>     // lock_guard
+#include <utility>   // make_pair
+#include <vector>
+
+// Parthenon headers
+#include <globals.hpp>
+#include <kokkos_abstraction.hpp>
+#include <mesh/mesh.hpp>
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "../../main.hpp"
+#include "cluster_block_culling.hpp"
+
+namespace cluster {
+using namespace parthenon;
+
+CullingRegion CullingRegion::Everywhere() {
+  CullingRegion region;
+  region.everywhere_ = true;
+  return region;
+}
+
+CullingRegion CullingRegion::Sphere(const Real radius) {
+  CullingRegion region;
+  region.shapes_.push_back({ShapeType::sphere, radius, 0.0, {0.0, 0.0, 0.0}});
+  return region;
+}
+
+CullingRegion CullingRegion::Cylinder(const Real radius, const Real half_height,
+                                      const Real axis_x, const Real axis_y,
+                                      const Real axis_z) {
+  CullingRegion region;
+  region.shapes_.push_back(
+      {ShapeType::cylinder, radius, half_height, {axis_x, axis_y, axis_z}});
+  return region;
+}
+
+CullingRegion &CullingRegion::Add(const CullingRegion &other) {
+  everywhere_ = everywhere_ || other.everywhere_;
+  shapes_.insert(shapes_.end(), other.shapes_.begin(), other.shapes_.end());
+  return *this;
+}
+
+bool CullingRegion::Intersects(const Real xmin[3], const Real xmax[3]) const {
+  if (everywhere_) {
+    return true;
+  }
+
+  // Center, half extent, and half diagonal of the box
+  Real center[3], half_extent[3];
+  Real half_diag2 = 0.0;
+  for (int d = 0; d < 3; d++) {
+    center[d] = 0.5 * (xmin[d] + xmax[d]);
+    half_extent[d] = 0.5 * (xmax[d] - xmin[d]);
+    half_diag2 += SQR(half_extent[d]);
+  }
+  const Real half_diag = std::sqrt(half_diag2);
+
+  for (const auto &shape : shapes_) {
+    if (shape.type == ShapeType::sphere) {
+      // Exact distance of the box to the origin
+      Real dist2 = 0.0;
+      for (int d = 0; d < 3; d++) {
+        dist2 += SQR(std::max({xmin[d], -xmax[d], Real(0.0)}));
+      }
+      if (dist2 <= SQR(shape.radius)) {
+        return true;
+      }
+    } else if (shape.type == ShapeType::cylinder) {
+      // Both the distance of the box to the axis and to the plane perpendicular to the
+      // axis need to be within the cylinder. The former is bounded using the bounding
+      // sphere of the box so that blocks intersecting the cylinder are never culled.
+      Real h = 0.0, h_extent = 0.0;
+      for (int d = 0; d < 3; d++) {
+        h += center[d] * shape.axis[d];
+        h_extent += half_extent[d] * std::fabs(shape.axis[d]);
+      }
+      Real r2 = 0.0;
+      for (int d = 0; d < 3; d++) {
+        r2 += SQR(center[d] - h * shape.axis[d]);
+      }
+      if (std::fabs(h) - h_extent <= shape.half_height &&
+          std::sqrt(r2) - half_diag <= shape.radius) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+ParArray1D<int> CulledBlockIdxBuffers::Get(const MeshData<Real> *md, const int nblocks) {
+  std::lock_guard<std::mutex> lock(*mutex_);
+  auto &buffer = buffers_[md];
+  if (buffer.extent_int(0) < nblocks) {
+    buffer = ParArray1D<int>("culled_block_idx", nblocks);
+  }
+  return buffer;
+}
+
+CulledBlocks CullBlocks(MeshData<Real> *md, const CullingRegion &region) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const bool block_culling = hydro_pkg->Param<bool>("block_culling");
+
+  const int nblocks = md->NumBlocks();
+  std::vector<int> block_idx;
+  block_idx.reserve(nblocks);
+
+  for (int b = 0; b < nblocks; b++) {
+    const auto &pmb = md->GetBlockData(b)->GetBlockPointer();
+    // Bounding box of the block including ghost zones
+    Real xmin[3], xmax[3];
+    for (int d = 0; d < 3; d++) {
+      const auto dir = static_cast<CoordinateDirection>(d + 1);
+      const int nx = pmb->block_size.nx(dir);
+      const Real dx = (pmb->block_size.xmax(dir) - pmb->block_size.xmin(dir)) / nx;
+      const Real nghost_dx = nx > 1 ? Globals::nghost * dx : 0.0;
+      xmin[d] = pmb->block_size.xmin(dir) - nghost_dx;
+      xmax[d] = pmb->block_size.xmax(dir) + nghost_dx;
+    }
+    if (!block_culling || region.Intersects(xmin, xmax)) {
+      block_idx.push_back(b);
+    }
+  }
+
+  // The indices are copied to the device buffer of this partition. Reusing the buffer
+  // between calls (for the same partition, which are sequential) is safe as the copy
+  // fences, i.e., kernels launched with a previous list have completed.
+  auto idx = hydro_pkg->MutableParam<CulledBlockIdxBuffers>("culled_block_idx")
+                 ->Get(md, nblocks);
+
+  CulledBlocks culled;
+  culled.n = static_cast<int>(block_idx.size());
+  culled.idx = idx;
+  if (culled.n > 0) {
+    Kokkos::View<const int *, HostMemSpace, Kokkos::MemoryUnmanaged> idx_h(
+        block_idx.data(), culled.n);
+    Kokkos::deep_copy(Kokkos::subview(idx, std::make_pair(0, culled.n)), idx_h);
+  }
+  return culled;
+}
+
+} // namespace cluster
@@ -0,0 +1,107 @@
+#ifndef CLUSTER_CLUSTER_BLOCK_CULLING_HPP_
+#define CLUSTER_CLUSTER_BLOCK_CULLING_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file cluster_block_culling.hpp
+//  \brief Culling of blocks for source terms that are localized around the SMBH
+
+// C++ headers
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// parthenon headers
+#include <basic_types.hpp>
+#include <mesh/mesh.hpp>
+#include <parthenon/package.hpp>
+
+namespace cluster {
+
+/************************************************************
+ *  Culling Region, a (conservative) bounding region of a localized source term
+ *  centered on the SMBH (i.e., the origin). A region is a union of spheres and
+ *  cylinders (or covers everything).
+ ************************************************************/
+class CullingRegion {
+ public:
+  // Region that does not contain anything (to be extended by `Add`)
+  CullingRegion() : everywhere_(false) {}
+
+  // Region covering the entire domain, i.e., no block is culled
+  static CullingRegion Everywhere();
+
+  // Sphere with `radius`
+  static CullingRegion Sphere(const parthenon::Real radius);
+
+  // Cylinder with `radius` extending from `-half_height` to `half_height` along the
+  // (normalized) axis `axis_x`, `axis_y`, `axis_z`
+  static CullingRegion Cylinder(const parthenon::Real radius,
+                                const parthenon::Real half_height,
+                                const parthenon::Real axis_x,
+                                const parthenon::Real axis_y,
+                                const parthenon::Real axis_z);
+
+  // Extend this region by `other` (i.e., the union of both)
+  CullingRegion &Add(const CullingRegion &other);
+
+  // Whether the axis aligned box from `xmin` to `xmax` (potentially) intersects the
+  // region. Only returns false if the box is guaranteed to not intersect the region.
+  bool Intersects(const parthenon::Real xmin[3], const parthenon::Real xmax[3]) const;
+
+ private:
+  enum class ShapeType { sphere, cylinder };
+  struct Shape {
+    ShapeType type;
+    parthenon::Real radius, half_height;
+    parthenon::Real axis[3];
+  };
+  std::vector<Shape> shapes_;
+  bool everywhere_;
+};
+
+// Device buffers of the culled block indices (stored in the "culled_block_idx" param of
+// the "Hydro" package), one per MeshData so that different partitions can be processed
+// concurrently (e.g., by different threads) without sharing a buffer.
+class CulledBlockIdxBuffers {
+ public:
+  CulledBlockIdxBuffers() : mutex_(std::make_shared<std::mutex>()) {}
+
+  // Buffer of `md` with at least `nblocks` entries (reallocated if the partition has
+  // more blocks than the buffer can hold, e.g., after load balancing).
+  // Buffers of partitions that no longer exist are reused by new partitions with the
+  // same address and otherwise only freed at the end of the simulation.
+  parthenon::ParArray1D<int> Get(const parthenon::MeshData<parthenon::Real> *md,
+                                 const int nblocks);
+
+ private:
+  // Shared as Params require copyable types. Only guards the map, not the buffers.
+  std::shared_ptr<std::mutex> mutex_;
+  std::unordered_map<const parthenon::MeshData<parthenon::Real> *,
+                     parthenon::ParArray1D<int>>
+      buffers_;
+};
+
+// Blocks of a MeshData partition (potentially) intersecting a CullingRegion
+struct CulledBlocks {
+  // Indices of the blocks within the MeshData (on device). Only the first `n` entries
+  // are valid and they are overwritten by the next call of `CullBlocks` for the same
+  // MeshData.
+  parthenon::ParArray1D<int> idx;
+  // Number of blocks
+  int n;
+};
+
+// Get the blocks (including their ghost zones) of `md` that intersect `region`.
+// The list is rebuilt on every call as regions may move (e.g., with a precessing jet)
+// and partitions change with AMR. If `problem/cluster/block_culling` is disabled, all
+// blocks are returned.
+CulledBlocks CullBlocks(parthenon::MeshData<parthenon::Real> *md,
+                        const CullingRegion &region);
+
+} // namespace cluster
+
+#endif // CLUSTER_CLUSTER_BLOCK_CULLING_HPP_
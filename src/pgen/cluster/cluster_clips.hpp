@@ -1,5 +1,3 @@
-
-
 #ifndef CLUSTER_CLUSTER_CLIPS_HPP_
 #define CLUSTER_CLUSTER_CLIPS_HPP_
 //========================================================================================
@@ -11,17 +9,134 @@
 //  \brief  Class for applying floors and ceils and reducing removed/added mass/energy
 
 // C++ headers
-#include <cmath> // sqrt()
+#include <cmath>  // sqrt()
+#include <limits> // numeric_limits
 
 // Parthenon headers
 #include "basic_types.hpp"
 #include "mesh/mesh.hpp"
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "../../main.hpp"
 
 namespace cluster {
 
-void ApplyClusterClips(MeshData<Real> *md, const parthenon::SimTime &tm,
-                       const Real beta_dt);
+/************************************************************
+ *  Cluster Clips Object, for applying ceilings on temperature, velocity, alfven
+ *  velocity, and a density floor within a radius of the AGN to single cells
+ *    Lightweight object intended for inlined computation within kernels
+ ************************************************************/
+class ClusterClipsObj {
+ private:
+  const parthenon::Real clip_r2_, dfloor_, eceil_, vceil_, vAceil_, gm1_;
+  const bool magnetic_fields_;
+  const int nhydro_, nscalars_;
+
+ public:
+  ClusterClipsObj(const parthenon::Real clip_r, const parthenon::Real dfloor,
+                  const parthenon::Real eceil, const parthenon::Real vceil,
+                  const parthenon::Real vAceil, const parthenon::Real gm1,
+                  const bool magnetic_fields, const int nhydro, const int nscalars)
+      : clip_r2_(SQR(clip_r)), dfloor_(dfloor), eceil_(eceil), vceil_(vceil),
+        vAceil_(vAceil), gm1_(gm1), magnetic_fields_(magnetic_fields), nhydro_(nhydro),
+        nscalars_(nscalars) {}
+
+  // Apply the clips to the cell at x, y, z and add the added mass/removed energy
+  template <typename EOS, typename View4D>
+  KOKKOS_INLINE_FUNCTION void
+  ClipsCell(const EOS &eos, View4D &cons, View4D &prim, const parthenon::Real x,
+            const parthenon::Real y, const parthenon::Real z,
+            const parthenon::Real cell_volume, const int k, const int j, const int i,
+            parthenon::Real &added_dfloor_mass, parthenon::Real &removed_vceil_energy,
+            parthenon::Real &added_vAceil_mass,
+            parthenon::Real &removed_eceil_energy) const __attribute__((always_inline)) {
+    using parthenon::Real;
+
+    const Real r2 = SQR(x) + SQR(y) + SQR(z);
+
+    if (r2 >= clip_r2_) {
+      return;
+    }
+    // Cell falls within clipping radius
+    eos.ConsToPrim(cons, prim, nhydro_, nscalars_, k, j, i);
+
+    if (dfloor_ > 0) {
+      const Real rho = prim(IDN, k, j, i);
+      if (rho < dfloor_) {
+        added_dfloor_mass += (dfloor_ - rho) * cell_volume;
+        cons(IDN, k, j, i) = dfloor_;
+        prim(IDN, k, j, i) = dfloor_;
+      }
+    }
+
+    if (vceil_ < std::numeric_limits<Real>::infinity()) {
+      // Apply velocity ceiling
+      const Real v2 =
+          SQR(prim(IV1, k, j, i)) + SQR(prim(IV2, k, j, i)) + SQR(prim(IV3, k, j, i));
+      const Real vceil2 = SQR(vceil_);
+      if (v2 > vceil2) {
+        // Fix the velocity to the velocity ceiling
+        const Real v = sqrt(v2);
+        cons(IM1, k, j, i) *= vceil_ / v;
+        cons(IM2, k, j, i) *= vceil_ / v;
+        cons(IM3, k, j, i) *= vceil_ / v;
+        prim(IV1, k, j, i) *= vceil_ / v;
+        prim(IV2, k, j, i) *= vceil_ / v;
+        prim(IV3, k, j, i) *= vceil_ / v;
+
+        // Remove kinetic energy
+        const Real removed_energy = 0.5 * prim(IDN, k, j, i) * (v2 - vceil2);
+        removed_vceil_energy += removed_energy * cell_volume;
+        cons(IEN, k, j, i) -= removed_energy;
+      }
+    }
+
+    const Real vAceil2 = SQR(vAceil_);
+    if (magnetic_fields_ && vAceil2 < std::numeric_limits<Real>::infinity()) {
+      // Apply Alfven velocity ceiling by raising density
+      const Real rho = prim(IDN, k, j, i);
+      const Real B2 =
+          (SQR(prim(IB1, k, j, i)) + SQR(prim(IB2, k, j, i)) + SQR(prim(IB3, k, j, i)));
+
+      // compute Alfven mach number
+      const Real va2 = (B2 / rho);
+
+      if (va2 > vAceil2) {
+        // Increase the density to match the alfven velocity ceiling
+        const Real rho_new = std::sqrt(B2 / vAceil2);
+        added_vAceil_mass += (rho_new - rho) * cell_volume;
+        cons(IDN, k, j, i) = rho_new;
+        prim(IDN, k, j, i) = rho_new;
+      }
+    }
+
+    if (eceil_ < std::numeric_limits<Real>::infinity()) {
+      // Apply  internal energy ceiling as a pressure ceiling
+      const Real internal_e = prim(IPR, k, j, i) / (gm1_ * prim(IDN, k, j, i));
+      if (internal_e > eceil_) {
+        const Real removed_energy = prim(IDN, k, j, i) * (internal_e - eceil_);
+        removed_eceil_energy += removed_energy * cell_volume;
+        cons(IEN, k, j, i) -= removed_energy;
+        prim(IPR, k, j, i) = gm1_ * prim(IDN, k, j, i) * eceil_;
+      }
+    }
+  }
+};
+
+// Whether any clips are enabled
+bool ClusterClipsActive(parthenon::StateDescriptor *hydro_pkg);
+
+// Get the object to apply the clips within a kernel
+ClusterClipsObj GetClusterClipsObj(parthenon::StateDescriptor *hydro_pkg);
+
+// Add the added mass/removed energy by the clips to the running totals
+void AddClusterClipsReductions(parthenon::StateDescriptor *hydro_pkg,
+                               const parthenon::Real added_dfloor_mass,
+                               const parthenon::Real removed_vceil_energy,
+                               const parthenon::Real added_vAceil_mass,
+                               const parthenon::Real removed_eceil_energy);
 
-}
+} // namespace cluster
 
-#endif // CLUSTER_AGN_TRIGGERING_HPP_
\ No newline at end of file
+#endif // CLUSTER_CLUSTER_CLIPS_HPP_
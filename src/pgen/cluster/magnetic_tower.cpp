@@ -26,30 +26,38 @@
 namespace cluster {
 using namespace parthenon;
 
-void MagneticTower::AddSrcTerm(parthenon::Real field_to_add, parthenon::Real mass_to_add,
-                               parthenon::MeshData<parthenon::Real> *md,
-                               const parthenon::SimTime &tm) const {
-  using parthenon::IndexDomain;
-  using parthenon::IndexRange;
-  using parthenon::Real;
-
-  if (field_to_add == 0 && mass_to_add == 0) {
-    return; // Nothing to do
+// Number of (Gaussian) length scales of the tower beyond which the added field and mass
+// are below roundoff (exp(-8^2) ~ 1e-28) relative to their peak
+constexpr Real kCullingLengthScales = 8.0;
+
+CullingRegion MagneticTower::GetCullingRegion(const JetCoords &jet_coords,
+                                              const bool with_mass) const {
+  CullingRegion region;
+  if (potential_ == MagneticTowerPotential::donut) {
+    Real jet_axis_x, jet_axis_y, jet_axis_z;
+    jet_coords.JetCylToSimCartVector(1, 0, 0, 0, 1, jet_axis_x, jet_axis_y, jet_axis_z);
+    region.Add(CullingRegion::Cylinder(kCullingLengthScales * l_scale_,
+                                       offset_ + thickness_, jet_axis_x, jet_axis_y,
+                                       jet_axis_z));
+  } else {
+    region.Add(CullingRegion::Sphere(kCullingLengthScales * l_scale_));
   }
-
-  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-  if (hydro_pkg->Param<Fluid>("fluid") != Fluid::glmmhd) {
-    PARTHENON_FAIL("MagneticTower::AddSrcTerm: Only Fluid::glmmhd is supported");
+  if (with_mass) {
+    region.Add(CullingRegion::Sphere(kCullingLengthScales * l_mass_scale_));
   }
+  return region;
+}
 
-  // Grab some necessary variables
-  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
-  const auto &A_pack = md->PackVariables(std::vector<std::string>{"magnetic_tower_A"});
+MagneticTowerObj MagneticTower::GetSrcTermObj(const parthenon::Real field_to_add,
+                                              const parthenon::Real mass_to_add,
+                                              parthenon::StateDescriptor *hydro_pkg,
+                                              const parthenon::SimTime &tm) const {
+  using parthenon::Real;
 
-  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
-  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+  if ((field_to_add != 0 || mass_to_add != 0) &&
+      hydro_pkg->Param<Fluid>("fluid") != Fluid::glmmhd) {
+    PARTHENON_FAIL("MagneticTower::GetSrcTermObj: Only Fluid::glmmhd is supported");
+  }
 
   // Scale density_to_add to match mass_to_add when integrated over all space
   PARTHENON_REQUIRE_THROWS(
@@ -62,81 +70,8 @@ void MagneticTower::AddSrcTerm(parthenon::Real field_to_add, parthenon::Real mas
 
   const JetCoords jet_coords =
       hydro_pkg->Param<JetCoordsFactory>("jet_coords_factory").CreateJetCoords(tm.time);
-  const MagneticTowerObj mt =
-      MagneticTowerObj(field_to_add, alpha_, l_scale_, offset_, thickness_,
-                       density_to_add, l_mass_scale_, jet_coords, potential_);
-
-  const auto &eos = hydro_pkg->Param<AdiabaticGLMMHDEOS>("eos");
-
-  // Construct magnetic vector potential then compute magnetic fields
-  IndexRange a_ib = ib;
-  a_ib.s -= 1;
-  a_ib.e += 1;
-  IndexRange a_jb = jb;
-  a_jb.s -= 1;
-  a_jb.e += 1;
-  IndexRange a_kb = kb;
-  a_kb.s -= 1;
-  a_kb.e += 1;
-
-  // Construct the magnetic tower potential
-  parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "MagneticTower::AddFieldSrcTerm::ConstructPotential",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, a_kb.s, a_kb.e, a_jb.s,
-      a_jb.e, a_ib.s, a_ib.e,
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
-        // Compute and apply potential
-        auto &A = A_pack(b);
-        const auto &coords = cons_pack.GetCoords(b);
-
-        Real a_x_, a_y_, a_z_;
-        mt.PotentialInSimCart(coords.Xc<1>(i), coords.Xc<2>(j), coords.Xc<3>(k), a_x_,
-                              a_y_, a_z_);
-
-        A(0, k, j, i) = a_x_;
-        A(1, k, j, i) = a_y_;
-        A(2, k, j, i) = a_z_;
-      });
-
-  // Take the curl of the potential and apply the new magnetic field
-  parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "MagneticTower::MagneticFieldSrcTerm::ApplyPotential",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e, KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
-        auto &cons = cons_pack(b);
-        auto &prim = prim_pack(b);
-        auto &A = A_pack(b);
-        const auto &coords = cons_pack.GetCoords(b);
-
-        // Take the curl of a to compute the magnetic field
-        const Real b_x =
-            (A(2, k, j + 1, i) - A(2, k, j - 1, i)) / coords.Dxc<2>(j) / 2.0 -
-            (A(1, k + 1, j, i) - A(1, k - 1, j, i)) / coords.Dxc<3>(k) / 2.0;
-        const Real b_y =
-            (A(0, k + 1, j, i) - A(0, k - 1, j, i)) / coords.Dxc<3>(k) / 2.0 -
-            (A(2, k, j, i + 1) - A(2, k, j, i - 1)) / coords.Dxc<1>(i) / 2.0;
-        const Real b_z =
-            (A(1, k, j, i + 1) - A(1, k, j, i - 1)) / coords.Dxc<1>(i) / 2.0 -
-            (A(0, k, j + 1, i) - A(0, k, j - 1, i)) / coords.Dxc<2>(j) / 2.0;
-
-        // Add the magnetic field to the conserved variables
-        cons(IB1, k, j, i) += b_x;
-        cons(IB2, k, j, i) += b_y;
-        cons(IB3, k, j, i) += b_z;
-
-        // Add the magnetic field energy given the existing field in prim
-        // dE_B = 1/2*( 2*dt*B_old*B_new + dt**2*B_new**2)
-        cons(IEN, k, j, i) += prim(IB1, k, j, i) * b_x + prim(IB2, k, j, i) * b_y +
-                              prim(IB3, k, j, i) * b_z +
-                              0.5 * (b_x * b_x + b_y * b_y + b_z * b_z);
-
-        // Add density
-        const auto cell_delta_rho =
-            density_to_add > 0.0
-                ? mt.DensityFromSimCart(coords.Xc<1>(i), coords.Xc<2>(j), coords.Xc<3>(k))
-                : 0.0;
-        cons(IDN, k, j, i) += cell_delta_rho;
-      });
+  return MagneticTowerObj(field_to_add, alpha_, l_scale_, offset_, thickness_,
+                          density_to_add, l_mass_scale_, jet_coords, potential_);
 }
 
 // Compute the increase to magnetic energy (1/2*B**2) over local meshes.  Adds
@@ -170,14 +105,18 @@ void MagneticTower::ReducePowerContribs(parthenon::Real &linear_contrib,
   // Get the reduction of the linear and quadratic contributions ready
   Real linear_contrib_red, quadratic_contrib_red;
 
+  // Only launch over blocks where the tower adds field
+  const auto culled = CullBlocks(md, GetCullingRegion(jet_coords, false));
+  const auto &block_idx = culled.idx;
+
   Kokkos::parallel_reduce(
       "MagneticTowerScaleFactor",
-      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
-          DevExecSpace(), {0, kb.s, jb.s, ib.s},
-          {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
-          {1, 1, 1, ib.e + 1 - ib.s}),
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i,
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(DevExecSpace(), {0, kb.s, jb.s, ib.s},
+                                             {culled.n, kb.e + 1, jb.e + 1, ib.e + 1},
+                                             {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i,
                     Real &llinear_contrib_red, Real &lquadratic_contrib_red) {
+        const int b = block_idx(n);
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
@@ -240,38 +179,21 @@ MagneticTower::AddInitialFieldToPotential<>(MeshBlock *pmb, IndexRange kb, Index
                                             IndexRange ib,
                                             const ParArray4D<Real> &A) const;
 
-// Add the fixed_field_rate  (and associated magnetic energy) to the
-// conserved variables for all meshblocks with a MeshData
-void MagneticTower::FixedFieldSrcTerm(parthenon::MeshData<parthenon::Real> *md,
-                                      const parthenon::Real beta_dt,
-                                      const parthenon::SimTime &tm) const {
-
-  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-
-  if (fixed_field_rate_ != 0) {
-    AddSrcTerm(fixed_field_rate_ * beta_dt, fixed_mass_rate_ * beta_dt, md, tm);
-  }
-}
-
-// Add the specified magnetic power  (and associated magnetic field) to the
-// conserved variables for all meshblocks with a MeshData
-void MagneticTower::PowerSrcTerm(const parthenon::Real power,
-                                 const parthenon::Real mass_rate,
-                                 parthenon::MeshData<parthenon::Real> *md,
-                                 const parthenon::Real beta_dt,
-                                 const parthenon::SimTime &tm) const {
+// Get the field strength to add in order to inject the specified magnetic power
+parthenon::Real
+MagneticTower::GetPowerFieldToAdd(const parthenon::Real power,
+                                  const parthenon::Real beta_dt,
+                                  parthenon::StateDescriptor *hydro_pkg) const {
   if (power == 0) {
-    // Nothing to inject, return
-    return;
+    // Nothing to inject
+    return 0.0;
   }
 
-  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-
   const Real linear_contrib = hydro_pkg->Param<Real>("magnetic_tower_linear_contrib");
   const Real quadratic_contrib =
       hydro_pkg->Param<Real>("magnetic_tower_quadratic_contrib");
   if (linear_contrib == 0 && quadratic_contrib == 0) {
-    PARTHENON_FAIL("MagneticTowerModel::PowerSrcTerm mt_linear_contrib "
+    PARTHENON_FAIL("MagneticTowerModel::GetPowerFieldToAdd mt_linear_contrib "
                    "and mt_quadratic_contrib are both zero. "
                    "(Has MagneticTowerReducePowerContribs been called?)");
   }
@@ -280,15 +202,12 @@ void MagneticTower::PowerSrcTerm(const parthenon::Real power,
       linear_contrib * linear_contrib + 4 * quadratic_contrib * beta_dt * power;
   if (disc < 0 || quadratic_contrib == 0) {
     std::stringstream msg;
-    msg << "MagneticTowerModel::PowerSrcTerm No field rate is viable"
+    msg << "MagneticTowerModel::GetPowerFieldToAdd No field rate is viable"
         << " linear_contrib: " << std::to_string(linear_contrib)
         << " quadratic_contrib: " << std::to_string(quadratic_contrib);
     PARTHENON_FAIL(msg);
   }
-  const Real field_to_add = (-linear_contrib + sqrt(disc)) / (2 * quadratic_contrib);
-  const Real mass_to_add = mass_rate * beta_dt;
-
-  AddSrcTerm(field_to_add, mass_to_add, md, tm);
+  return (-linear_contrib + sqrt(disc)) / (2 * quadratic_contrib);
 }
 
 parthenon::TaskStatus
@@ -16,6 +16,8 @@
 #include <parameter_input.hpp>
 #include <parthenon/package.hpp>
 
+#include "../../main.hpp"
+#include "cluster_block_culling.hpp"
 #include "jet_coords.hpp"
 #include "utils/error_checking.hpp"
 
@@ -50,7 +52,7 @@ class MagneticTowerObj {
       : field_(field), alpha_(alpha), l_scale_(l_scale), offset_(offset),
         thickness_(thickness), density_(density), l_mass_scale2_(SQR(l_mass_scale)),
         jet_coords_(jet_coords), potential_(potential) {
-    PARTHENON_REQUIRE(l_scale > 0,
+    PARTHENON_REQUIRE(field == 0 || l_scale > 0,
                       "Magnetic Tower Length scale must be strictly postitive");
     PARTHENON_REQUIRE(
         l_mass_scale >= 0,
@@ -156,6 +158,53 @@ class MagneticTowerObj {
 
     return density_ * exp(-(SQR(r) + SQR(h)) / l_mass_scale2_);
   }
+
+  // Add the magnetic field (and associated magnetic energy) and density of the tower to
+  // a single cell. The field is the (discrete) curl of the potential evaluated at the
+  // neighboring cell centers so that no divergence is introduced.
+  template <typename View4D>
+  KOKKOS_INLINE_FUNCTION void
+  AddSrcTermCell(View4D &cons, const View4D &prim, const parthenon::Coordinates_t &coords,
+                 const int k, const int j, const int i) const
+      __attribute__((always_inline)) {
+    using parthenon::Real;
+
+    const Real x = coords.Xc<1>(i);
+    const Real y = coords.Xc<2>(j);
+    const Real z = coords.Xc<3>(k);
+
+    // Potential at the neighboring cell centers
+    Real a_xm[3], a_xp[3], a_ym[3], a_yp[3], a_zm[3], a_zp[3];
+    PotentialInSimCart(coords.Xc<1>(i - 1), y, z, a_xm[0], a_xm[1], a_xm[2]);
+    PotentialInSimCart(coords.Xc<1>(i + 1), y, z, a_xp[0], a_xp[1], a_xp[2]);
+    PotentialInSimCart(x, coords.Xc<2>(j - 1), z, a_ym[0], a_ym[1], a_ym[2]);
+    PotentialInSimCart(x, coords.Xc<2>(j + 1), z, a_yp[0], a_yp[1], a_yp[2]);
+    PotentialInSimCart(x, y, coords.Xc<3>(k - 1), a_zm[0], a_zm[1], a_zm[2]);
+    PotentialInSimCart(x, y, coords.Xc<3>(k + 1), a_zp[0], a_zp[1], a_zp[2]);
+
+    // Take the curl of a to compute the magnetic field
+    const Real b_x = (a_yp[2] - a_ym[2]) / coords.Dxc<2>(j) / 2.0 -
+                     (a_zp[1] - a_zm[1]) / coords.Dxc<3>(k) / 2.0;
+    const Real b_y = (a_zp[0] - a_zm[0]) / coords.Dxc<3>(k) / 2.0 -
+                     (a_xp[2] - a_xm[2]) / coords.Dxc<1>(i) / 2.0;
+    const Real b_z = (a_xp[1] - a_xm[1]) / coords.Dxc<1>(i) / 2.0 -
+                     (a_yp[0] - a_ym[0]) / coords.Dxc<2>(j) / 2.0;
+
+    // Add the magnetic field to the conserved variables
+    cons(IB1, k, j, i) += b_x;
+    cons(IB2, k, j, i) += b_y;
+    cons(IB3, k, j, i) += b_z;
+
+    // Add the magnetic field energy given the existing field in prim
+    // dE_B = 1/2*( 2*dt*B_old*B_new + dt**2*B_new**2)
+    cons(IEN, k, j, i) += prim(IB1, k, j, i) * b_x + prim(IB2, k, j, i) * b_y +
+                          prim(IB3, k, j, i) * b_z +
+                          0.5 * (b_x * b_x + b_y * b_y + b_z * b_z);
+
+    // Add density
+    const auto cell_delta_rho = density_ > 0.0 ? DensityFromSimCart(x, y, z) : 0.0;
+    cons(IDN, k, j, i) += cell_delta_rho;
+  }
 };
 
 /************************************************************
@@ -206,13 +255,6 @@ class MagneticTower {
                                "for the Li tower model");
     }
 
-    // Vector potential is only locally used, so no need to
-    // communicate/restrict/prolongate/fluxes/etc
-    parthenon::Metadata m({parthenon::Metadata::Cell, parthenon::Metadata::Derived,
-                           parthenon::Metadata::OneCopy},
-                          std::vector<int>({3}));
-    hydro_pkg->AddField("magnetic_tower_A", m);
-
     // Finally, add object to params (should be done last as otherwise modification within
     // this function would not survive).
     hydro_pkg->AddParam<>("magnetic_tower", *this);
@@ -224,23 +266,18 @@ class MagneticTower {
                                   parthenon::IndexRange jb, parthenon::IndexRange ib,
                                   const View4D &A) const;
 
-  // Add the fixed_field_rate  (and associated magnetic energy) to the
-  // conserved variables for all meshblocks within a MeshData
-  void FixedFieldSrcTerm(parthenon::MeshData<parthenon::Real> *md,
-                         const parthenon::Real beta_dt,
-                         const parthenon::SimTime &tm) const;
+  // Get the field strength to add in order to inject the specified magnetic power over
+  // beta_dt (requires the power contributions reduced over all meshblocks)
+  parthenon::Real GetPowerFieldToAdd(const parthenon::Real power,
+                                     const parthenon::Real beta_dt,
+                                     parthenon::StateDescriptor *hydro_pkg) const;
 
-  // Add the specified magnetic power  (and associated magnetic field) to the
-  // conserved variables for all meshblocks within a MeshData
-  void PowerSrcTerm(const parthenon::Real power, const parthenon::Real mass_rate,
-                    parthenon::MeshData<parthenon::Real> *md,
-                    const parthenon::Real beta_dt, const parthenon::SimTime &tm) const;
-
-  // Add the specified magnetic field (and associated magnetic energy) to the
-  // conserved variables for all meshblocks with a MeshData
-  void AddSrcTerm(parthenon::Real field_to_add, parthenon::Real mass_to_add,
-                  parthenon::MeshData<parthenon::Real> *md,
-                  const parthenon::SimTime &tm) const;
+  // Get the object to add the specified magnetic field (and associated magnetic energy)
+  // and mass within a kernel
+  MagneticTowerObj GetSrcTermObj(const parthenon::Real field_to_add,
+                                 const parthenon::Real mass_to_add,
+                                 parthenon::StateDescriptor *hydro_pkg,
+                                 const parthenon::SimTime &tm) const;
 
   // Compute the increase to magnetic energy (1/2*B**2) over local meshes.  Adds
   // to linear_contrib and quadratic_contrib
@@ -251,6 +288,10 @@ class MagneticTower {
                            parthenon::MeshData<parthenon::Real> *md,
                            const parthenon::SimTime &tm) const;
 
+  // Get the region beyond which the magnetic field (and the mass if `with_mass`) added
+  // by the tower is negligible
+  CullingRegion GetCullingRegion(const JetCoords &jet_coords, const bool with_mass) const;
+
   friend parthenon::TaskStatus
   MagneticTowerResetPowerContribs(parthenon::StateDescriptor *hydro_pkg);
 
@@ -15,10 +15,56 @@
 #include <parameter_input.hpp>
 #include <parthenon/package.hpp>
 
+#include "cluster_gravity.hpp"
+#include "cluster_utils.hpp"
 #include "jet_coords.hpp"
 
 namespace cluster {
 
+/************************************************************
+ *  SNIA Feedback Object, for injecting SNIA feedback following the BCG density
+ *  over a fixed timestep into single cells
+ *    Lightweight object intended for inlined computation within kernels
+ ************************************************************/
+class SNIAFeedbackObj {
+ private:
+  // Energy and mass to inject per mass in the BCG
+  const parthenon::Real energy_per_bcg_mass_, mass_per_bcg_mass_;
+
+  // ClusterGravity object to calculate BCG density
+  const ClusterGravity bcg_gravity_;
+
+  const int nhydro_, nscalars_;
+
+ public:
+  SNIAFeedbackObj(const parthenon::Real energy_per_bcg_mass,
+                  const parthenon::Real mass_per_bcg_mass,
+                  const ClusterGravity bcg_gravity, const int nhydro, const int nscalars)
+      : energy_per_bcg_mass_(energy_per_bcg_mass), mass_per_bcg_mass_(mass_per_bcg_mass),
+        bcg_gravity_(bcg_gravity), nhydro_(nhydro), nscalars_(nscalars) {}
+
+  // Apply constant volumetric heating following the BCG density to the cell at x, y, z
+  template <typename EOS, typename View4D>
+  KOKKOS_INLINE_FUNCTION void
+  FeedbackSrcTermCell(const EOS &eos, View4D &cons, View4D &prim, const parthenon::Real x,
+                      const parthenon::Real y, const parthenon::Real z, const int k,
+                      const int j, const int i) const __attribute__((always_inline)) {
+    using parthenon::Real;
+
+    const Real r = sqrt(x * x + y * y + z * z);
+
+    const Real bcg_density = bcg_gravity_.rho_from_r(r);
+
+    const Real snia_energy_density = energy_per_bcg_mass_ * bcg_density;
+    const Real snia_mass_density = mass_per_bcg_mass_ * bcg_density;
+
+    cons(IEN, k, j, i) += snia_energy_density;
+    AddDensityToConsAtFixedVel(snia_mass_density, cons, prim, k, j, i);
+
+    eos.ConsToPrim(cons, prim, nhydro_, nscalars_, k, j, i);
+  }
+};
+
 /************************************************************
  *  AGNFeedback
  ************************************************************/
@@ -35,14 +81,15 @@ class SNIAFeedback {
 
   SNIAFeedback(parthenon::ParameterInput *pin, parthenon::StateDescriptor *hydro_pkg);
 
-  void FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
-                       const parthenon::Real beta_dt, const parthenon::SimTime &tm) const;
+  // Whether SNIA feedback is injected
+  bool IsActive() const {
+    return !disabled_ && (power_per_bcg_mass_ != 0 || mass_rate_per_bcg_mass_ != 0);
+  }
 
-  // Apply the feedback from SNIAe tied to the BCG density
-  template <typename EOS>
-  void FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
-                       const parthenon::Real beta_dt, const parthenon::SimTime &tm,
-                       const EOS &eos) const;
+  // Get the object to apply the feedback from SNIAe tied to the BCG density over beta_dt
+  // within a kernel
+  SNIAFeedbackObj GetFeedbackObj(parthenon::StateDescriptor *hydro_pkg,
+                                 const parthenon::Real beta_dt) const;
 };
 
 } // namespace cluster
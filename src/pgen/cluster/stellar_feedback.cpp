@@ -64,113 +64,18 @@ StellarFeedback::StellarFeedback(parthenon::ParameterInput *pin,
   hydro_pkg->AddParam<StellarFeedback>("stellar_feedback", *this);
 }
 
-void StellarFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
-                                      const parthenon::Real beta_dt,
-                                      const parthenon::SimTime &tm) const {
-  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-  auto fluid = hydro_pkg->Param<Fluid>("fluid");
-  if (fluid == Fluid::euler) {
-    FeedbackSrcTerm(md, beta_dt, tm, hydro_pkg->Param<AdiabaticHydroEOS>("eos"));
-  } else if (fluid == Fluid::glmmhd) {
-    FeedbackSrcTerm(md, beta_dt, tm, hydro_pkg->Param<AdiabaticGLMMHDEOS>("eos"));
-  } else {
-    PARTHENON_FAIL("StellarFeedback::FeedbackSrcTerm: Unknown EOS");
-  }
-}
-template <typename EOS>
-void StellarFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
-                                      const parthenon::Real beta_dt,
-                                      const parthenon::SimTime &tm,
-                                      const EOS &eos_) const {
-  using parthenon::IndexDomain;
-  using parthenon::IndexRange;
-  using parthenon::Real;
-
-  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-
-  if (disabled_) {
-    // No stellar feedback, return
-    return;
-  }
-
-  // Grab some necessary variables
-  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
-  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
-  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
-  const auto nhydro = hydro_pkg->Param<int>("nhydro");
-  const auto nscalars = hydro_pkg->Param<int>("nscalars");
-
-  // const auto gm1 = (hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0);
+StellarFeedbackObj
+StellarFeedback::GetFeedbackObj(parthenon::StateDescriptor *hydro_pkg) const {
   const auto units = hydro_pkg->Param<Units>("units");
   const auto mbar = hydro_pkg->Param<Real>("mu") * units.mh();
   const auto mbar_over_kb = hydro_pkg->Param<Real>("mbar_over_kb");
 
   const auto mass_to_energy = efficiency_ * SQR(units.speed_of_light());
-  const auto stellar_radius = stellar_radius_;
-  const auto exclusion_radius = exclusion_radius_;
-  const auto temperature_threshold = temperatue_threshold_;
-  const auto number_density_threshold = number_density_threshold_;
-
-  const auto eos = eos_;
-
-  ////////////////////////////////////////////////////////////////////////////////
-
-  Real stellar_mass = 0.0;
-
-  // Constant volumetric heating, reduce mass removed
-  Kokkos::parallel_reduce(
-      "StellarFeedback::FeedbackSrcTerm",
-      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
-          DevExecSpace(), {0, kb.s, jb.s, ib.s},
-          {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
-          {1, 1, 1, ib.e + 1 - ib.s}),
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i,
-                    Real &stellar_mass_team) {
-        auto &cons = cons_pack(b);
-        auto &prim = prim_pack(b);
-        const auto &coords = cons_pack.GetCoords(b);
-
-        const auto x = coords.Xc<1>(i);
-        const auto y = coords.Xc<2>(j);
-        const auto z = coords.Xc<3>(k);
-
-        const auto r = sqrt(x * x + y * y + z * z);
-        if (r > stellar_radius || r <= exclusion_radius) {
-          return;
-        }
-
-        auto number_density = prim(IDN, k, j, i) / mbar;
-        if (number_density < number_density_threshold) {
-          return;
-        }
-
-        auto temp = mbar_over_kb * prim(IPR, k, j, i) / prim(IDN, k, j, i);
-        if (temp > temperature_threshold) {
-          return;
-        }
-
-        // All conditions to convert mass to energy are met
-        const auto cell_delta_rho = number_density_threshold * mbar - prim(IDN, k, j, i);
-        stellar_mass_team -= cell_delta_rho * coords.CellVolume(k, j, i);
-
-        // First remove density at fixed temperature
-        AddDensityToConsAtFixedVelTemp(cell_delta_rho, cons, prim, eos.GetGamma(), k, j,
-                                       i);
-        //  Then add thermal energy
-        const auto cell_delta_energy_density = -mass_to_energy * cell_delta_rho;
-        PARTHENON_REQUIRE(
-            cell_delta_energy_density > 0.0,
-            "Sanity check failed. Added thermal energy should be positive.");
-        cons(IEN, k, j, i) += cell_delta_energy_density;
 
-        // Update prims
-        eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
-      },
-      stellar_mass);
-  hydro_pkg->UpdateParam(
-      "stellar_mass", stellar_mass + hydro_pkg->Param<parthenon::Real>("stellar_mass"));
+  return StellarFeedbackObj(stellar_radius_, exclusion_radius_, temperatue_threshold_,
+                            number_density_threshold_, mbar, mbar_over_kb,
+                            mass_to_energy, hydro_pkg->Param<int>("nhydro"),
+                            hydro_pkg->Param<int>("nscalars"));
 }
 
 } // namespace cluster
@@ -15,10 +15,81 @@
 #include <parameter_input.hpp>
 #include <parthenon/package.hpp>
 
+#include "cluster_utils.hpp"
 #include "jet_coords.hpp"
 
 namespace cluster {
 
+/************************************************************
+ *  Stellar Feedback Object, for converting cold, dense gas to thermal energy
+ *  in single cells
+ *    Lightweight object intended for inlined computation within kernels
+ ************************************************************/
+class StellarFeedbackObj {
+ private:
+  const parthenon::Real stellar_radius_, exclusion_radius_;
+  const parthenon::Real temperature_threshold_, number_density_threshold_;
+  const parthenon::Real mbar_, mbar_over_kb_, mass_to_energy_;
+
+  const int nhydro_, nscalars_;
+
+ public:
+  StellarFeedbackObj(const parthenon::Real stellar_radius,
+                     const parthenon::Real exclusion_radius,
+                     const parthenon::Real temperature_threshold,
+                     const parthenon::Real number_density_threshold,
+                     const parthenon::Real mbar, const parthenon::Real mbar_over_kb,
+                     const parthenon::Real mass_to_energy, const int nhydro,
+                     const int nscalars)
+      : stellar_radius_(stellar_radius), exclusion_radius_(exclusion_radius),
+        temperature_threshold_(temperature_threshold),
+        number_density_threshold_(number_density_threshold), mbar_(mbar),
+        mbar_over_kb_(mbar_over_kb), mass_to_energy_(mass_to_energy), nhydro_(nhydro),
+        nscalars_(nscalars) {}
+
+  // Inactive stellar feedback
+  StellarFeedbackObj() : StellarFeedbackObj(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0) {}
+
+  // Convert gas in the cell at x, y, z to thermal energy and return the removed mass
+  template <typename EOS, typename View4D>
+  KOKKOS_INLINE_FUNCTION parthenon::Real
+  FeedbackSrcTermCell(const EOS &eos, View4D &cons, View4D &prim, const parthenon::Real x,
+                      const parthenon::Real y, const parthenon::Real z,
+                      const parthenon::Real cell_volume, const int k, const int j,
+                      const int i) const __attribute__((always_inline)) {
+    const auto r = sqrt(x * x + y * y + z * z);
+    if (r > stellar_radius_ || r <= exclusion_radius_) {
+      return 0.0;
+    }
+
+    auto number_density = prim(IDN, k, j, i) / mbar_;
+    if (number_density < number_density_threshold_) {
+      return 0.0;
+    }
+
+    auto temp = mbar_over_kb_ * prim(IPR, k, j, i) / prim(IDN, k, j, i);
+    if (temp > temperature_threshold_) {
+      return 0.0;
+    }
+
+    // All conditions to convert mass to energy are met
+    const auto cell_delta_rho = number_density_threshold_ * mbar_ - prim(IDN, k, j, i);
+
+    // First remove density at fixed temperature
+    AddDensityToConsAtFixedVelTemp(cell_delta_rho, cons, prim, eos.GetGamma(), k, j, i);
+    //  Then add thermal energy
+    const auto cell_delta_energy_density = -mass_to_energy_ * cell_delta_rho;
+    PARTHENON_REQUIRE(cell_delta_energy_density > 0.0,
+                      "Sanity check failed. Added thermal energy should be positive.");
+    cons(IEN, k, j, i) += cell_delta_energy_density;
+
+    // Update prims
+    eos.ConsToPrim(cons, prim, nhydro_, nscalars_, k, j, i);
+
+    return -cell_delta_rho * cell_volume;
+  }
+};
+
 /************************************************************
  *  StellarFeedback
  ************************************************************/
@@ -36,14 +107,15 @@ class StellarFeedback {
  public:
   StellarFeedback(parthenon::ParameterInput *pin, parthenon::StateDescriptor *hydro_pkg);
 
-  void FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
-                       const parthenon::Real beta_dt, const parthenon::SimTime &tm) const;
+  // Whether stellar feedback is enabled
+  bool IsActive() const { return !disabled_; }
+
+  // Radius within which stellar feedback is applied
+  parthenon::Real GetStellarRadius() const { return stellar_radius_; }
 
-  // Apply stellar feedback following cold gas density above a density threshold
-  template <typename EOS>
-  void FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
-                       const parthenon::Real beta_dt, const parthenon::SimTime &tm,
-                       const EOS &eos) const;
+  // Get the object to apply stellar feedback following cold gas density above a density
+  // threshold within a kernel
+  StellarFeedbackObj GetFeedbackObj(parthenon::StateDescriptor *hydro_pkg) const;
 };
 
 } // namespace cluster
@@ -23,8 +23,10 @@
 #include <random>
 #include <sstream>
 #include <string>
+#include <vector>
 
 // AthenaPK headers
+#include "../hydro/step_reductions.hpp"
 #include "../main.hpp"
 #include "../units.hpp"
 #include "../utils/few_modes_ft.hpp"
@@ -40,6 +42,14 @@ using utils::few_modes_ft::FewModesFT;
 // we'll use this enum to identify the various vars.
 enum class HstQuan { Ms, Ma, pb };
 
+// Global sums (stored as Params) used for the driving, i.e., the total mass, the mass
+// weighted acceleration, and the volume weighted acceleration and acceleration squared.
+const std::vector<std::string> driving_sum_names = {
+    "turbulence/mass_sum",   "turbulence/mom_sum_0",  "turbulence/mom_sum_1",
+    "turbulence/mom_sum_2",  "turbulence/acc_sum_0",  "turbulence/acc_sum_1",
+    "turbulence/acc_sum_2",  "turbulence/acc2_sum_0", "turbulence/acc2_sum_1",
+    "turbulence/acc2_sum_2"};
+
 // Compute the local sum of either the sonic Mach number,
 // alfvenic Mach number, or plasma beta as specified by `hst_quan`.
 template <HstQuan hst_quan>
@@ -97,6 +107,148 @@ Real TurbulenceHst(MeshData<Real> *md) {
   return sum;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus DrivingReset(StateDescriptor *hydro_pkg, const SimTime &tm)
+//  \brief Evolve the forcing spectrum (once per cycle) and reset the global sums
+
+parthenon::TaskStatus DrivingReset(parthenon::StateDescriptor *hydro_pkg,
+                                   const parthenon::SimTime &tm) {
+  // Must be mutable so the internal RNG state is updated
+  auto *few_modes_ft = hydro_pkg->MutableParam<FewModesFT>("turbulence/few_modes_ft");
+  few_modes_ft->EvolveSpectrum(tm.dt);
+
+  for (const auto &name : driving_sum_names) {
+    hydro_pkg->UpdateParam(name, 0.0);
+  }
+  return parthenon::TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus DrivingReduce(MeshData<Real> *md, const SimTime &tm)
+//  \brief Generate acceleration field of a partition and (locally) reduce the sums
+//  required for removing the mean momentum and for the normalization.
+
+parthenon::TaskStatus DrivingReduce(MeshData<Real> *md,
+                                    const parthenon::SimTime & /*tm*/) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  auto *few_modes_ft = hydro_pkg->MutableParam<FewModesFT>("turbulence/few_modes_ft");
+  few_modes_ft->InverseTransform(md, "acc");
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  auto cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  auto acc_pack = md->PackVariables(std::vector<std::string>{"acc"});
+
+  // Given that the (volume weighted) mean of acc^2 after removing the mean momentum is
+  // sum_n (<acc_n^2> - 2 mean_n <acc_n> + mean_n^2), all required sums can be calculated
+  // in a single pass before the global reduction.
+  Kokkos::Array<Real, 10> sums{{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}};
+  Kokkos::parallel_reduce(
+      "forcing: calc sums",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+          {0, kb.s, jb.s, ib.s}, {cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+          {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lmass_sum,
+                    Real &lim1_sum, Real &lim2_sum, Real &lim3_sum, Real &lacc1_sum,
+                    Real &lacc2_sum, Real &lacc3_sum, Real &lacc1_sq_sum,
+                    Real &lacc2_sq_sum, Real &lacc3_sq_sum) {
+        const auto &coords = cons_pack.GetCoords(b);
+        const auto vol = coords.CellVolume(k, j, i);
+        const auto den = cons_pack(b, IDN, k, j, i);
+        const auto acc1 = acc_pack(b, 0, k, j, i);
+        const auto acc2 = acc_pack(b, 1, k, j, i);
+        const auto acc3 = acc_pack(b, 2, k, j, i);
+        lmass_sum += den * vol;
+        lim1_sum += den * acc1 * vol;
+        lim2_sum += den * acc2 * vol;
+        lim3_sum += den * acc3 * vol;
+        lacc1_sum += acc1 * vol;
+        lacc2_sum += acc2 * vol;
+        lacc3_sum += acc3 * vol;
+        lacc1_sq_sum += SQR(acc1) * vol;
+        lacc2_sq_sum += SQR(acc2) * vol;
+        lacc3_sq_sum += SQR(acc3) * vol;
+      },
+      sums[0], sums[1], sums[2], sums[3], sums[4], sums[5], sums[6], sums[7], sums[8],
+      sums[9]);
+
+  // Partitions are processed sequentially so the sums can be accumulated in the Params
+  for (int q = 0; q < static_cast<int>(driving_sum_names.size()); q++) {
+    hydro_pkg->UpdateParam(driving_sum_names[q],
+                           hydro_pkg->Param<Real>(driving_sum_names[q]) + sums[q]);
+  }
+  return parthenon::TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus DrivingApply(MeshData<Real> *md, const SimTime &tm)
+//  \brief Remove mean momentum, normalize and add the acceleration to the hydro
+//  variables of a partition using the globally reduced sums
+
+parthenon::TaskStatus DrivingApply(MeshData<Real> *md, const parthenon::SimTime &tm) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  const auto dt = tm.dt;
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  auto cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  auto acc_pack = md->PackVariables(std::vector<std::string>{"acc"});
+
+  const auto Lx =
+      pmb->pmy_mesh->mesh_size.xmax(X1DIR) - pmb->pmy_mesh->mesh_size.xmin(X1DIR);
+  const auto Ly =
+      pmb->pmy_mesh->mesh_size.xmax(X2DIR) - pmb->pmy_mesh->mesh_size.xmin(X2DIR);
+  const auto Lz =
+      pmb->pmy_mesh->mesh_size.xmax(X3DIR) - pmb->pmy_mesh->mesh_size.xmin(X3DIR);
+  const auto vol = Lx * Ly * Lz;
+
+  const auto mass_sum = hydro_pkg->Param<Real>(driving_sum_names[0]);
+  Kokkos::Array<Real, 3> mean;
+  Real ampl_sum = 0.0;
+  for (int n = 0; n < 3; n++) {
+    mean[n] = hydro_pkg->Param<Real>(driving_sum_names[1 + n]) / mass_sum;
+    ampl_sum += hydro_pkg->Param<Real>(driving_sum_names[7 + n]) -
+                2.0 * mean[n] * hydro_pkg->Param<Real>(driving_sum_names[4 + n]) +
+                SQR(mean[n]) * vol;
+  }
+  const auto accel_rms = hydro_pkg->Param<Real>("turbulence/accel_rms");
+  auto norm = accel_rms / std::sqrt(ampl_sum / vol);
+
+  pmb->par_for(
+      "apply momemtum perturb", 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        auto &cons = cons_pack(b);
+        auto &acc = acc_pack(b);
+
+        auto &acc_0 = acc(0, k, j, i);
+        auto &acc_1 = acc(1, k, j, i);
+        auto &acc_2 = acc(2, k, j, i);
+
+        // remove mean momentum and normalize accel field here so that the actual values
+        // are used in the output
+        acc_0 = (acc_0 - mean[0]) * norm;
+        acc_1 = (acc_1 - mean[1]) * norm;
+        acc_2 = (acc_2 - mean[2]) * norm;
+
+        Real qa = dt * cons(IDN, k, j, i);
+        cons(IEN, k, j, i) +=
+            (cons(IM1, k, j, i) * dt * acc_0 + cons(IM2, k, j, i) * dt * acc_1 +
+             cons(IM3, k, j, i) * dt * acc_2 +
+             (SQR(acc_0) + SQR(acc_1) + SQR(acc_2)) * qa * qa / (2 * cons(IDN, k, j, i)));
+
+        cons(IM1, k, j, i) += qa * acc_0;
+        cons(IM2, k, j, i) += qa * acc_1;
+        cons(IM3, k, j, i) += qa * acc_2;
+      });
+  return parthenon::TaskStatus::complete;
+}
+
 void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg) {
   // Step 1. Enlist history output information
   auto hst_vars = pkg->Param<parthenon::HstVar_list>(parthenon::hist_param_key);
@@ -122,9 +274,6 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg
              std::vector<int>({3}));
   pkg->AddField("acc", m);
 
-  auto num_modes =
-      pin->GetInteger("problem/turbulence", "num_modes"); // number of wavemodes
-
   uint32_t rseed =
       pin->GetOrAddInteger("problem/turbulence", "rseed", -1); // seed for random number.
   pkg->AddParam<>("turbulence/rseed", rseed);
@@ -144,22 +293,75 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg
   Real sol_weight = pin->GetReal("problem/turbulence", "sol_weight"); // solenoidal weight
   pkg->AddParam<>("turbulence/sol_weight", sol_weight);
 
-  // list of wavenumber vectors
-  auto k_vec = ParArray2D<Real>("k_vec", 3, num_modes);
-  auto k_vec_host = Kokkos::create_mirror_view(k_vec);
-  for (int j = 0; j < 3; j++) {
-    for (int i = 1; i <= num_modes; i++) {
-      k_vec_host(j, i - 1) =
-          pin->GetInteger("modes", "k_" + std::to_string(i) + "_" + std::to_string(j));
+  // Driving either with the modes explicitly listed in the input file ("few_modes") or
+  // with all (integer) modes in the band of the forcing spectrum ("band_modes"). Both use
+  // the same explicit inverse transform of the listed modes.
+  const auto driver = pin->GetOrAddString("problem/turbulence", "driver", "few_modes");
+  int num_modes;          // number of wavemodes
+  ParArray2D<Real> k_vec; // list of wavenumber vectors
+  if (driver == "few_modes") {
+    num_modes = pin->GetInteger("problem/turbulence", "num_modes");
+    k_vec = ParArray2D<Real>("k_vec", 3, num_modes);
+    auto k_vec_host = Kokkos::create_mirror_view(k_vec);
+    for (int j = 0; j < 3; j++) {
+      for (int i = 1; i <= num_modes; i++) {
+        k_vec_host(j, i - 1) =
+            pin->GetInteger("modes", "k_" + std::to_string(i) + "_" + std::to_string(j));
+      }
     }
+    Kokkos::deep_copy(k_vec, k_vec_host);
+  } else if (driver == "band_modes") {
+    PARTHENON_REQUIRE_THROWS(k_peak > 0.0,
+                             "problem/turbulence/kpeak must be > 0 for band_modes "
+                             "driving.");
+    const auto k_low = pin->GetOrAddReal("problem/turbulence", "k_low", 0.5 * k_peak);
+    const auto k_high = pin->GetOrAddReal("problem/turbulence", "k_high", 2.0 * k_peak);
+    k_vec = utils::few_modes_ft::MakeBandModes(k_peak, k_low, k_high);
+    num_modes = k_vec.extent_int(1);
+    PARTHENON_REQUIRE_THROWS(num_modes > 0,
+                             "No modes with power in the forcing spectrum between "
+                             "problem/turbulence/k_low and k_high.");
+    if (parthenon::Globals::my_rank == 0) {
+      std::cout << "Turbulence driving using all " << num_modes
+                << " modes in the band of the forcing spectrum." << std::endl;
+      // Only the final sum in x1-direction scales with the number of distinct k_x. The
+      // partial sums along x3 and the phase table (2 * num_modes * nx3 values per block)
+      // scale with the number of modes and dominate once it exceeds the cells in a
+      // x1-x2-plane of a block.
+      const auto nx1 = pin->GetInteger("parthenon/meshblock", "nx1");
+      const auto nx2 = pin->GetInteger("parthenon/meshblock", "nx2");
+      if (num_modes > nx1 * nx2) {
+        PARTHENON_WARN("The number of modes of the band_modes turbulence driving "
+                       "exceeds the number of cells in a x1-x2-plane of a meshblock so "
+                       "that the cost (and memory) of the driving is dominated by the "
+                       "per mode work. Consider reducing problem/turbulence/k_high "
+                       "(or kpeak) or using larger meshblocks.\n");
+      }
+    }
+  } else {
+    PARTHENON_THROW("Unknown problem/turbulence/driver \"" + driver +
+                    "\". Options are: few_modes, band_modes");
   }
-  Kokkos::deep_copy(k_vec, k_vec_host);
 
   auto few_modes_ft = FewModesFT(pin, pkg, "turbulence", num_modes, k_vec, k_peak,
                                  sol_weight, t_corr, rseed);
   // object must be mutable to update the internal state of the RNG
   pkg->AddParam<>("turbulence/few_modes_ft", few_modes_ft, true);
 
+  // Driving is a first order split source term that requires global sums for removing
+  // the mean momentum and for the normalization. These are calculated per partition
+  // (after the acceleration field has been generated) and reduced globally before the
+  // acceleration is applied to each partition, see `Hydro::StepReductions`.
+  auto *split_source_reductions =
+      pkg->MutableParam<Hydro::StepReductions>("split_source_reductions");
+  for (const auto &name : driving_sum_names) {
+    pkg->AddParam<Real>(name, 0.0, true);
+    split_source_reductions->AddQuantity(name, Hydro::ReductionOp::sum);
+  }
+  split_source_reductions->AddReset(DrivingReset);
+  split_source_reductions->AddLocalReduction(DrivingReduce);
+  split_source_reductions->AddPartitionFinalize(DrivingApply);
+
   // Check if this is is a restart and restore previous state
   if (pin->DoesParameterExist("problem/turbulence", "accel_hat_0_0_r")) {
     // Need to extract mutable object from Params here as the original few_modes_ft above
@@ -230,6 +432,14 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
   // First initialize B field as we need to normalize it
   Real b_norm = 0.0;
   if (fluid == Fluid::glmmhd) {
+    // The normalization requires a collective MPI reduction over all blocks but this
+    // function is called once per partition (with a potentially different number of
+    // partitions per rank).
+    const auto pack_size = pin->GetInteger("parthenon/mesh", "pack_size");
+    PARTHENON_REQUIRE_THROWS(pack_size == -1,
+                             "Initializing the turbulence problem with magnetic fields "
+                             "requires parthenon/mesh/pack_size=-1 because of the global "
+                             "normalization. Other pack sizes can be used on restart.")
     parthenon::ParArray5D<Real> a("vector potential", num_blocks, 3,
                                   pmb->cellbounds.ncellsk(IndexDomain::entire),
                                   pmb->cellbounds.ncellsj(IndexDomain::entire),
@@ -335,121 +545,6 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
       });
 }
 
-//----------------------------------------------------------------------------------------
-//! \fn void Generate()
-//  \brief Generate velocity pertubation.
-
-void Generate(MeshData<Real> *md, Real dt) {
-  auto pmb = md->GetBlockData(0)->GetBlockPointer();
-  auto hydro_pkg = pmb->packages.Get("Hydro");
-  // Must be mutable so the internal RNG state is updated
-  auto *few_modes_ft = hydro_pkg->MutableParam<FewModesFT>("turbulence/few_modes_ft");
-  few_modes_ft->Generate(md, dt, "acc");
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn void Perturb(Real dt)
-//  \brief Add velocity perturbation to the hydro variables
-
-void Perturb(MeshData<Real> *md, const Real dt) {
-  auto pmb = md->GetBlockData(0)->GetBlockPointer();
-  auto hydro_pkg = pmb->packages.Get("Hydro");
-
-  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
-  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
-
-  auto cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
-  auto acc_pack = md->PackVariables(std::vector<std::string>{"acc"});
-
-  Kokkos::Array<Real, 4> sums{{0.0, 0.0, 0.0, 0.0}};
-  Kokkos::parallel_reduce(
-      "forcing: calc mean momenum",
-      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
-          {0, kb.s, jb.s, ib.s}, {cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
-          {1, 1, 1, ib.e + 1 - ib.s}),
-      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lmass_sum,
-                    Real &lim1_sum, Real &lim2_sum, Real &lim3_sum) {
-        const auto &coords = cons_pack.GetCoords(b);
-        auto den = cons_pack(b, IDN, k, j, i);
-        lmass_sum += den * coords.CellVolume(k, j, i);
-        lim1_sum += den * acc_pack(b, 0, k, j, i) * coords.CellVolume(k, j, i);
-        lim2_sum += den * acc_pack(b, 1, k, j, i) * coords.CellVolume(k, j, i);
-        lim3_sum += den * acc_pack(b, 2, k, j, i) * coords.CellVolume(k, j, i);
-      },
-      sums[0], sums[1], sums[2], sums[3]);
-
-#ifdef MPI_PARALLEL
-  // Sum the perturbations over all processors
-  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, sums.data(), 4, MPI_PARTHENON_REAL,
-                                    MPI_SUM, MPI_COMM_WORLD));
-#endif // MPI_PARALLEL
-
-  pmb->par_reduce(
-      "forcing: remove mean momentum and calc norm", 0, acc_pack.GetDim(5) - 1, 0, 2,
-      kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int b, const int n, const int k, const int j, const int i,
-                    Real &lampl_sum) {
-        const auto &coords = acc_pack.GetCoords(b);
-        acc_pack(b, n, k, j, i) -= sums[n + 1] / sums[0];
-        lampl_sum += SQR(acc_pack(b, n, k, j, i)) * coords.CellVolume(k, j, i);
-      },
-      sums[0]);
-
-#ifdef MPI_PARALLEL
-  // Sum the perturbations over all processors
-  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, sums.data(), 1, MPI_PARTHENON_REAL,
-                                    MPI_SUM, MPI_COMM_WORLD));
-#endif // MPI_PARALLEL
-
-  const auto Lx =
-      pmb->pmy_mesh->mesh_size.xmax(X1DIR) - pmb->pmy_mesh->mesh_size.xmin(X1DIR);
-  const auto Ly =
-      pmb->pmy_mesh->mesh_size.xmax(X2DIR) - pmb->pmy_mesh->mesh_size.xmin(X2DIR);
-  const auto Lz =
-      pmb->pmy_mesh->mesh_size.xmax(X3DIR) - pmb->pmy_mesh->mesh_size.xmin(X3DIR);
-  const auto accel_rms = hydro_pkg->Param<Real>("turbulence/accel_rms");
-  auto norm = accel_rms / std::sqrt(sums[0] / (Lx * Ly * Lz));
-
-  pmb->par_for(
-      "apply momemtum perturb", 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
-        auto &cons = cons_pack(b);
-        auto &acc = acc_pack(b);
-
-        auto &acc_0 = acc(0, k, j, i);
-        auto &acc_1 = acc(1, k, j, i);
-        auto &acc_2 = acc(2, k, j, i);
-
-        // normalizing accel field here so that the actual values are used in the output
-        acc_0 *= norm;
-        acc_1 *= norm;
-        acc_2 *= norm;
-
-        Real qa = dt * cons(IDN, k, j, i);
-        cons(IEN, k, j, i) +=
-            (cons(IM1, k, j, i) * dt * acc_0 + cons(IM2, k, j, i) * dt * acc_1 +
-             cons(IM3, k, j, i) * dt * acc_2 +
-             (SQR(acc_0) + SQR(acc_1) + SQR(acc_2)) * qa * qa / (2 * cons(IDN, k, j, i)));
-
-        cons(IM1, k, j, i) += qa * acc_0;
-        cons(IM2, k, j, i) += qa * acc_1;
-        cons(IM3, k, j, i) += qa * acc_2;
-      });
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn void FewModesTurbulenceDriver::Driving(void)
-//  \brief Generate and Perturb the velocity field
-
-void Driving(MeshData<Real> *md, const parthenon::SimTime &tm, const Real dt) {
-  // evolve forcing
-  Generate(md, dt);
-
-  // actually drive turbulence
-  Perturb(md, dt);
-}
-
 void UserWorkBeforeOutput(MeshBlock *pmb, ParameterInput *pin,
                           const parthenon::SimTime & /*tm*/) {
   auto hydro_pkg = pmb->packages.Get("Hydro");
@@ -86,10 +86,12 @@ void LimO3(const Real &q_im1, const Real &q_i, const Real &q_ip1, Real &ql_ip1,
 //  have been cached for the appropriate k, j (and plus 1) values. Thus, in x1dir ql needs
 //  to be offset by i+1 but for the other direction the offset has been set outside in the
 //  cached stencil.
-template <Reconstruction recon, int XNDIR>
+//  `q` is either a VariablePack or any other (n,k,j,i)-indexable object providing
+//  GetDim(4), e.g., the cached tile used in the fused flux kernel.
+template <Reconstruction recon, int XNDIR, typename QPack>
 KOKKOS_INLINE_FUNCTION typename std::enable_if<recon == Reconstruction::limo3, void>::type
 Reconstruct(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-            const int iu, const parthenon::VariablePack<Real> &q, ScratchPad2D<Real> &ql,
+            const int iu, const QPack &q, ScratchPad2D<Real> &ql,
             ScratchPad2D<Real> &qr) {
   const auto nvar = q.GetDim(4);
   for (auto n = 0; n < nvar; ++n) {
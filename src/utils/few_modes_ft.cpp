@@ -8,7 +8,10 @@
 //  \brief Helper functions for an inverse (explicit complex to real) FT
 
 // C++ headers
+#include <array>
+#include <map>
 #include <random>
+#include <vector>
 
 // Parthenon headers
 #include "basic_types.hpp"
@@ -33,12 +36,6 @@ FewModesFT::FewModesFT(parthenon::ParameterInput *pin, parthenon::StateDescripto
     : prefix_(prefix), num_modes_(num_modes), k_vec_(k_vec), k_peak_(k_peak),
       t_corr_(t_corr), fill_ghosts_(fill_ghosts) {
 
-  if ((num_modes > 100) && (parthenon::Globals::my_rank == 0)) {
-    std::cout << "### WARNING using more than 100 explicit modes will significantly "
-              << "increase the runtime." << std::endl
-              << "If many modes are required in the transform field consider using "
-              << "the driving mechanism based on full FFTs." << std::endl;
-  }
   // Ensure that all all wavevectors can be represented on the root grid
   const auto gnx1 = pin->GetInteger("parthenon/mesh", "nx1");
   const auto gnx2 = pin->GetInteger("parthenon/mesh", "nx2");
@@ -52,18 +49,69 @@ FewModesFT::FewModesFT(parthenon::ParameterInput *pin, parthenon::StateDescripto
     PARTHENON_REQUIRE(std::abs(k_vec_host(2, i)) <= gnx3 / 2, "k_vec x3 mode too large");
   }
 
+  // Group modes by (k_x, k_y) and the pairs by k_x for the factorized inverse transform
+  std::map<Real, std::map<Real, std::vector<int>>> kx_kxky_modes;
+  for (int m = 0; m < num_modes; m++) {
+    kx_kxky_modes[k_vec_host(0, m)][k_vec_host(1, m)].push_back(m);
+  }
+  std::vector<int> kx_rep, kx_kxky_offsets, kxky_rep, kxky_mode_offsets, kxky_modes;
+  for (const auto &[kx, kxky_modes_of_kx] : kx_kxky_modes) {
+    kx_rep.push_back(kxky_modes_of_kx.begin()->second.front());
+    kx_kxky_offsets.push_back(kxky_rep.size());
+    for (const auto &[ky, modes] : kxky_modes_of_kx) {
+      kxky_rep.push_back(modes.front());
+      kxky_mode_offsets.push_back(kxky_modes.size());
+      kxky_modes.insert(kxky_modes.end(), modes.begin(), modes.end());
+    }
+  }
+  kx_kxky_offsets.push_back(kxky_rep.size());
+  kxky_mode_offsets.push_back(kxky_modes.size());
+  num_kx_ = kx_rep.size();
+  num_kxky_ = kxky_rep.size();
+
+  auto to_device = [&](const std::vector<int> &vec, const std::string &name) {
+    auto arr = ParArray1D<int>(prefix + name, vec.size());
+    auto arr_h = Kokkos::create_mirror_view(arr);
+    for (size_t n = 0; n < vec.size(); n++) {
+      arr_h(n) = vec[n];
+    }
+    Kokkos::deep_copy(arr, arr_h);
+    return arr;
+  };
+  kx_rep_ = to_device(kx_rep, "_kx_rep");
+  kx_kxky_offsets_ = to_device(kx_kxky_offsets, "_kx_kxky_offsets");
+  kxky_rep_ = to_device(kxky_rep, "_kxky_rep");
+  kxky_mode_offsets_ = to_device(kxky_mode_offsets, "_kxky_mode_offsets");
+  kxky_modes_ = to_device(kxky_modes, "_kxky_modes");
+
   const auto nx1 = pin->GetInteger("parthenon/meshblock", "nx1");
   const auto nx2 = pin->GetInteger("parthenon/meshblock", "nx2");
   const auto nx3 = pin->GetInteger("parthenon/meshblock", "nx3");
   const auto ng_tot = fill_ghosts_ ? 2 * parthenon::Globals::nghost : 0;
+
+  // Number of complex multiply-adds per cell of the factorized inverse transform (per
+  // component). The unfactorized transform required one per mode, for which more than
+  // 100 modes were found to significantly increase the runtime.
+  const auto work_per_cell = num_kx_ + static_cast<Real>(num_kxky_) / nx1 +
+                             static_cast<Real>(num_modes) / (nx1 * nx2);
+  if ((work_per_cell > 100.0) && (parthenon::Globals::my_rank == 0)) {
+    std::cout << "### WARNING the explicit modes (with " << num_kx_
+              << " distinct k_x) will significantly increase the runtime." << std::endl
+              << "If many modes are required in the transform field consider using "
+              << "the driving mechanism based on full FFTs." << std::endl;
+  }
+  // Phase tables (real and imaginary part) of the factorized inverse transform in the
+  // order in which they are accessed, i.e., per distinct k_x along x, per (k_x, k_y) pair
+  // along y, and per mode (sorted by pair) along z. The tables are only recalculated
+  // when blocks are created (i.e., initially and on remeshing) in SetPhases.
   auto m = Metadata({Metadata::None, Metadata::Derived, Metadata::OneCopy},
-                    std::vector<int>({2, num_modes, nx1 + ng_tot}), prefix + "_phases_i");
+                    std::vector<int>({nx1 + ng_tot, num_kx_, 2}), prefix + "_phases_i");
   pkg->AddField(prefix + "_phases_i", m);
   m = Metadata({Metadata::None, Metadata::Derived, Metadata::OneCopy},
-               std::vector<int>({2, num_modes, nx2 + ng_tot}), prefix + "_phases_j");
+               std::vector<int>({num_kxky_, nx2 + ng_tot, 2}), prefix + "_phases_j");
   pkg->AddField(prefix + "_phases_j", m);
   m = Metadata({Metadata::None, Metadata::Derived, Metadata::OneCopy},
-               std::vector<int>({2, num_modes, nx3 + ng_tot}), prefix + "_phases_k");
+               std::vector<int>({num_modes, nx3 + ng_tot, 2}), prefix + "_phases_k");
   pkg->AddField(prefix + "_phases_k", m);
 
   // Variable (e.g., acceleration field for turbulence driver) in Fourier space using
@@ -88,21 +136,6 @@ void FewModesFT::SetPhases(MeshBlock *pmb, ParameterInput *pin) {
   auto pm = pmb->pmy_mesh;
   auto hydro_pkg = pmb->packages.Get("Hydro");
 
-  // The following restriction could technically be lifted if the turbulence driver is
-  // directly embedded in the hydro driver rather than a user defined source as well as
-  // fixing the pack_size=-1 when using the Mesh- (not MeshBlock-)based problem generator.
-  // The restriction stems from requiring a collective MPI comm to normalize the
-  // acceleration and magnetic field, respectively. Note, that the restriction does not
-  // apply here, but for the ProblemGenerator() and Driving() function below. The check is
-  // just added here for convenience as this function is called during problem
-  // initializtion. From my (pgrete) point of view, it's currently cleaner to keep things
-  // separate and not touch the main driver at the expense of using one pack per rank --
-  // which is typically fastest on devices anyway.
-  const auto pack_size = pin->GetInteger("parthenon/mesh", "pack_size");
-  PARTHENON_REQUIRE_THROWS(pack_size == -1,
-                           "Few modes FT currently needs parthenon/mesh/pack_size=-1 "
-                           "to work because of global reductions.")
-
   const auto Lx1 = pm->mesh_size.xmax(X1DIR) - pm->mesh_size.xmin(X1DIR);
   const auto Lx2 = pm->mesh_size.xmax(X2DIR) - pm->mesh_size.xmin(X2DIR);
   const auto Lx3 = pm->mesh_size.xmax(X3DIR) - pm->mesh_size.xmin(X3DIR);
@@ -135,8 +168,10 @@ void FewModesFT::SetPhases(MeshBlock *pmb, ParameterInput *pin) {
   const auto gks = loc.lx3() * pmb->block_size.nx(X3DIR);
 
   // make local ref to capure in lambda
-  const auto num_modes = num_modes_;
   auto &k_vec = k_vec_;
+  const auto &kx_rep = kx_rep_;
+  const auto &kxky_rep = kxky_rep_;
+  const auto &kxky_modes = kxky_modes_;
 
   Complex I(0.0, 1.0);
 
@@ -147,57 +182,51 @@ void FewModesFT::SetPhases(MeshBlock *pmb, ParameterInput *pin) {
 
   const auto ng = fill_ghosts_ ? parthenon::Globals::nghost : 0;
   pmb->par_for(
-      "FMFT: calc phases_i", 0, nx1 - 1 + 2 * ng, KOKKOS_LAMBDA(int i) {
+      "FMFT: calc phases_i", 0, num_kx_ - 1, 0, nx1 - 1 + 2 * ng,
+      KOKKOS_LAMBDA(const int g, const int i) {
+        const int m = kx_rep(g);
         Real gi = static_cast<Real>((i + gis - ng) % static_cast<int>(gnx1));
-        Real w_kx;
-        Complex phase;
-
-        for (int m = 0; m < num_modes; m++) {
-          w_kx = k_vec(0, m) * 2. * M_PI / static_cast<Real>(gnx1);
-          // adjust phase factor to Complex->Real IFT: u_hat*(k) = u_hat(-k)
-          if (k_vec(0, m) == 0.0) {
-            phase = 0.5 * Kokkos::exp(I * w_kx * gi);
-          } else {
-            phase = Kokkos::exp(I * w_kx * gi);
-          }
-          phases_i(i, m, 0) = phase.real();
-          phases_i(i, m, 1) = phase.imag();
+        Real w_kx = k_vec(0, m) * 2. * M_PI / static_cast<Real>(gnx1);
+        // adjust phase factor to Complex->Real IFT: u_hat*(k) = u_hat(-k), i.e., the
+        // real part of the sum over all modes with k_x > 0 is taken twice
+        Complex phase = Kokkos::exp(I * w_kx * gi);
+        if (k_vec(0, m) != 0.0) {
+          phase *= 2.0;
         }
+        phases_i(0, g, i) = phase.real();
+        phases_i(1, g, i) = phase.imag();
       });
 
   pmb->par_for(
-      "FMFT: calc phases_j", 0, nx2 - 1 + 2 * ng, KOKKOS_LAMBDA(int j) {
+      "FMFT: calc phases_j", 0, nx2 - 1 + 2 * ng, 0, num_kxky_ - 1,
+      KOKKOS_LAMBDA(const int j, const int p) {
+        const int m = kxky_rep(p);
         Real gj = static_cast<Real>((j + gjs - ng) % static_cast<int>(gnx2));
-        Real w_ky;
-        Complex phase;
-
-        for (int m = 0; m < num_modes; m++) {
-          w_ky = k_vec(1, m) * 2. * M_PI / static_cast<Real>(gnx2);
-          phase = Kokkos::exp(I * w_ky * gj);
-          phases_j(j, m, 0) = phase.real();
-          phases_j(j, m, 1) = phase.imag();
-        }
+        Real w_ky = k_vec(1, m) * 2. * M_PI / static_cast<Real>(gnx2);
+        Complex phase = Kokkos::exp(I * w_ky * gj);
+        phases_j(0, j, p) = phase.real();
+        phases_j(1, j, p) = phase.imag();
       });
 
   pmb->par_for(
-      "FMFT: calc phases_k", 0, nx3 - 1 + 2 * ng, KOKKOS_LAMBDA(int k) {
+      "FMFT: calc phases_k", 0, nx3 - 1 + 2 * ng, 0, num_modes_ - 1,
+      KOKKOS_LAMBDA(const int k, const int l) {
+        const int m = kxky_modes(l);
         Real gk = static_cast<Real>((k + gks - ng) % static_cast<int>(gnx3));
-        Real w_kz;
-        Complex phase;
-
-        for (int m = 0; m < num_modes; m++) {
-          w_kz = k_vec(2, m) * 2. * M_PI / static_cast<Real>(gnx3);
-          phase = Kokkos::exp(I * w_kz * gk);
-          phases_k(k, m, 0) = phase.real();
-          phases_k(k, m, 1) = phase.imag();
-        }
+        Real w_kz = k_vec(2, m) * 2. * M_PI / static_cast<Real>(gnx3);
+        Complex phase = Kokkos::exp(I * w_kz * gk);
+        phases_k(0, k, l) = phase.real();
+        phases_k(1, k, l) = phase.imag();
       });
 }
 
 void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
                           const std::string &var_name) {
-  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  EvolveSpectrum(dt);
+  InverseTransform(md, var_name);
+}
 
+void FewModesFT::EvolveSpectrum(const Real dt) {
   const auto num_modes = num_modes_;
 
   Complex I(0.0, 1.0);
@@ -227,8 +256,9 @@ void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
   const auto kpeak = k_peak_;
 
   // generate new power spectrum (injection)
-  pmb->par_for(
-      "FMFT: new power spec", 0, 2, 0, num_modes - 1,
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "FMFT: new power spec", parthenon::DevExecSpace(), 0, 2, 0,
+      num_modes - 1,
       KOKKOS_LAMBDA(const int n, const int m) {
         Real kmag, tmp, norm, v_sqr;
 
@@ -250,8 +280,9 @@ void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
       });
 
   // enforce symmetry of complex to real transform
-  pmb->par_for(
-      "forcing: enforce symmetry", 0, 2, 0, num_modes - 1,
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "forcing: enforce symmetry", parthenon::DevExecSpace(), 0, 2,
+      0, num_modes - 1,
       KOKKOS_LAMBDA(const int n, const int m) {
         if (k_vec(0, m) == 0.) {
           for (int m2 = 0; m2 < m; m2++) {
@@ -265,8 +296,9 @@ void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
   const auto sol_weight = sol_weight_;
   if (sol_weight_ >= 0.0) {
     // project
-    pmb->par_for(
-        "forcing: projection", 0, num_modes - 1, KOKKOS_LAMBDA(const int m) {
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "forcing: projection", parthenon::DevExecSpace(), 0,
+        num_modes - 1, KOKKOS_LAMBDA(const int m) {
           Real kmag;
 
           Real kx = k_vec(0, m);
@@ -309,13 +341,21 @@ void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
   const auto c_drift = std::exp(-dt / t_corr_);
   const auto c_diff = std::sqrt(1.0 - c_drift * c_drift);
 
-  pmb->par_for(
-      "FMFT: evolve spec", 0, 2, 0, num_modes - 1,
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "FMFT: evolve spec", parthenon::DevExecSpace(), 0, 2, 0,
+      num_modes - 1,
       KOKKOS_LAMBDA(const int n, const int m) {
         var_hat(n, m) =
             Complex(var_hat(n, m).real() * c_drift + var_hat_new(n, m).real() * c_diff,
                     var_hat(n, m).imag() * c_drift + var_hat_new(n, m).imag() * c_diff);
       });
+}
+
+void FewModesFT::InverseTransform(MeshData<Real> *md, const std::string &var_name) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+
+  // make local ref to capure in lambda
+  auto &var_hat = var_hat_;
 
   auto domain = fill_ghosts_ ? IndexDomain::entire : IndexDomain::interior;
   IndexRange ib = md->GetBlockData(0)->GetBoundsI(domain);
@@ -326,25 +366,76 @@ void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
   auto phases_j = md->PackVariables(std::vector<std::string>{prefix_ + "_phases_j"});
   auto phases_k = md->PackVariables(std::vector<std::string>{prefix_ + "_phases_k"});
 
-  // implictly assuming cubic box of size L=1
+  const int nb = md->NumBlocks();
+  const int nk = kb.e - kb.s + 1;
+  const int num_kx = num_kx_;
+  const int num_kxky = num_kxky_;
+  const auto &kx_kxky_offsets = kx_kxky_offsets_;
+  const auto &kxky_mode_offsets = kxky_mode_offsets_;
+  const auto &kxky_modes = kxky_modes_;
+
+  // The inverse transform is evaluated in factorized form, i.e., first the sums over k_z
+  // for each (k_x, k_y) pair and k, then (per k-j-pencil) the sums over k_y for each k_x,
+  // and finally the sum over k_x for each cell. This reduces the work per cell from the
+  // number of modes to the number of distinct k_x.
+  // The buffer is shared between partitions (of potentially different size) so it's
+  // only reallocated if it is too small.
+  if (kxky_partial_sums_.extent_int(0) < nb ||
+      kxky_partial_sums_.extent_int(2) != num_kxky ||
+      kxky_partial_sums_.extent_int(3) < nk) {
+    kxky_partial_sums_ = parthenon::ParArray4D<Complex>(prefix_ + "_kxky_partial_sums",
+                                                        nb, 3, num_kxky, nk);
+  }
+  auto &kxky_partial_sums = kxky_partial_sums_;
+
   parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "FMFT: Inverse FT", parthenon::DevExecSpace(), 0,
-      md->NumBlocks() - 1, 0, 2, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int b, const int n, const int k, const int j, const int i) {
-        Complex phase, phase_i, phase_j, phase_k;
-        var_pack(b, n, k, j, i) = 0.0;
-
-        for (int m = 0; m < num_modes; m++) {
-          phase_i =
-              Complex(phases_i(b, 0, i - ib.s, m, 0), phases_i(b, 0, i - ib.s, m, 1));
-          phase_j =
-              Complex(phases_j(b, 0, j - jb.s, m, 0), phases_j(b, 0, j - jb.s, m, 1));
-          phase_k =
-              Complex(phases_k(b, 0, k - kb.s, m, 0), phases_k(b, 0, k - kb.s, m, 1));
-          phase = phase_i * phase_j * phase_k;
-          var_pack(b, n, k, j, i) += 2. * (var_hat(n, m).real() * phase.real() -
-                                           var_hat(n, m).imag() * phase.imag());
+      DEFAULT_LOOP_PATTERN, "FMFT: Inverse FT kz sums", parthenon::DevExecSpace(), 0,
+      nb - 1, 0, 2, 0, num_kxky - 1, kb.s, kb.e,
+      KOKKOS_LAMBDA(const int b, const int n, const int p, const int k) {
+        Complex sum(0.0, 0.0);
+        for (int l = kxky_mode_offsets(p); l < kxky_mode_offsets(p + 1); l++) {
+          sum += var_hat(n, kxky_modes(l)) * Complex(phases_k(b, 0, 0, k - kb.s, l),
+                                                     phases_k(b, 0, 1, k - kb.s, l));
         }
+        kxky_partial_sums(b, n, p, k - kb.s) = sum;
+      });
+
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  const int scratch_level = hydro_pkg->Param<int>("scratch_level");
+  const size_t scratch_size_in_bytes =
+      parthenon::ScratchPad1D<Complex>::shmem_size(num_kx);
+
+  // implictly assuming cubic box of size L=1
+  parthenon::par_for_outer(
+      DEFAULT_OUTER_LOOP_PATTERN, "FMFT: Inverse FT", parthenon::DevExecSpace(),
+      scratch_size_in_bytes, scratch_level, 0, 3 * nb - 1, kb.s, kb.e, jb.s, jb.e,
+      KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int bn, const int k,
+                    const int j) {
+        const int b = bn / 3;
+        const int n = bn % 3;
+        parthenon::ScratchPad1D<Complex> kx_sums(member.team_scratch(scratch_level),
+                                                 num_kx);
+
+        // Sums over k_y for each k_x along this pencil
+        parthenon::par_for_inner(member, 0, num_kx - 1, [&](const int g) {
+          Complex sum(0.0, 0.0);
+          for (int p = kx_kxky_offsets(g); p < kx_kxky_offsets(g + 1); p++) {
+            const Complex phase_j(phases_j(b, 0, 0, j - jb.s, p),
+                                  phases_j(b, 0, 1, j - jb.s, p));
+            sum += kxky_partial_sums(b, n, p, k - kb.s) * phase_j;
+          }
+          kx_sums(g) = sum;
+        });
+        member.team_barrier();
+
+        parthenon::par_for_inner(member, ib.s, ib.e, [&](const int i) {
+          Real var = 0.0;
+          for (int g = 0; g < num_kx; g++) {
+            var += kx_sums(g).real() * phases_i(b, 0, 0, g, i - ib.s) -
+                   kx_sums(g).imag() * phases_i(b, 0, 1, g, i - ib.s);
+          }
+          var_pack(b, n, k, j, i) = var;
+        });
       });
 }
 
@@ -403,4 +494,37 @@ ParArray2D<Real> MakeRandomModes(const int num_modes, const Real k_peak,
 
   return k_vec;
 }
+// Creates all (integer) wave vectors (with k_x >= 0) with k_mag within k_low and k_high
+// that have power in the forcing spectrum
+ParArray2D<Real> MakeBandModes(const Real k_peak, const Real k_low, const Real k_high) {
+  const int k_max = std::floor(k_high);
+
+  std::vector<std::array<int, 3>> modes;
+  for (int kx1 = 0; kx1 <= k_max; kx1++) {
+    for (int kx2 = -k_max; kx2 <= k_max; kx2++) {
+      for (int kx3 = -k_max; kx3 <= k_max; kx3++) {
+        const Real k_mag = std::sqrt(SQR(kx1) + SQR(kx2) + SQR(kx3));
+        // Expected amplitude of the spectral function. If this is changed, it also needs
+        // to be changed in the FMFT class (or abstracted).
+        const Real ampl = SQR(k_mag / k_peak) * (2.0 - SQR(k_mag / k_peak));
+        if (ampl <= 0 || k_mag < k_low || k_mag > k_high) {
+          continue;
+        }
+        modes.push_back({kx1, kx2, kx3});
+      }
+    }
+  }
+
+  const int num_modes = modes.size();
+  auto k_vec = parthenon::ParArray2D<Real>("k_vec", 3, num_modes);
+  auto k_vec_h = Kokkos::create_mirror_view(k_vec);
+  for (int m = 0; m < num_modes; m++) {
+    for (int d = 0; d < 3; d++) {
+      k_vec_h(d, m) = modes[m][d];
+    }
+  }
+  Kokkos::deep_copy(k_vec, k_vec_h);
+
+  return k_vec;
+}
 } // namespace utils::few_modes_ft
\ No newline at end of file
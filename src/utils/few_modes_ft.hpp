@@ -24,6 +24,7 @@ using namespace parthenon::package::prelude;
 using parthenon::Real;
 using Complex = Kokkos::complex<Real>;
 using parthenon::IndexRange;
+using parthenon::ParArray1D;
 using parthenon::ParArray2D;
 
 class FewModesFT {
@@ -42,6 +43,18 @@ class FewModesFT {
   Real t_corr_;      // correlation time for evolution of Ornstein-Uhlenbeck process
   bool fill_ghosts_; // if the inverse transform should also fill ghost zones
 
+  // Grouping of modes for the factorized inverse transform. Modes are grouped by their
+  // (k_x, k_y) pair and pairs are grouped by their k_x so that the transform can be
+  // evaluated as sum_kx phase_i * (sum_ky phase_j * (sum_kz phase_k * var_hat)).
+  int num_kx_, num_kxky_;
+  ParArray1D<int> kx_rep_;            // representative mode of each k_x
+  ParArray1D<int> kx_kxky_offsets_;   // range of (k_x, k_y) pairs of each k_x
+  ParArray1D<int> kxky_rep_;          // representative mode of each (k_x, k_y) pair
+  ParArray1D<int> kxky_mode_offsets_; // range of modes (in kxky_modes_) of each pair
+  ParArray1D<int> kxky_modes_;        // modes sorted by (k_x, k_y) pair
+  // Partial sums over k_z of each (k_x, k_y) pair along k (reused between calls)
+  parthenon::ParArray4D<Complex> kxky_partial_sums_;
+
  public:
   FewModesFT(parthenon::ParameterInput *pin, parthenon::StateDescriptor *pkg,
              std::string prefix, int num_modes, ParArray2D<Real> k_vec, Real k_peak,
@@ -50,7 +63,15 @@ class FewModesFT {
   ParArray2D<Complex> GetVarHat() { return var_hat_; }
   int GetNumModes() { return num_modes_; }
   void SetPhases(MeshBlock *pmb, ParameterInput *pin);
+  // Evolves the spectrum and transforms it to real space (in `var_name`) for all blocks
+  // in `md`. Only to be used if `md` contains all blocks (e.g., during initialization)
+  // as the spectrum is evolved with every call.
   void Generate(MeshData<Real> *md, const Real dt, const std::string &var_name);
+  // Evolves the spectrum by `dt`. Must be called once (per rank) for a time step.
+  void EvolveSpectrum(const Real dt);
+  // Inverse transform of the current spectrum to `var_name` for the blocks in `md`.
+  // Can be called independently for each partition.
+  void InverseTransform(MeshData<Real> *md, const std::string &var_name);
   void RestoreRNG(std::istringstream &iss) { iss >> rng_; }
   void RestoreDist(std::istringstream &iss) { iss >> dist_; }
   std::string GetRNGState() {
@@ -68,4 +89,8 @@ class FewModesFT {
 // Creates a random set of wave vectors with k_mag within k_peak/2 and 2*k_peak
 ParArray2D<Real> MakeRandomModes(const int num_modes, const Real k_peak, uint32_t rseed);
 
+// Creates all (integer) wave vectors (with k_x >= 0) with k_mag within k_low and k_high
+// that have power in the forcing spectrum
+ParArray2D<Real> MakeBandModes(const Real k_peak, const Real k_low, const Real k_high);
+
 } // namespace utils::few_modes_ft
\ No newline at end of file
@@ -31,12 +31,32 @@ from scipy.optimize import curve_fit
 # To prevent littering up imported folders with .pyc files or __pycache_ folder
 sys.dont_write_bytecode = True
 
-int_cfgs = ["unsplit", "rkl2"]
+int_cfgs = ["unsplit", "rkl1", "rkl2", "rkg2"]
 res_cfgs = [128, 256, 512]
 field_cfgs = ["none", "aligned", "angle", "perp"]
 tlim = 2.0
-
-all_cfgs = list(itertools.product(res_cfgs, field_cfgs, int_cfgs))
+# RKL1 is only first order accurate in time
+expected_conv = {"unsplit": -1.98, "rkl1": -0.98, "rkl2": -1.98, "rkg2": -1.98}
+
+# Field configurations tested with each integrator. The unsplit integrator is tested
+# with all of them. For the profile along x, the aligned case is equivalent to the
+# isotropic one and the perpendicular case (no diffusion) is not part of the convergence
+# check, so the STS integrators are only tested with the remaining ones to limit the
+# number of runs.
+int_field_cfgs = {
+    "unsplit": field_cfgs,
+    "rkl1": ["angle"],
+    "rkl2": ["none", "angle"],
+    "rkg2": ["angle"],
+}
+
+all_cfgs = [
+    (res, field_cfg, int_cfg)
+    for res, (int_cfg, field_cfg) in itertools.product(
+        res_cfgs,
+        [(i, f) for i in int_cfgs for f in int_field_cfgs[i]],
+    )
+]
 
 
 def get_outname(all_cfg):
@@ -98,7 +118,7 @@ class TestCase(utils.test_case.TestCaseAbs):
             "parthenon/output0/id=%s" % outname,
             "hydro/gamma=2.0",
             "parthenon/time/tlim=%f" % tlim,
-            # Work around for RKL2 integrator (that, by default, does not limit the
+            # Work around for STS integrators (that, by default, do not limit the
             # timestep, which in newer versions of Parthenon results in triggering
             # a fail-safe given the default init value of numeric_limits max.
             "parthenon/time/dt_ceil=%f" % tlim,
@@ -134,9 +154,11 @@ class TestCase(utils.test_case.TestCaseAbs):
 
         num_rows = len(res_cfgs)
         num_cols = len(int_cfgs)
-        fig, p = plt.subplots(num_rows + 1, 2, sharey="row", sharex="row")
+        fig, p = plt.subplots(
+            num_rows + 1, num_cols, sharey="row", sharex="row", figsize=(12.8, 9.6)
+        )
 
-        l1_err = np.zeros((len(field_cfgs), len(int_cfgs), len(res_cfgs)))
+        l1_err = np.full((len(field_cfgs), len(int_cfgs), len(res_cfgs)), np.nan)
         for step in range(len(all_cfgs)):
             outname = get_outname(all_cfgs[step])
             data_filename = f"{parameters.output_path}/parthenon.{outname}.final.phdf"
@@ -169,7 +191,7 @@ class TestCase(utils.test_case.TestCaseAbs):
         for i, field_cfg in enumerate(field_cfgs):
             for j, int_cfg in enumerate(int_cfgs):
                 p[0, j].set_title(f"Integrator: {int_cfg}")
-                if field_cfg == "perp":
+                if field_cfg == "perp" or field_cfg not in int_field_cfgs[int_cfg]:
                     continue
 
                 p[-1, j].plot(
@@ -190,10 +212,11 @@ class TestCase(utils.test_case.TestCaseAbs):
                 # For a more reasonable test (which would take longer), reduce the RKL2 ratio to,
                 # say, 200 and extend the resolution grid to 1024 (as the first data point at N=128
                 # is comparatively worse than at N>128).
-                if conv_measured > -1.98:
+                if conv_measured > expected_conv[int_cfg]:
                     print(
                         f"!!!\nConvergence for {field_cfg} test with {int_cfg} integrator "
-                        f"is worse ({conv_measured}) than expected (-1.98).\n!!!"
+                        f"is worse ({conv_measured}) than expected "
+                        f"({expected_conv[int_cfg]}).\n!!!"
                     )
                     tests_passed = False
                 p[-1, j].plot(
@@ -206,8 +229,8 @@ class TestCase(utils.test_case.TestCaseAbs):
 
         p[-1, 0].set_xscale("log")
         p[-1, 0].set_yscale("log")
-        p[-1, 0].legend(fontsize=6)
-        p[-1, 1].legend(fontsize=6)
+        for j in range(num_cols):
+            p[-1, j].legend(fontsize=6)
 
         # Plot reference lines
         x = np.linspace(-6, 6, 400)
@@ -97,6 +97,7 @@ class TestCase(utils.test_case.TestCaseAbs):
 
         self.norm_tol = 1e-3
         self.linf_accretion_rate_tol = 1e-3
+        self.removed_mass_tol = 1e-2
 
         self.step_params_list = ["COLD_GAS", "BOOSTED_BONDI", "BOOTH_SCHAYE"]
         self.steps = len(self.step_params_list)
@@ -340,6 +341,7 @@ class TestCase(utils.test_case.TestCaseAbs):
 
             try:
                 import compare_analytic
+                import phdf
             except ModuleNotFoundError:
                 print("Couldn't find module to analyze Parthenon hdf5 files.")
                 return False
@@ -435,4 +437,37 @@ class TestCase(utils.test_case.TestCaseAbs):
 
             analyze_status &= analytic_status
 
+            # Explicitly check that the accreted mass is removed from the accretion
+            # region (with the vl2 integrator, the removal needs to be applied before the
+            # registers are initialized for it to not be overwritten by the first stage)
+            final_file = phdf.phdf(phdf_files[1])
+            Z, Y, X = final_file.GetVolumeLocations(flatten=False)
+            r = np.sqrt(X**2 + Y**2 + Z**2)
+            cell_vols = np.einsum(
+                "ai,aj,ak->aijk",
+                np.diff(final_file.zf),
+                np.diff(final_file.yf),
+                np.diff(final_file.xf),
+            )
+            rho = final_file.GetComponents(["cons_density"], flatten=False)[
+                "cons_density"
+            ]
+            in_region = r < self.accretion_radius.in_units("code_length").v
+            rho0 = self.uniform_gas_rho.in_units("code_mass/code_length**3").v
+            removed_mass = np.sum(((rho0 - rho) * cell_vols)[in_region])
+            analytic_removed_mass = (
+                rho0 - final_rho.in_units("code_mass/code_length**3").v
+            ) * np.sum(cell_vols[in_region])
+
+            removed_mass_err = np.abs(
+                (removed_mass - analytic_removed_mass) / analytic_removed_mass
+            )
+            if analytic_removed_mass <= 0 or removed_mass_err > self.removed_mass_tol:
+                analyze_status = False
+                print(
+                    f"{triggering_mode} removed mass {removed_mass} does not match the"
+                    f" analytically accreted mass {analytic_removed_mass}"
+                    f" (rel. error {removed_mass_err} > {self.removed_mass_tol})"
+                )
+
         return analyze_status
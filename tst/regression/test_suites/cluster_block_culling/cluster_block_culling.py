@@ -0,0 +1,70 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2024, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Magnetic tower feedback (precessed jet on a statically refined mesh of small blocks)
+# with and without culling the blocks outside of the region of the tower. One block per
+# pack so that most partitions are culled.
+block_cullings = ["true", "false"]
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        block_culling = block_cullings[step - 1]
+        parameters.driver_cmd_line_args = [
+            "parthenon/output1/dt=-1",
+            "parthenon/mesh/pack_size=1",
+            f"parthenon/output2/id=culling_{block_culling}",
+            "parthenon/output2/dt=1.0",
+            f"problem/cluster/block_culling={block_culling}",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to load Parthenon hdf5 files.")
+            return False
+
+        data = []
+        for block_culling in block_cullings:
+            data_file = phdf.phdf(
+                f"{parameters.output_path}/parthenon.culling_{block_culling}.final.phdf"
+            )
+            data.append(
+                data_file.GetComponents(data_file.Info["ComponentNames"], flatten=False)
+            )
+
+        # Culled blocks do not intersect the region of the source terms so culling may
+        # only change the results by round-off (from the different order of the sums).
+        test_success = True
+        for name, culled in data[0].items():
+            ref = data[1][name]
+            if not np.allclose(
+                culled, ref, rtol=1e-12, atol=1e-12 * np.max(np.abs(ref))
+            ):
+                print(
+                    f"ERROR: {name} differs with and without block culling. Max abs "
+                    f"difference: {np.max(np.abs(culled - ref))}"
+                )
+                test_success = False
+
+        return test_success
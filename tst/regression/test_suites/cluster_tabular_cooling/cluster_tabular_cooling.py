@@ -92,6 +92,17 @@ class TestCase(utils.test_case.TestCaseAbs):
 
         self.convergence_tol = 0.1
 
+        # Non-uniformly spaced and multi-dimensional (log_temp, log_n_h, log_z) tables.
+        # The dependence on n_h and Z is chosen so that the cooling function of the
+        # uniform gas (n_h ~ 0.45 cm^-3) still matches the exponential one above.
+        self.table_tests = list(
+            itertools.product(("nonuniform", "3d"), ("rk45", "townsend"))
+        )
+        self.table_log_n_hs = (-3, -2, -1, 0, 1)
+        self.table_log_zs = (-2, -1, 0, 1)
+        self.log_metallicity = -0.3
+        self.table_tol = {"rk45": 1e-10, "townsend": 1e-12}
+
     def Prepare(self, parameters, step):
         """
         Any preprocessing that is needed before the drive is run can be done in
@@ -117,8 +128,19 @@ class TestCase(utils.test_case.TestCaseAbs):
                 'mesh/nx1=400']
         """
 
+        table = "uniform"
+        subcycle_args = []
+
         # Get the cooling integrator and max_iter for this run
-        if step <= len(self.integrators_and_max_iters):
+        if step > self.n_steps:
+            # Test non-uniform and multi-dimensional tables
+            table, integrator = self.table_tests[step - self.n_steps - 1]
+            # Use plenty of iterations
+            max_iter = max(self.max_iters)
+            # Use a small but non-zero tolerance
+            d_e_tol = self.machine_epsilon
+            cooling_cfl = self.cooling_cfl_convergence_test
+        elif step <= len(self.integrators_and_max_iters):
             # Convergence Tests
             # Use a specific iteration count
             integrator, max_iter = self.integrators_and_max_iters[step - 1]
@@ -137,6 +159,11 @@ class TestCase(utils.test_case.TestCaseAbs):
             d_e_tol = self.machine_epsilon
             # Use a reasonable cooling cfl
             cooling_cfl = self.cooling_cfl_convergence_test
+            # Also test the history output of the number of subcycles
+            subcycle_args = [
+                "cooling/track_subcycles=true",
+                f"parthenon/output1/id=subcycles_{step}",
+            ]
         else:
             integrator = "townsend"
             # Parameter unused (still, Townsend is an exact, single step integrator)
@@ -150,8 +177,43 @@ class TestCase(utils.test_case.TestCaseAbs):
         table_filename = "exponential.cooling"
         log_temps = np.linspace(self.log_temp0, self.log_temp1, self.n_log_temp)
         log_lambdas = np.linspace(self.log_lambda0, self.log_lambda1, self.n_log_lambda)
-
-        cooling_table = np.vstack((log_temps, log_lambdas)).T
+        table_args = []
+        if table != "uniform":
+            # Quadratically spaced temperatures, which still exactly represent the
+            # exponential cooling function
+            log_temps = (
+                self.log_temp0
+                + (self.log_temp1 - self.log_temp0)
+                * np.linspace(0, 1, self.n_log_temp) ** 2
+            )
+            log_lambdas = self.log_lambda0 + (log_temps - self.log_temp0) * (
+                self.log_lambda1 - self.log_lambda0
+            ) / (self.log_temp1 - self.log_temp0)
+
+        if table == "3d":
+            # Only the bin in n_h containing the uniform gas is unchanged and the
+            # (linear) dependence on log Z vanishes at the given metallicity
+            cooling_table = np.array(
+                [
+                    (
+                        log_temp,
+                        log_n_h,
+                        log_z,
+                        log_lambda
+                        + (0.0 if log_n_h in (-1, 0) else 1.0)
+                        + 0.5 * (log_z - self.log_metallicity),
+                    )
+                    for log_z in self.table_log_zs
+                    for log_n_h in self.table_log_n_hs
+                    for log_temp, log_lambda in zip(log_temps, log_lambdas)
+                ]
+            )
+            table_args = [
+                "cooling/table_axes=log_temp,log_n_h,log_z",
+                f"cooling/log_metallicity={self.log_metallicity}",
+            ]
+        else:
+            cooling_table = np.vstack((log_temps, log_lambdas)).T
         np.savetxt(table_filename, cooling_table, delimiter=" ")
 
         parameters.driver_cmd_line_args = [
@@ -176,6 +238,7 @@ class TestCase(utils.test_case.TestCaseAbs):
             f"cooling/max_iter={max_iter}",
             f"cooling/d_e_tol={d_e_tol}",
         ]
+        parameters.driver_cmd_line_args += table_args + subcycle_args
 
         return parameters
 
@@ -292,7 +355,7 @@ class TestCase(utils.test_case.TestCaseAbs):
             return np.max((non_zero_linf, zero_linf))
 
         # Verify the initial state
-        for step in range(1, self.n_steps + 1):
+        for step in range(1, self.n_steps + len(self.table_tests) + 1):
             data_filename = (
                 f"{parameters.output_path}/parthenon.tabular_cooling_{step}.00000.phdf"
             )
@@ -336,8 +399,9 @@ class TestCase(utils.test_case.TestCaseAbs):
         # Read and check the final state of all sims
         conv_final_internal_es = {}  # internal_e for convergence study
         adapt_final_internal_es = {}  # internal_e for the adaptive tests
+        table_final_internal_es = {}  # internal_e for the table tests
 
-        for step in range(1, self.n_steps + 1):
+        for step in range(1, self.n_steps + len(self.table_tests) + 1):
             data_filename = (
                 f"{parameters.output_path}/parthenon.tabular_cooling_{step}.final.phdf"
             )
@@ -377,7 +441,11 @@ class TestCase(utils.test_case.TestCaseAbs):
             # Save the final internal_e
             internal_e = (pres / (rho * (self.adiabatic_index - 1))).mean()
 
-            if step <= len(self.integrators_and_max_iters):
+            if step > self.n_steps:
+                table_final_internal_es[
+                    self.table_tests[step - self.n_steps - 1]
+                ] = internal_e
+            elif step <= len(self.integrators_and_max_iters):
                 conv_final_internal_es[
                     self.integrators_and_max_iters[step - 1]
                 ] = internal_e
@@ -385,6 +453,32 @@ class TestCase(utils.test_case.TestCaseAbs):
                 adapt_step = step - len(self.integrators_and_max_iters)
                 integrator = self.integrators[adapt_step - 1]
                 adapt_final_internal_es[integrator] = internal_e
+
+                # Check the subcycles in the history output (on a single rank the
+                # maximum and mean over all ranks are identical)
+                hst_data = np.genfromtxt(
+                    f"{parameters.output_path}/parthenon.subcycles_{step}.hst",
+                    names=True,
+                    skip_header=1,
+                )
+                subcycles = {
+                    stat: hst_data[
+                        next(
+                            name
+                            for name in hst_data.dtype.names
+                            if name.endswith(f"cool_subcyc_{stat}")
+                        )
+                    ]
+                    for stat in ("max", "mean")
+                }
+                if (
+                    np.any(subcycles["mean"][1:] < 1)
+                    or np.any(subcycles["mean"] > max(self.max_iters) + 1)
+                    or np.any(subcycles["max"] != subcycles["mean"])
+                ):
+                    print(f"ERROR: Unexpected number of subcycles of {integrator}")
+                    print(f"    max: {subcycles['max']} mean: {subcycles['mean']}")
+                    analyze_status = False
             else:
                 integrator = "townsend"
                 adapt_final_internal_es[integrator] = internal_e
@@ -472,6 +566,16 @@ class TestCase(utils.test_case.TestCaseAbs):
                 print(f"    {adapt_err} >= {self.integrator_tol[integrator]}")
                 analyze_status = False
 
+        for (table, integrator), final_internal_e in table_final_internal_es.items():
+            table_err = np.abs(
+                (analytic_final_internal_e - final_internal_e)
+                / analytic_final_internal_e
+            )
+            if table_err >= self.table_tol[integrator]:
+                print(f"ERROR: {integrator} error with {table} table exceeds tolerance")
+                print(f"    {table_err} >= {self.table_tol[integrator]}")
+                analyze_status = False
+
         ax.set_xscale("log")
         ax.set_yscale("log")
 
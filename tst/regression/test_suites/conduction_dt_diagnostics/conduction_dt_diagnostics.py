@@ -0,0 +1,134 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2024, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Anisotropic ring diffusion with a Spitzer coefficient (scaled so that the diffusivity
+# is about 0.01 outside and 0.016 inside the ring) without and with a limit of the
+# diffusivity that is only exceeded inside the ring.
+max_diffs = [0.0, 0.012]
+
+limiter_labels = [
+    "dt_cond",
+    "dt_cond_x1",
+    "dt_cond_x2",
+    "dt_cond_x3",
+    "dt_cond_rho",
+    "dt_cond_T",
+    "dt_cond_diff",
+    "dt_cond_sat_ratio",
+    "dt_cond_gid",
+]
+
+
+def read_hst(filename):
+    """Returns a dict of all columns of a history file indexed by their label."""
+    labels = None
+    with open(filename) as f:
+        for line in f:
+            if line.startswith("#") and "[1]=" in line:
+                labels = [
+                    entry.split("=")[1] for entry in line.split() if "]=" in entry
+                ]
+    data = np.atleast_2d(np.genfromtxt(filename))
+    return {label: data[:, i] for i, label in enumerate(labels)}
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        assert parameters.num_ranks <= 4, "Use <= 4 ranks for this test."
+
+        parameters.driver_cmd_line_args = [
+            "parthenon/mesh/nx1=64",
+            "parthenon/mesh/nx2=64",
+            "parthenon/meshblock/nx1=32",
+            "parthenon/meshblock/nx2=32",
+            "parthenon/time/nlim=5",
+            "parthenon/output0/dt=-1",
+            "problem/diffusion/iprob=20",
+            "units/code_length_cgs=1",
+            "hydro/He_mass_fraction=0.25",
+            "diffusion/conduction_coeff=spitzer",
+            "diffusion/spitzer_cond_in_erg_by_s_K_cm=1e24",
+            f"diffusion/conduction_max_diff_code={max_diffs[step - 1]}",
+            "diffusion/conduction_dt_diagnostics=true",
+            # History output every cycle
+            "parthenon/output1/file_type=hst",
+            "parthenon/output1/dt=1e-12",
+            f"parthenon/output1/id=cond_{step}",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        test_success = True
+
+        limiters = []
+        for step, max_diff in enumerate(max_diffs, start=1):
+            hst = read_hst(f"{parameters.output_path}/parthenon.cond_{step}.hst")
+            for label in limiter_labels:
+                if label not in hst:
+                    print(f"Missing {label} in history output of step {step}.")
+                    return False
+
+            # The global limiter is only available after the first cycle
+            valid = hst["dt_cond_gid"] >= 0
+            if not np.any(valid):
+                print(f"No conduction timestep limiter recorded in step {step}.")
+                test_success = False
+                continue
+            limiter = {label: hst[label][valid] for label in limiter_labels}
+            limiters.append(limiter)
+
+            dt_cond = limiter["dt_cond"]
+            if not np.all(np.isfinite(dt_cond) & (dt_cond > 0.0)):
+                print(f"Invalid conduction timestep {dt_cond}.")
+                test_success = False
+            for label in ["dt_cond_x1", "dt_cond_x2"]:
+                if np.any(np.abs(limiter[label]) > 1.0):
+                    print(f"Limiting cell outside of domain: {label}={limiter[label]}")
+                    test_success = False
+            for label in ["dt_cond_rho", "dt_cond_T", "dt_cond_diff"]:
+                if np.any(limiter[label] <= 0.0):
+                    print(f"Expected {label} > 0 but got {limiter[label]}.")
+                    test_success = False
+            if np.any(limiter["dt_cond_gid"] > 3):
+                print(f"Invalid block id {limiter['dt_cond_gid']} of limiting cell.")
+                test_success = False
+
+        if not test_success:
+            return False
+
+        # Without limit the cells inside the ring (with a diffusivity above the limit)
+        # constrain the timestep.
+        if not limiters[0]["dt_cond_diff"][0] > max_diffs[1]:
+            print(
+                f"Expected a diffusivity above {max_diffs[1]} without limit but got "
+                f"{limiters[0]['dt_cond_diff'][0]}."
+            )
+            test_success = False
+
+        # With limit the diffusivity of the limiting cell is bounded and the timestep
+        # larger than without limit (comparing the first cycle with identical states).
+        if np.any(limiters[1]["dt_cond_diff"] > max_diffs[1] * (1.0 + 1e-12)):
+            print(
+                f"Diffusivity {limiters[1]['dt_cond_diff']} above limit {max_diffs[1]}."
+            )
+            test_success = False
+        if not limiters[1]["dt_cond"][0] > limiters[0]["dt_cond"][0]:
+            print(
+                f"Expected larger conduction timestep with limit but got "
+                f"{limiters[1]['dt_cond'][0]} vs {limiters[0]['dt_cond'][0]} without."
+            )
+            test_success = False
+
+        return test_success
@@ -0,0 +1,110 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2024, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import sys
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Sod shock tube without a density floor and with a density floor above the density of
+# the right state (0.125) so that the floor is applied in all cells of the right state.
+dfloors = [-1.0, 0.2]
+
+# Two history outputs with different intervals to check that the counters are
+# independent of the number of history outputs
+hst_ids = {"a": 0.02, "b": 0.05}
+
+event_labels = [
+    "floor_dens",
+    "ceil_vel",
+    "floor_pres",
+    "floor_temp",
+    "ceil_temp",
+    "fofc_corrected",
+    "fofc_need_floor",
+]
+
+
+def read_hst(filename):
+    """Returns a dict of all columns of a history file indexed by their label."""
+    labels = None
+    with open(filename) as f:
+        for line in f:
+            if line.startswith("#") and "[1]=" in line:
+                labels = [
+                    entry.split("=")[1] for entry in line.split() if "]=" in entry
+                ]
+    data = np.atleast_2d(np.genfromtxt(filename))
+    return {label: data[:, i] for i, label in enumerate(labels)}
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        parameters.driver_cmd_line_args = [
+            "parthenon/output0/dt=-1",
+            "parthenon/time/tlim=0.2",
+            "hydro/floor_event_counters=true",
+            f"hydro/dfloor={dfloors[step - 1]}",
+        ]
+        for n, (hst_id, dt) in enumerate(hst_ids.items()):
+            parameters.driver_cmd_line_args += [
+                f"parthenon/output{n + 1}/file_type=hst",
+                f"parthenon/output{n + 1}/dt={dt}",
+                f"parthenon/output{n + 1}/id=floor_{step}_{hst_id}",
+            ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        test_success = True
+
+        for step, dfloor in enumerate(dfloors, start=1):
+            hsts = {
+                hst_id: read_hst(
+                    f"{parameters.output_path}/parthenon.floor_{step}_{hst_id}.hst"
+                )
+                for hst_id in hst_ids
+            }
+
+            for hst_id, hst in hsts.items():
+                for label in event_labels:
+                    if label not in hst:
+                        print(f"Missing {label} in history output {hst_id}.")
+                        return False
+
+                    counts = hst[label]
+                    # Counters are cumulative since the beginning of the simulation
+                    if np.any(np.diff(counts) < 0):
+                        print(f"Decreasing {label} in {hst_id} (dfloor={dfloor}).")
+                        test_success = False
+
+                    expect_events = label == "floor_dens" and dfloor > 0.0
+                    if expect_events and not counts[-1] > 0:
+                        print(f"Expected {label} > 0 for dfloor={dfloor}.")
+                        test_success = False
+                    if not expect_events and np.any(counts != 0):
+                        print(
+                            f"Expected no {label} events for dfloor={dfloor} but "
+                            f"got {counts[-1]}."
+                        )
+                        test_success = False
+
+            # Counts at times present in both history outputs need to agree, i.e.,
+            # writing one output must not affect the counts reported by the other one.
+            for t, count in zip(hsts["b"]["time"], hsts["b"]["floor_dens"]):
+                match = np.isclose(hsts["a"]["time"], t, rtol=0.0, atol=1e-12)
+                if np.any(match) and hsts["a"]["floor_dens"][match][0] != count:
+                    print(
+                        f"floor_dens differs between history outputs at t={t} "
+                        f"(dfloor={dfloor}): {hsts['a']['floor_dens'][match][0]} "
+                        f"vs {count}."
+                    )
+                    test_success = False
+
+        return test_success
@@ -0,0 +1,116 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2024, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import matplotlib
+
+matplotlib.use("agg")
+import matplotlib.pylab as plt
+import sys
+import os
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Accuracy cost of the single precision copy of the primitive variables used in the
+# flux calculation (AthenaPK_ENABLE_MIXED_PRECISION=ON).
+# Linear waves are run with a large and with the default (small) amplitude. In double
+# precision the errors normalized by the amplitude are independent of the amplitude (as
+# long as nonlinear terms are negligible). In single precision the rounding of the
+# background state (~1e-7 relative) is comparable to the small amplitude so that the
+# ratio of normalized errors quantifies the accuracy cost.
+lin_res = [16, 32, 64]
+method_cfgs = [
+    {"integrator": "vl2", "recon": "plm"},
+    {"integrator": "rk3", "recon": "ppm"},
+]
+amps = [1e-3, 1e-6]
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        n_res = len(lin_res)
+        n_meth = len(method_cfgs)
+
+        res = lin_res[(step - 1) % n_res]
+        method_cfg = method_cfgs[((step - 1) // n_res) % n_meth]
+        amp = amps[(step - 1) // (n_res * n_meth)]
+
+        parameters.driver_cmd_line_args = [
+            "parthenon/mesh/nx1=%d" % (2 * res),
+            "parthenon/meshblock/nx1=%d" % (2 * res),
+            "parthenon/mesh/nx2=%d" % res,
+            "parthenon/meshblock/nx2=%d" % res,
+            "parthenon/mesh/nx3=%d" % res,
+            "parthenon/meshblock/nx3=%d" % res,
+            "parthenon/mesh/nghost=%d" % (3 if method_cfg["recon"] == "ppm" else 2),
+            "parthenon/time/integrator=%s" % method_cfg["integrator"],
+            "hydro/reconstruction=%s" % method_cfg["recon"],
+            "problem/linear_wave/amp=%e" % amp,
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        n_res = len(lin_res)
+        n_meth = len(method_cfgs)
+
+        data = np.genfromtxt(
+            os.path.join(parameters.output_path, "linearwave-errors.dat")
+        )
+        if data.shape[0] != n_res * n_meth * len(amps):
+            print(
+                f"Expected {n_res * n_meth * len(amps)} lines in output file, "
+                f"but got {data.shape[0]}."
+            )
+            return False
+
+        # errors normalized by the amplitude [amp, method, res]
+        errs = data[:, 4].reshape(len(amps), n_meth, n_res)
+        errs /= np.array(amps)[:, None, None]
+
+        analyze_status = True
+        for m, cfg in enumerate(method_cfgs):
+            name = f'{cfg["integrator"].upper()} {cfg["recon"].upper()}'
+            # Large amplitude waves are not affected by the rounding and should still
+            # (at least) converge at second order.
+            order = np.log2(errs[0, m, 0] / errs[0, m, -1]) / (n_res - 1)
+            print(f"{name}: convergence order for amp={amps[0]:.0e}: {order:.2f}")
+            if order < 1.8:
+                print(f"{name}: convergence order below 2 for amp={amps[0]:.0e}.")
+                analyze_status = False
+            for r, res in enumerate(lin_res):
+                print(
+                    f"{name}: res {res:3d}: normalized L1 err amp={amps[0]:.0e}: "
+                    f"{errs[0, m, r]:.3e}, amp={amps[1]:.0e}: {errs[1, m, r]:.3e} "
+                    f"(ratio {errs[1, m, r] / errs[0, m, r]:.2f})"
+                )
+
+        markers = "ov^<"
+        for m, cfg in enumerate(method_cfgs):
+            for a, amp in enumerate(amps):
+                plt.plot(
+                    lin_res,
+                    errs[a, m],
+                    marker=markers[m],
+                    ls="-" if a == 0 else "--",
+                    label=f'{cfg["integrator"].upper()} {cfg["recon"].upper()} '
+                    f"amp={amp:.0e}",
+                )
+
+        plt.legend(bbox_to_anchor=(1, 1), loc="upper left")
+        plt.xscale("log")
+        plt.yscale("log")
+        plt.ylabel("L1 err / amp")
+        plt.xlabel("Linear resolution")
+        plt.savefig(
+            os.path.join(parameters.output_path, "mixed-precision-errors.png"),
+            bbox_inches="tight",
+        )
+
+        return analyze_status
@@ -51,11 +51,40 @@ perf_cfgs = [
     {"mx": 256, "mb": 128, "integrator": "rk2", "recon": "limo3", "fluid": "glmmhd"},
     {"mx": 256, "mb": 128, "integrator": "rk3", "recon": "weno3", "fluid": "glmmhd"},
     {"mx": 256, "mb": 128, "integrator": "rk3", "recon": "wenoz", "fluid": "glmmhd"},
+    {"mx": 256, "mb": 128, "integrator": "rk2", "recon": "plm", "flux_kernel": "fused"},
+    {"mx": 256, "mb": 64, "integrator": "rk2", "recon": "plm", "flux_kernel": "fused"},
+    {"mx": 256, "mb": 128, "integrator": "rk3", "recon": "ppm", "flux_kernel": "fused"},
+    {"mx": 256, "mb": 64, "integrator": "rk3", "recon": "ppm", "flux_kernel": "fused"},
 ]
 
 for cfg in perf_cfgs:
     if "fluid" not in cfg.keys():
         cfg["fluid"] = "euler"
+    if "flux_kernel" not in cfg.keys():
+        cfg["flux_kernel"] = "pencil"
+
+
+def flux_zone_cycles_per_s(filename):
+    """Returns the zone-cycles/s of the flux calculation measured by the task timers,
+    i.e., the number of zone-cycles divided by the time spent in CalculateFluxes."""
+    with open(filename) as f:
+        header = f.readline().strip().split(",")
+        for line in f:
+            row = dict(zip(header, line.strip().split(",")))
+            if row["task"] == "CalculateFluxes":
+                return float(row["zone_cycles_per_s"])
+    return np.nan
+
+
+def pencil_cfg_index(cfg):
+    """Returns the index of the config with the pencil flux kernel and the same method
+    and mesh as (the fused) `cfg`."""
+    for i, other in enumerate(perf_cfgs):
+        if other["flux_kernel"] == "pencil" and all(
+            other[key] == cfg[key] for key in cfg.keys() if key != "flux_kernel"
+        ):
+            return i
+    return None
 
 
 class TestCase(utils.test_case.TestCaseAbs):
@@ -65,6 +94,7 @@ class TestCase(utils.test_case.TestCaseAbs):
         integrator = perf_cfgs[step - 1]["integrator"]
         recon = perf_cfgs[step - 1]["recon"]
         fluid = perf_cfgs[step - 1]["fluid"]
+        flux_kernel = perf_cfgs[step - 1]["flux_kernel"]
 
         parameters.driver_cmd_line_args = [
             "problem/linear_wave/compute_error=false",
@@ -82,6 +112,14 @@ class TestCase(utils.test_case.TestCaseAbs):
             "parthenon/time/nlim=10",
             "hydro/reconstruction=%s" % recon,
             "hydro/fluid=%s" % fluid,
+            "hydro/flux_kernel=%s" % flux_kernel,
+            # Measure the time spent in the flux calculation (with a fence after each
+            # task so that the kernel time is measured on GPUs, too) and write a single
+            # row per task at the end of the simulation.
+            f"job/problem_id=perf_{step}",
+            "hydro/task_timers=true",
+            "hydro/task_timers_fence=true",
+            "hydro/task_timers_dt=1e10",
         ]
 
         return parameters
@@ -97,25 +135,52 @@ class TestCase(utils.test_case.TestCaseAbs):
 
         perfs = np.array(perfs)
 
+        flux_perfs = np.array(
+            [
+                flux_zone_cycles_per_s(
+                    os.path.join(
+                        parameters.output_path, f"perf_{step}.task_timers.csv"
+                    )
+                )
+                for step in range(1, len(perf_cfgs) + 1)
+            ]
+        )
+
         # Plot results
-        fig, p = plt.subplots(2, 1, figsize=(4, 8.0 / 10 * len(perf_cfgs)), sharey=True)
+        fig, p = plt.subplots(
+            3, 1, figsize=(4, 12.0 / 10 * len(perf_cfgs)), sharey=True
+        )
         labels = []
 
         for i, cfg in enumerate(perf_cfgs):
             p[0].plot(perfs[i] / 1e6, i, "o")
             p[1].plot(perfs[i] / perfs[0], i, "o")
+            p[2].plot(flux_perfs[i] / 1e6, i, "o")
             labels.append(
                 (
                     f'{cfg["integrator"].upper()} {cfg["recon"].upper()} '
                     f'Mesh ${cfg["mx"]}^3$ MB ${cfg["mb"]}^3$'
                     f'{" MHD" if cfg["fluid"] == "glmmhd" else ""}'
+                    f'{" fused" if cfg["flux_kernel"] == "fused" else ""}'
                 )
             )
+            summary = (
+                f"{labels[-1]}: {perfs[i]:.3e} zone-cycles/s, "
+                f"flux calculation {flux_perfs[i]:.3e} zone-cycles/s"
+            )
+            pencil = pencil_cfg_index(cfg) if cfg["flux_kernel"] == "fused" else None
+            if pencil is not None:
+                summary += (
+                    f" ({flux_perfs[i] / flux_perfs[pencil]:.2f}x the pencil flux "
+                    f"kernel, {perfs[i] / perfs[pencil]:.2f}x overall)"
+                )
+            print(summary)
 
         p[0].set_xlabel("Mzone-cycles/s")
         p[1].set_xlabel("zcs normalized to bottom row")
+        p[2].set_xlabel("flux calculation Mzone-cycles/s")
 
-        for i in range(2):
+        for i in range(3):
             p[i].grid()
             p[i].set_yticks(np.arange(len(perf_cfgs)))
             p[i].set_yticklabels(labels)
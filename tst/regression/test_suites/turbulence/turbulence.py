@@ -19,6 +19,33 @@ import utils.test_case
 """ To prevent littering up imported folders with .pyc files or __pycache_ folder"""
 sys.dont_write_bytecode = True
 
+# Short hydro runs with all blocks in a single pack and with one block per pack to
+# check that the driving is independent of the partitioning of the mesh
+pack_sizes = [-1, 1]
+
+# Short hydro runs driven with all modes in the band of the forcing spectrum
+# (driver=band_modes) and with the same modes explicitly listed (driver=few_modes)
+drivers = ["band_modes", "few_modes"]
+k_peak = 2.0
+# Default band of the band_modes driver
+k_low = 0.5 * k_peak
+k_high = 2.0 * k_peak
+
+
+def make_band_modes():
+    """All wave vectors (in the same order) used by the band_modes driver."""
+    k_max = int(np.floor(k_high))
+    modes = []
+    for kx, ky, kz in itertools.product(
+        range(0, k_max + 1), range(-k_max, k_max + 1), range(-k_max, k_max + 1)
+    ):
+        k_mag = np.sqrt(kx**2 + ky**2 + kz**2)
+        ampl = (k_mag / k_peak) ** 2 * (2.0 - (k_mag / k_peak) ** 2)
+        if ampl <= 0 or k_mag < k_low or k_mag > k_high:
+            continue
+        modes.append((kx, ky, kz))
+    return modes
+
 
 class TestCase(utils.test_case.TestCaseAbs):
     def Prepare(self, parameters, step):
@@ -26,6 +53,51 @@ class TestCase(utils.test_case.TestCaseAbs):
             "parthenon/output2/dt=-1",
             "parthenon/output3/dt=-1",
         ]
+        if step > 1 + len(pack_sizes):
+            driver = drivers[step - 2 - len(pack_sizes)]
+            parameters.driver_cmd_line_args = [
+                "parthenon/output1/dt=-1",
+                "parthenon/output3/dt=-1",
+                # Only initial and final output of the acceleration field
+                "parthenon/output2/dt=1.0",
+                f"parthenon/output2/id={driver}",
+                "parthenon/output2/variables=acc",
+                "parthenon/output2/single_precision_output=false",
+                "parthenon/time/tlim=0.1",
+                "parthenon/mesh/nx1=32",
+                "parthenon/mesh/nx2=32",
+                "parthenon/mesh/nx3=32",
+                "parthenon/meshblock/nx1=32",
+                "parthenon/meshblock/nx2=32",
+                "parthenon/meshblock/nx3=32",
+                "hydro/fluid=euler",
+                f"problem/turbulence/kpeak={k_peak}",
+                f"problem/turbulence/driver={driver}",
+            ]
+            if driver == "few_modes":
+                modes = make_band_modes()
+                parameters.driver_cmd_line_args.append(
+                    f"problem/turbulence/num_modes={len(modes)}"
+                )
+                for m, vec in enumerate(modes):
+                    for d in range(3):
+                        parameters.driver_cmd_line_args.append(
+                            f"modes/k_{m + 1}_{d}={vec[d]}"
+                        )
+        elif step > 1:
+            pack_size = pack_sizes[step - 2]
+            parameters.driver_cmd_line_args += [
+                f"parthenon/output1/id=pack_size_{pack_size}",
+                "parthenon/time/tlim=0.5",
+                "parthenon/mesh/nx1=32",
+                "parthenon/mesh/nx2=32",
+                "parthenon/mesh/nx3=32",
+                "parthenon/meshblock/nx1=16",
+                "parthenon/meshblock/nx2=16",
+                "parthenon/meshblock/nx3=16",
+                f"parthenon/mesh/pack_size={pack_size}",
+                "hydro/fluid=euler",
+            ]
 
         return parameters
 
@@ -51,4 +123,78 @@ class TestCase(utils.test_case.TestCaseAbs):
             print(f"ERROR: Mismatch in Ma={data[-1, -2]}")
             success = False
 
+        # Check that the history output is independent of the pack size (up to round-off
+        # from the different order of the partial sums)
+        data_pack = [
+            np.genfromtxt(
+                f"{parameters.output_path}/parthenon.pack_size_{pack_size}.hst"
+            )
+            for pack_size in pack_sizes
+        ]
+        if data_pack[0].shape != data_pack[1].shape or not np.allclose(
+            data_pack[0], data_pack[1], rtol=1e-10, atol=1e-14
+        ):
+            print(
+                f"ERROR: History output with pack_size={pack_sizes[1]} does not match "
+                f"the one with pack_size={pack_sizes[0]}."
+            )
+            success = False
+
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to load Parthenon hdf5 files.")
+            return False
+
+        # Acceleration field (component, k, j, i) of the single block at the final time
+        accs = {}
+        for driver in drivers:
+            data_file = phdf.phdf(
+                f"{parameters.output_path}/parthenon.{driver}.final.phdf"
+            )
+            names = [
+                name
+                for name in data_file.Info["ComponentNames"]
+                if name.startswith("acc")
+            ]
+            components = data_file.GetComponents(names, flatten=False)
+            accs[driver] = np.array([components[name][0] for name in names])
+
+        # Both drivers perform the same inverse transform of the same modes (with the
+        # same random phases), so the fields need to agree up to round-off.
+        if not np.allclose(
+            accs["band_modes"],
+            accs["few_modes"],
+            rtol=1e-10,
+            atol=1e-12 * np.max(np.abs(accs["few_modes"])),
+        ):
+            print(
+                "ERROR: Acceleration field of band_modes driving does not match the "
+                "one of few_modes driving with the same modes. Max abs difference: "
+                f"{np.max(np.abs(accs['band_modes'] - accs['few_modes']))}"
+            )
+            success = False
+
+        # All power (apart from the mean) needs to be within the band of the forcing
+        # spectrum and the field needs to be solenoidal (sol_weight = 1).
+        acc = accs["band_modes"]
+        n = acc.shape[-1]
+        acc_hat = np.array([np.fft.fftn(acc[d]) for d in range(3)])
+        kz, ky, kx = np.meshgrid(*(3 * [np.fft.fftfreq(n, d=1.0 / n)]), indexing="ij")
+        k_vec = np.array([kx, ky, kz])
+        k_mag = np.sqrt(np.sum(k_vec**2, axis=0))
+        power = np.sum(np.abs(acc_hat) ** 2, axis=0)
+        power[k_mag == 0] = 0.0
+        in_band = (k_mag >= k_low) & (k_mag < np.sqrt(2.0) * k_peak)
+        power_outside = np.sum(power[~in_band]) / np.sum(power)
+        if not power_outside < 1e-20:
+            print(f"ERROR: Fraction of power outside of the band is {power_outside}.")
+            success = False
+        k_hat = np.divide(k_vec, k_mag, out=np.zeros_like(k_vec), where=k_mag > 0)
+        div_power = np.abs(np.sum(k_hat * acc_hat, axis=0)) ** 2
+        div_frac = np.sum(div_power) / np.sum(power)
+        if not div_frac < 1e-20:
+            print(f"ERROR: Fraction of compressive power is {div_frac}.")
+            success = False
+
         return success
@@ -0,0 +1,144 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2024, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import itertools
+import numpy as np
+import matplotlib
+
+matplotlib.use("agg")
+import matplotlib.pylab as plt
+import sys
+import os
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Number of driving modes used in the explicit inverse FT. The last step uses all modes
+# in the band of the forcing spectrum (driver=band_modes).
+all_num_modes = [50, 100, 200, 500, 1000]
+
+# Peak of the forcing spectrum. All modes up to |k| = sqrt(2) * k_peak have power.
+k_peak = 6.0
+
+# Maximum ratio of the time spent in the driving between the largest and the smallest
+# number of modes. With the factorized inverse FT the work per cell scales with the
+# number of distinct k_x (8 vs 3 here) rather than with the number of modes (20x), so
+# the ratio is expected to be about 3 (or less given the fixed cost of the reductions).
+max_driving_time_ratio = 8.0
+
+
+def make_modes(num_modes):
+    """Deterministic set of the num_modes shortest wave vectors with k_x >= 0 and
+    power in the forcing spectrum."""
+    k_max = int(np.floor(np.sqrt(2.0) * k_peak))
+    all_vec = []
+    for kx, ky, kz in itertools.product(
+        range(0, k_max + 1), range(-k_max, k_max + 1), range(-k_max, k_max + 1)
+    ):
+        k_mag = np.sqrt(kx**2 + ky**2 + kz**2)
+        if k_mag == 0 or (k_mag / k_peak) ** 2 * (2.0 - (k_mag / k_peak) ** 2) < 0:
+            continue
+        all_vec.append((k_mag, kx, ky, kz))
+    all_vec.sort()
+    assert len(all_vec) >= num_modes
+    return [vec[1:] for vec in all_vec[:num_modes]]
+
+
+def driving_time(filename):
+    """Returns the (max over ranks) time spent in the driving measured by the task
+    timers, i.e., generating the field and the reductions (split_source_reductions)."""
+    time = 0.0
+    with open(filename) as f:
+        header = f.readline().strip().split(",")
+        for line in f:
+            row = dict(zip(header, line.strip().split(",")))
+            if row["task"].startswith("split_source_reductions/"):
+                time += float(row["max_s"])
+    return time
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        parameters.driver_cmd_line_args = [
+            "parthenon/output1/dt=-1",
+            "parthenon/output2/dt=-1",
+            "parthenon/output3/dt=-1",
+            "parthenon/time/nlim=10",
+            f"problem/turbulence/kpeak={k_peak}",
+            f"job/problem_id=turb_perf_{step}",
+            "hydro/task_timers=true",
+            "hydro/task_timers_fence=true",
+            "hydro/task_timers_dt=1e10",
+        ]
+        if step > len(all_num_modes):
+            parameters.driver_cmd_line_args.append(
+                "problem/turbulence/driver=band_modes"
+            )
+            return parameters
+
+        num_modes = all_num_modes[step - 1]
+        parameters.driver_cmd_line_args.append(
+            f"problem/turbulence/num_modes={num_modes}"
+        )
+        for m, vec in enumerate(make_modes(num_modes)):
+            for d in range(3):
+                parameters.driver_cmd_line_args.append(f"modes/k_{m + 1}_{d}={vec[d]}")
+
+        return parameters
+
+    def Analyse(self, parameters):
+
+        perfs = []
+        for output in parameters.stdouts:
+            for line in output.decode("utf-8").split("\n"):
+                if "zone-cycles/wallsecond" in line:
+                    perfs.append(float(line.split(" ")[2]))
+
+        perfs = np.array(perfs)
+        driving_times = np.array(
+            [
+                driving_time(
+                    os.path.join(
+                        parameters.output_path, f"turb_perf_{step}.task_timers.csv"
+                    )
+                )
+                for step in range(1, len(perfs) + 1)
+            ]
+        )
+
+        labels = [f"{num_modes:5d} modes" for num_modes in all_num_modes]
+        labels += ["band modes"] * (len(perfs) - len(all_num_modes))
+        for label, perf, t_drive in zip(labels, perfs, driving_times):
+            print(
+                f"{label}: {perf:.3e} zone-cycles/s "
+                f"({perf / perfs[0]:.2f} relative to {all_num_modes[0]} modes), "
+                f"{t_drive:.3e} s in driving "
+                f"({t_drive / driving_times[0]:.2f} relative)"
+            )
+
+        test_success = True
+        ratio = driving_times[len(all_num_modes) - 1] / driving_times[0]
+        if not np.isfinite(ratio) or ratio >= max_driving_time_ratio:
+            print(
+                f"Driving with {all_num_modes[-1]} modes takes {ratio:.2f} times as "
+                f"long as with {all_num_modes[0]} modes (max "
+                f"{max_driving_time_ratio})."
+            )
+            test_success = False
+
+        fig, p = plt.subplots(1, 1, figsize=(4, 3))
+        p.semilogx(all_num_modes, perfs[: len(all_num_modes)] / 1e6, "o-")
+        p.set_xlabel("Number of modes")
+        p.set_ylabel("Mzone-cycles/s")
+        p.grid()
+        fig.savefig(
+            os.path.join(parameters.output_path, "turbulence_performance.png"),
+            bbox_inches="tight",
+        )
+
+        return test_success